@@ -0,0 +1,176 @@
+import engine_main
+
+import engine
+import engine_audio
+from engine_resources import WaveSoundResource
+import array
+import struct
+import math
+import os
+
+# Encodes a test signal as an IMA-ADPCM .wav here, plays it looping
+# through a channel that does no resampling (22050Hz source, nearest
+# interpolation, all gains and volumes at 1.0), renders it, and checks
+# every sample against the reference decoder below. The last block is
+# cut short to check that the decoder finds the start again on loop.
+#
+# The reference decoder follows the same spec as the engine's, so the
+# same is then done with `fixture.wav`, encoded and decoded (into
+# `fixture.pcm`) by a separate implementation, see `make_fixture.py`
+STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+]
+INDEX_CHANGES = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+RATE = 22050
+BLOCK_ALIGN = 256
+SAMPLES_PER_BLOCK = (BLOCK_ALIGN - 4) * 2 + 1
+LAST_BLOCK_SIZE = 100
+CHANNEL_DELAY = 3   # Channels output the source three samples late
+
+# Reference decoder for one 4-bit sample (IMA Digital Audio Focus
+# and Technical Working Groups recommended practice)
+def decode_nibble(state, nibble):
+    step = STEPS[state[1]]
+    difference = step >> 3
+    if nibble & 4:
+        difference += step
+    if nibble & 2:
+        difference += step >> 1
+    if nibble & 1:
+        difference += step >> 2
+
+    if nibble & 8:
+        state[0] -= difference
+    else:
+        state[0] += difference
+    state[0] = max(-32768, min(32767, state[0]))
+    state[1] = max(0, min(88, state[1] + INDEX_CHANGES[nibble]))
+    return state[0]
+
+def decode(data):
+    samples = []
+    for block_start in range(0, len(data), BLOCK_ALIGN):
+        block = data[block_start:block_start + BLOCK_ALIGN]
+        state = [struct.unpack("<h", block[0:2])[0], block[2]]
+        samples.append(state[0])
+        for byte in block[4:]:
+            samples.append(decode_nibble(state, byte & 0x0f))
+            samples.append(decode_nibble(state, byte >> 4))
+    return samples
+
+# Picks the nibble closest to each sample, tracking the decoder state
+def encode_nibble(state, sample):
+    step = STEPS[state[1]]
+    difference = sample - state[0]
+    nibble = 0
+    if difference < 0:
+        nibble = 8
+        difference = -difference
+    if difference >= step:
+        nibble |= 4
+        difference -= step
+    if difference >= step >> 1:
+        nibble |= 2
+        difference -= step >> 1
+    if difference >= step >> 2:
+        nibble |= 1
+    decode_nibble(state, nibble)
+    return nibble
+
+def encode(samples, block_count):
+    data = bytearray()
+    state = [0, 0]
+    cursor = 0
+    for block in range(block_count + 1):
+        block_size = BLOCK_ALIGN if block < block_count else LAST_BLOCK_SIZE
+        state[0] = samples[cursor]
+        data += struct.pack("<hBB", state[0], state[1], 0)
+        cursor += 1
+        for i in range(block_size - 4):
+            low = encode_nibble(state, samples[cursor])
+            high = encode_nibble(state, samples[cursor + 1])
+            data.append(low | (high << 4))
+            cursor += 2
+    return data
+
+# A tone that gets louder, a sweep, and some noise and full scale jumps
+# to push the step index and clamping around
+block_count = 4
+sample_count = block_count * SAMPLES_PER_BLOCK + (LAST_BLOCK_SIZE - 4) * 2 + 1
+samples = []
+noise = 12345
+for i in range(sample_count):
+    noise = (noise * 1103515245 + 12345) & 0x7fffffff
+    sample = (i / sample_count) * 20000 * math.sin(2 * math.pi * 440 * i / RATE)
+    sample += 8000 * math.sin(2 * math.pi * (100 + i / 4) * i / RATE)
+    sample += (noise % 2001) - 1000
+    if (i // 300) % 7 == 3:
+        sample = 32767 if (i // 20) % 2 == 0 else -32768
+    samples.append(int(max(-32768, min(32767, sample))))
+
+data = encode(samples, block_count)
+expected = decode(data)
+
+with open("adpcm.wav", "wb") as file:
+    file.write(struct.pack("<4sI4s4sIHHIIHHHH", b"RIFF", 4 + 28 + 12 + 8 + len(data), b"WAVE", b"fmt ", 20, 0x11, 1, RATE, RATE * BLOCK_ALIGN // SAMPLES_PER_BLOCK, BLOCK_ALIGN, 4, 2, SAMPLES_PER_BLOCK))
+    file.write(struct.pack("<4sII", b"fact", 4, len(expected)))
+    file.write(struct.pack("<4sI", b"data", len(data)))
+    file.write(data)
+
+# Plays `path` looping twice and returns how many rendered
+# samples differ from `expected` along with its duration
+def check(path, expected):
+    engine_audio.disable_playback()
+
+    wave = WaveSoundResource(path)
+    channel = engine_audio.play(wave, 0, True)
+    channel.interpolation = engine_audio.interpolation_nearest
+    engine_audio.render("render.wav", (CHANNEL_DELAY + 2 * len(expected)) / RATE)
+    engine_audio.stop(0)
+
+    engine_audio.enable_playback()
+
+    with open("render.wav", "rb") as file:
+        file.seek(44)
+        output = array.array("h", file.read())
+    os.remove("render.wav")
+
+    mismatches = 0
+    for loop in range(2):
+        for i in range(len(expected)):
+            if output[CHANNEL_DELAY + loop * len(expected) + i] != expected[i]:
+                mismatches += 1
+
+    return mismatches, wave.duration
+
+master_volume = engine.setting_volume()
+engine.setting_volume(1.0, False)
+
+mismatches, duration = check("adpcm.wav", expected)
+os.remove("adpcm.wav")
+
+with open("fixture.pcm", "rb") as file:
+    fixture_expected = array.array("h", file.read())
+fixture_mismatches, fixture_duration = check("fixture.wav", fixture_expected)
+
+engine.setting_volume(master_volume, False)
+
+print("-[adpcm_test.py, samples: " + str(len(expected)) + ", duration: " + str(duration) + ", mismatches: " + str(mismatches) + ", fixture samples: " + str(len(fixture_expected)) + ", fixture mismatches: " + str(fixture_mismatches) + "]-")
+
+if round(duration * RATE) != len(expected):
+    raise Exception("IMA-ADPCM duration is " + str(duration) + " seconds, expected " + str(len(expected) / RATE))
+
+if mismatches != 0:
+    raise Exception("Decoded IMA-ADPCM differs from the reference decoder in " + str(mismatches) + " samples")
+
+if round(fixture_duration * RATE) != len(fixture_expected):
+    raise Exception("fixture.wav duration is " + str(fixture_duration) + " seconds, expected " + str(len(fixture_expected) / RATE))
+
+if fixture_mismatches != 0:
+    raise Exception("Decoded fixture.wav differs from fixture.pcm in " + str(fixture_mismatches) + " samples")
@@ -0,0 +1,60 @@
+# Makes `fixture.wav` and `fixture.pcm` for adpcm_test with CPython's
+# `audioop` IMA-ADPCM codec instead of anything in this repository, so that
+# the engine's decoder is checked against a separate implementation. Run
+# on a computer with Python 3.12 or older (`audioop` was removed in 3.13):
+#
+#   python3 make_fixture.py
+#
+# `fixture.pcm` is every sample of `fixture.wav` decoded by `audioop`
+# as 16-bit little-endian mono. `audioop` puts the first of each pair of
+# samples in the high nibble, .wav files put it in the low nibble
+import audioop
+import math
+import struct
+
+RATE = 22050
+BLOCK_ALIGN = 512
+SAMPLES_PER_BLOCK = (BLOCK_ALIGN - 4) * 2 + 1
+BLOCK_COUNT = 3
+LAST_BLOCK_SIZE = 200
+
+def swap_nibbles(data):
+    return bytes(((byte & 0x0f) << 4) | (byte >> 4) for byte in data)
+
+# A chord, a fast falling sweep and a square wave at full scale
+sample_count = BLOCK_COUNT * SAMPLES_PER_BLOCK + (LAST_BLOCK_SIZE - 4) * 2 + 1
+samples = []
+for i in range(sample_count):
+    t = i / RATE
+    sample = 9000 * math.sin(2 * math.pi * 262 * t) + 7000 * math.sin(2 * math.pi * 330 * t) + 5000 * math.sin(2 * math.pi * 392 * t)
+    sample += 6000 * math.sin(2 * math.pi * (4000 - 3000 * i / sample_count) * t)
+    if 1500 <= i < 1800:
+        sample = 32767 if (i // 7) % 2 == 0 else -32768
+    samples.append(int(max(-32768, min(32767, sample))))
+
+data = bytearray()
+pcm = bytearray()
+index = 0
+cursor = 0
+for block in range(BLOCK_COUNT + 1):
+    block_size = BLOCK_ALIGN if block < BLOCK_COUNT else LAST_BLOCK_SIZE
+    predictor = samples[cursor]
+    block_samples = samples[cursor + 1:cursor + 1 + (block_size - 4) * 2]
+    cursor += 1 + len(block_samples)
+
+    encoded, (_, next_index) = audioop.lin2adpcm(struct.pack("<" + str(len(block_samples)) + "h", *block_samples), 2, (predictor, index))
+    decoded, _ = audioop.adpcm2lin(encoded, 2, (predictor, index))
+
+    data += struct.pack("<hBB", predictor, index, 0)
+    data += swap_nibbles(encoded)
+    pcm += struct.pack("<h", predictor) + decoded
+    index = next_index
+
+with open("fixture.wav", "wb") as file:
+    file.write(struct.pack("<4sI4s4sIHHIIHHHH", b"RIFF", 4 + 28 + 12 + 8 + len(data), b"WAVE", b"fmt ", 20, 0x11, 1, RATE, RATE * BLOCK_ALIGN // SAMPLES_PER_BLOCK, BLOCK_ALIGN, 4, 2, SAMPLES_PER_BLOCK))
+    file.write(struct.pack("<4sII", b"fact", 4, len(pcm) // 2))
+    file.write(struct.pack("<4sI", b"data", len(data)))
+    file.write(data)
+
+with open("fixture.pcm", "wb") as file:
+    file.write(pcm)
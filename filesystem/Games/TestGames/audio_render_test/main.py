@@ -0,0 +1,77 @@
+import engine_main
+
+import engine
+import engine_audio
+from engine_resources import ToneSoundResource, WaveSoundResource
+import struct
+import os
+
+# Renders the same mix of a tone and a looping, resampled wave twice
+# and checks that the files match and that the first render matches
+# `golden.wav`. Any change to the mixer, resampler or oscillator that
+# changes the output has to come with a new `golden.wav` (copy the
+# `render_a.wav` of a build that is known to sound right over it)
+
+# 0.25 seconds of an 8-bit saw at 11025Hz (played back at 22050Hz)
+def write_source(path):
+    sample_rate = 11025
+    data = bytearray(sample_rate // 4)
+    for i in range(len(data)):
+        data[i] = (i * 4) % 256
+
+    with open(path, "wb") as file:
+        file.write(struct.pack("<4sI4s4sIHHIIHH4sI", b"RIFF", 36 + len(data), b"WAVE", b"fmt ", 16, 1, 1, sample_rate, sample_rate, 1, 8, b"data", len(data)))
+        file.write(data)
+
+def render(path):
+    engine_audio.disable_playback()
+
+    tone = ToneSoundResource()
+    tone.frequency = 440
+    wave = WaveSoundResource("source.wav")
+
+    tone_channel = engine_audio.play(tone, 0, True)
+    tone_channel.gain = 0.25
+    wave_channel = engine_audio.play(wave, 1, True)
+    wave_channel.gain = 0.5
+
+    engine_audio.render(path, 1.0)
+
+    engine_audio.stop(0)
+    engine_audio.stop(1)
+
+def read(path):
+    with open(path, "rb") as file:
+        return file.read()
+
+# The golden render was made at full master volume
+volume = engine.setting_volume()
+engine.setting_volume(1.0, False)
+
+write_source("source.wav")
+render("render_a.wav")
+render("render_b.wav")
+engine_audio.enable_playback()
+engine.setting_volume(volume, False)
+
+a = read("render_a.wav")
+b = read("render_b.wav")
+
+# 44 byte header plus one second of 16-bit samples
+if len(a) != 44 + 22050 * 2:
+    raise Exception("Rendered file is " + str(len(a)) + " bytes")
+
+if a != b:
+    raise Exception("Rendering the same audio twice gave different output")
+
+if "golden.wav" not in os.listdir():
+    raise Exception("golden.wav is missing")
+
+if read("golden.wav") != a:
+    raise Exception("Rendered audio does not match golden.wav")
+
+os.remove("render_a.wav")
+os.remove("render_b.wav")
+os.remove("source.wav")
+
+print("-[audio_render_test.py, deterministic: True, golden: matched]-")
@@ -0,0 +1,109 @@
+import engine_main
+
+import engine
+import engine_audio
+from engine_resources import WaveSoundResource
+import array
+import struct
+import math
+import gc
+import os
+
+# Plays a 440Hz sine stored at several sample rates through each
+# interpolation mode, renders it, and measures the RMS error against
+# the ideal sine. The channel outputs the source three source samples
+# late (see the wave sample functions) so that is accounted for
+FREQUENCY = 440
+AMPLITUDE = 16384
+ENGINE_RATE = 22050
+RENDER_SAMPLES = ENGINE_RATE // 4
+SKIP_SAMPLES = 16
+
+def write_source(path, rate):
+    samples = array.array("h", [0] * rate)
+    for i in range(rate):
+        samples[i] = int(AMPLITUDE * math.sin(2 * math.pi * FREQUENCY * i / rate))
+
+    with open(path, "wb") as file:
+        file.write(struct.pack("<4sI4s4sIHHIIHH4sI", b"RIFF", 36 + rate * 2, b"WAVE", b"fmt ", 16, 1, 1, rate, rate * 2, 2, 16, b"data", rate * 2))
+        file.write(samples)
+
+def render(rate, interpolation, playback_rate=1.0):
+    write_source("source.wav", rate)
+    wave = WaveSoundResource("source.wav")
+
+    channel = engine_audio.play(wave, 0, False)
+    channel.interpolation = interpolation
+    channel.playback_rate = playback_rate
+    engine_audio.render("render.wav", RENDER_SAMPLES / ENGINE_RATE)
+    engine_audio.stop(0)
+
+    with open("render.wav", "rb") as file:
+        file.seek(44)
+        output = array.array("h", file.read())
+
+    # Same rounding as the channel's Q16 step so the ideal sine
+    # doesn't drift away from the output over the render
+    step = int(rate / ENGINE_RATE * playback_rate * 65536 + 0.5)
+    return output, step
+
+# Relative RMS error after fitting the overall gain (the master
+# volume from the settings file scales the output)
+def relative_rms_error(output, step, rate):
+    expected = []
+    for n in range(SKIP_SAMPLES, len(output)):
+        position = n * step / 65536 - 3
+        expected.append(math.sin(2 * math.pi * FREQUENCY * position / rate))
+
+    dot = 0
+    energy = 0
+    for i in range(len(expected)):
+        dot += output[SKIP_SAMPLES + i] * expected[i]
+        energy += expected[i] * expected[i]
+    scale = dot / energy
+
+    if scale < AMPLITUDE * 0.01:
+        raise Exception("Rendered audio is silent, is the master volume 0?")
+
+    error = 0
+    for i in range(len(expected)):
+        difference = output[SKIP_SAMPLES + i] - scale * expected[i]
+        error += difference * difference
+
+    return math.sqrt(error / len(expected)) / scale
+
+engine_audio.disable_playback()
+
+# Most error allowed (as a fraction of the amplitude) for each mode
+limits = {
+    engine_audio.interpolation_linear: 0.015,
+    engine_audio.interpolation_cubic: 0.001,
+}
+
+for rate in (8000, 11025, 16000, 22050, 32000):
+    errors = []
+    for interpolation in (engine_audio.interpolation_nearest, engine_audio.interpolation_linear, engine_audio.interpolation_cubic):
+        output, step = render(rate, interpolation)
+        errors.append(relative_rms_error(output, step, rate))
+        gc.collect()
+
+    print("-[audio_resample_test.py, rate: " + str(rate) + ", RMS error nearest: " + str(errors[0]) + ", linear: " + str(errors[1]) + ", cubic: " + str(errors[2]) + "]-")
+
+    for interpolation in limits:
+        if errors[interpolation] > limits[interpolation]:
+            raise Exception("Resampling " + str(rate) + "Hz with interpolation " + str(interpolation) + " is off by " + str(errors[interpolation]))
+
+    if rate != ENGINE_RATE and errors[engine_audio.interpolation_linear] >= errors[engine_audio.interpolation_nearest]:
+        raise Exception("Linear interpolation is not better than nearest at " + str(rate) + "Hz")
+
+# Twice the playback rate plays the sine an octave up
+output, step = render(ENGINE_RATE, engine_audio.interpolation_linear, 2.0)
+error = relative_rms_error(output, step, ENGINE_RATE)
+print("-[audio_resample_test.py, playback_rate: 2.0, RMS error: " + str(error) + "]-")
+if error > limits[engine_audio.interpolation_linear]:
+    raise Exception("Playing at twice the rate is off by " + str(error))
+
+engine_audio.enable_playback()
+
+os.remove("source.wav")
+os.remove("render.wav")
@@ -0,0 +1,20 @@
+import engine_main
+
+import engine
+import engine_debug
+import time
+
+# The color blend used by the blend shader (text colors) looks up squares
+# and square roots in tables. Check it against the float blend it replaced
+# for every pair of channel values at every 1/256 step blend amount. The
+# shader rounds its amount to these steps when it is set, so they are the
+# only amounts drawing uses and they must match exactly. Other amounts are
+# rounded to a step first and can be 1 off per channel from the float blend
+start_ms = time.ticks_ms()
+mismatches = engine_debug.color_blend_mismatches()
+elapsed_ms = time.ticks_diff(time.ticks_ms(), start_ms)
+
+print("-[color_blend_test.py, mismatches: " + str(mismatches) + ", took: " + str(elapsed_ms) + "ms]-")
+
+if mismatches != 0:
+    raise Exception("Color blend tables do not match the float blend in " + str(mismatches) + " cases")
@@ -320,4 +320,780 @@ while ticks < ticks_end:
 
 print("-[vox_node_perf_test.py, avg. FPS: " + str(fps_total / ticks_end) + "]-")
 
+# Test #6
+import engine_main
+
+import engine
+import engine_debug
+import engine_physics
+from engine_nodes import PhysicsCircle2DNode, PhysicsRectangle2DNode, CameraNode
+from engine_math import Vector2
+import random
+import time
+
+engine.disable_fps_limit()
+engine_physics.set_gravity(0, 0)
+
+camera = CameraNode()
+
+# Physics node count is capped by the number of physics IDs (180)
+for body_count in (32, 128, 180):
+    bodies = []
+    for i in range(body_count):
+        position = Vector2(random.uniform(-128, 128), random.uniform(-128, 128))
+        velocity = Vector2(random.uniform(-0.5, 0.5), random.uniform(-0.5, 0.5))
+
+        if i % 2 == 0:
+            bodies.append(PhysicsCircle2DNode(position=position, velocity=velocity, radius=3))
+        else:
+            bodies.append(PhysicsRectangle2DNode(position=position, velocity=velocity, width=6, height=6))
+
+    ticks = 0
+    ticks_end = 60 * 5
+    fps_total = 0
+    pair_tests_total = 0
+    tick_us_total = 0
+    while ticks < ticks_end:
+        t0 = time.ticks_us()
+        engine.tick()
+        tick_us_total = tick_us_total + time.ticks_diff(time.ticks_us(), t0)
+        fps_total = fps_total + engine.get_running_fps()
+        pair_tests_total = pair_tests_total + engine_debug.physics_pair_tests()
+        ticks = ticks + 1
+
+    # All-pairs would need n*(n-1)/2 narrow-phase tests every step
+    print("-[physics_broadphase_" + str(body_count) + "_perf_test.py, avg. FPS: " + str(fps_total / ticks_end) + ", avg. tick us: " + str(tick_us_total / ticks_end) + ", avg. pair tests: " + str(pair_tests_total / ticks_end) + " (all-pairs: " + str(body_count * (body_count - 1) // 2) + ")]-")
+
+    for body in bodies:
+        body.mark_destroy()
+    bodies = None
+    engine.tick()
+
+engine_physics.set_gravity(0, -0.00981)
+
+
+# Test #7
+import engine_main
+
+import engine
+import engine_debug
+import engine_physics
+from engine_nodes import PhysicsCircle2DNode, PhysicsRectangle2DNode, CameraNode
+from engine_math import Vector2
+import gc
+
+engine.disable_fps_limit()
+
+camera = CameraNode()
+
+class Body(PhysicsCircle2DNode):
+    def __init__(self, position):
+        super().__init__(self, position=position, radius=3)
+
+    def on_collide(self, contact):
+        pass
+
+# Bodies all piled on a floor so that every step has many contacts
+floor = PhysicsRectangle2DNode(position=Vector2(0, 40), width=128, height=8, dynamic=False)
+bodies = []
+for i in range(48):
+    bodies.append(Body(Vector2(-60 + (i % 16) * 8, 30 - (i // 16) * 6)))
+
+# Let the bodies settle first
+for i in range(60):
+    engine.tick()
+
+ticks = 0
+ticks_end = 60 * 5
+fps_total = 0
+alloc_total = 0
+heap_contacts_max = 0
+while ticks < ticks_end:
+    gc.collect()
+    gc.disable()
+    alloc_start = gc.mem_alloc()
+    engine.tick()
+    alloc_total = alloc_total + (gc.mem_alloc() - alloc_start)
+    gc.enable()
+    heap_contacts_max = max(heap_contacts_max, engine_debug.physics_heap_contacts())
+    fps_total = fps_total + engine.get_running_fps()
+    ticks = ticks + 1
+
+print("-[physics_contacts_perf_test.py, avg. FPS: " + str(fps_total / ticks_end) + ", avg. heap bytes per tick: " + str(alloc_total / ticks_end) + ", max heap contacts per step: " + str(heap_contacts_max) + "]-")
+
+for body in bodies:
+    body.mark_destroy()
+floor.mark_destroy()
+bodies = None
+engine.tick()
+
+
+# Test #8
+import engine_main
+
+import engine
+from engine_nodes import CameraNode, MeshNode
+from engine_resources import TextureResource, MeshResource
+from engine_math import Vector2, Vector3
+from engine_draw import Color
+
+engine.disable_fps_limit()
+
+camera = CameraNode()
+camera.position.z = -40
+texture = TextureResource("32x32.bmp")
+
+# Grid of textured quads facing the camera. Every quad is added with both
+# windings so one of each pair is back-face culled and the other is drawn
+vertices = []
+uvs = []
+grid = 12
+size = 6
+for gx in range(grid):
+    for gy in range(grid):
+        x0 = gx * size - (grid * size) / 2
+        y0 = gy * size - (grid * size) / 2
+        x1 = x0 + size
+        y1 = y0 + size
+
+        for a, b, c, ua, ub, uc in ((Vector3(x0, y0, 0), Vector3(x1, y0, 0), Vector3(x1, y1, 0), Vector2(0, 0), Vector2(1, 0), Vector2(1, 1)),
+                                    (Vector3(x0, y0, 0), Vector3(x1, y1, 0), Vector3(x0, y1, 0), Vector2(0, 0), Vector2(1, 1), Vector2(0, 1))):
+            vertices.extend((a, b, c))
+            uvs.extend((ua, ub, uc))
+            vertices.extend((a, c, b))
+            uvs.extend((ua, uc, ub))
+
+mesh = MeshNode(mesh=MeshResource(vertices, [], uvs), texture=texture, color=Color(1, 1, 1))
+
+ticks = 0
+ticks_end = 60 * 5
+fps_total = 0
+while ticks < ticks_end:
+    mesh.rotation.y = ticks * 0.01
+    engine.tick()
+    fps_total = fps_total + engine.get_running_fps()
+    ticks = ticks + 1
+
+print("-[mesh_node_perf_test.py, avg. FPS: " + str(fps_total / ticks_end) + ", triangles: " + str(len(vertices) // 3) + "]-")
+
+mesh.mark_destroy()
+engine.tick()
+
+
+# Test #9
+import engine_main
+
+import engine
+import struct
+import time
+import os
+from engine_nodes import CameraNode, MeshNode
+from engine_resources import TextureResource, MeshResource
+from engine_math import Vector2, Vector3
+from engine_draw import Color
+
+engine.disable_fps_limit()
+
+camera = CameraNode()
+camera.position.z = -40
+texture = TextureResource("32x32.bmp")
+
+# Same grid as Test #8 but written as a packed indexed .tmsh (8.8 fixed-point
+# positions, 16-bit uvs) so that it can be drawn straight out of flash
+grid = 12
+size = 6
+positions = []
+for gx in range(grid + 1):
+    for gy in range(grid + 1):
+        positions.append((gx * size - (grid * size) / 2, gy * size - (grid * size) / 2, gx / grid, gy / grid))
+
+indices = []
+for gx in range(grid):
+    for gy in range(grid):
+        i00 = gx * (grid + 1) + gy
+        i10 = i00 + (grid + 1)
+        i01 = i00 + 1
+        i11 = i10 + 1
+        for a, b, c in ((i00, i10, i11), (i00, i11, i01)):
+            indices.extend((a, b, c, a, c, b))
+
+# flags: fixed-point positions | uvs | indices
+with open("perf_test.tmsh", "wb") as file:
+    file.write(b"TMSH" + struct.pack("<BBHII", 1, 0b1011, 0, len(positions), len(indices)))
+    for x, y, u, v in positions:
+        file.write(struct.pack("<hhhHH", int(x * 256), int(y * 256), 0, int(u * 65535), int(v * 65535)))
+    file.write(struct.pack("<" + str(len(indices)) + "H", *indices))
+
+t0 = time.ticks_ms()
+packed_resource = MeshResource("perf_test.tmsh")
+packed_load_ms = time.ticks_diff(time.ticks_ms(), t0)
+
+t0 = time.ticks_ms()
+list_vertices = []
+list_uvs = []
+for i in indices:
+    x, y, u, v = positions[i]
+    list_vertices.append(Vector3(x, y, 0))
+    list_uvs.append(Vector2(u, v))
+list_resource = MeshResource(list_vertices, [], list_uvs)
+list_load_ms = time.ticks_diff(time.ticks_ms(), t0)
+
+print("-[packed_mesh_perf_test.py, .tmsh load ms: " + str(packed_load_ms) + ", Vector3/Vector2 list build ms: " + str(list_load_ms) + "]-")
+
+list_resource = None
+list_vertices = None
+list_uvs = None
+
+mesh = MeshNode(mesh=packed_resource, texture=texture, color=Color(1, 1, 1))
+
+ticks = 0
+ticks_end = 60 * 5
+fps_total = 0
+t0 = time.ticks_ms()
+while ticks < ticks_end:
+    mesh.rotation.y = ticks * 0.01
+    engine.tick()
+    fps_total = fps_total + engine.get_running_fps()
+    ticks = ticks + 1
+elapsed_ms = time.ticks_diff(time.ticks_ms(), t0)
+
+triangles = len(indices) // 3
+print("-[packed_mesh_perf_test.py, avg. FPS: " + str(fps_total / ticks_end) + ", triangles: " + str(triangles) + ", triangles/s: " + str(triangles * ticks_end * 1000 // max(1, elapsed_ms)) + "]-")
+
+mesh.mark_destroy()
+engine.tick()
+
+# The mesh was copied into resource space, the file isn't needed
+os.remove("perf_test.tmsh")
+
+
+# Test #10
+import engine_main
+
+import engine
+import engine_draw
+from engine_nodes import CameraNode, Rectangle2DNode, Circle2DNode, Text2DNode
+from engine_math import Vector2
+from engine_resources import FontResource
+
+engine.disable_fps_limit()
+
+# Menu like scene: static items and a small cursor that moves between them
+camera = CameraNode()
+font9 = FontResource("9pt-roboto-font.bmp")
+
+items = []
+for i in range(4):
+    items.append(Rectangle2DNode(width=90, height=16, color=engine_draw.darkgrey, position=Vector2(0, -36 + i * 24)))
+    items.append(Text2DNode(text="Menu item " + str(i), font=font9, position=Vector2(0, -36 + i * 24)))
+
+cursor = Circle2DNode(radius=4, color=engine_draw.yellow, position=Vector2(-52, -36))
+
+def run(damage_tracking):
+    engine_draw.set_damage_tracking(damage_tracking)
+
+    ticks = 0
+    ticks_end = 60 * 5
+    fps_total = 0
+    while ticks < ticks_end:
+        # Only moves every 20 ticks, idle otherwise
+        cursor.position.y = -36 + ((ticks // 20) % 4) * 24
+        engine.tick()
+        fps_total = fps_total + engine.get_running_fps()
+        ticks = ticks + 1
+
+    return fps_total / ticks_end
+
+fps_full = run(False)
+fps_damage = run(True)
+engine_draw.set_damage_tracking(False)
+
+print("-[damage_tracking_perf_test.py, avg. FPS full frames: " + str(fps_full) + ", avg. FPS damage tracking: " + str(fps_damage) + "]-")
+
+for item in items:
+    item.mark_destroy()
+cursor.mark_destroy()
+engine.tick()
+
+# Test #11
+import engine_main
+
+import engine
+import engine_draw
+from engine_nodes import CameraNode, Rectangle2DNode, Circle2DNode
+from engine_math import Vector2
+import math
+
+engine.disable_fps_limit()
+
+# Enough drawing and enough Python per tick that running
+# them at the same time on two cores should show
+camera = CameraNode()
+
+rects = []
+for i in range(24):
+    rects.append(Rectangle2DNode(width=24, height=24, color=engine_draw.blue, opacity=0.5, position=Vector2(-48 + (i % 6) * 19, -48 + (i // 6) * 24)))
+
+circles = []
+for i in range(8):
+    circles.append(Circle2DNode(radius=10, color=engine_draw.red, position=Vector2(0, 0)))
+
+def run(pipeline):
+    if pipeline:
+        engine.enable_render_pipeline()
+    else:
+        engine.disable_render_pipeline()
+
+    ticks = 0
+    ticks_end = 60 * 5
+    fps_total = 0
+    while ticks < ticks_end:
+        # Stand in for game logic
+        for i in range(len(circles)):
+            angle = ticks * 0.05 + i * 0.785
+            circles[i].position.x = math.cos(angle) * 40
+            circles[i].position.y = math.sin(angle) * 40
+
+        for rect in rects:
+            rect.rotation = ticks * 0.02
+
+        engine.tick()
+        fps_total = fps_total + engine.get_running_fps()
+        ticks = ticks + 1
+
+    return fps_total / ticks_end
+
+fps_serial = run(False)
+fps_pipeline = run(True)
+engine.disable_render_pipeline()
+
+print("-[render_pipeline_perf_test.py, avg. FPS serial: " + str(fps_serial) + ", avg. FPS render pipeline: " + str(fps_pipeline) + "]-")
+
+for rect in rects:
+    rect.mark_destroy()
+for circle in circles:
+    circle.mark_destroy()
+engine.tick()
+
+
+# Test #12
+import engine_main
+
+import engine
+import engine_draw
+import engine_debug
+from engine_nodes import CameraNode, Rectangle2DNode, Circle2DNode
+from engine_math import Vector2
+
+engine.disable_fps_limit()
+
+# Side scrolling level much wider than the screen, most
+# of it is off-screen at any time and should be culled
+camera = CameraNode()
+
+blocks = []
+for i in range(96):
+    blocks.append(Rectangle2DNode(width=16, height=16, color=engine_draw.green, position=Vector2(i * 24, 40 - (i % 4) * 16)))
+
+coins = []
+for i in range(48):
+    coins.append(Circle2DNode(radius=4, color=engine_draw.yellow, position=Vector2(i * 48 + 12, 0)))
+
+ticks = 0
+ticks_end = 60 * 5
+fps_total = 0
+drawn_total = 0
+culled_total = 0
+while ticks < ticks_end:
+    camera.position.x = ticks * 6
+    engine.tick()
+    fps_total = fps_total + engine.get_running_fps()
+    drawn_total = drawn_total + engine_debug.drawn_nodes()
+    culled_total = culled_total + engine_debug.culled_nodes()
+    ticks = ticks + 1
+
+print("-[culling_perf_test.py, avg. FPS: " + str(fps_total / ticks_end) + ", avg. drawn: " + str(drawn_total / ticks_end) + ", avg. culled: " + str(culled_total / ticks_end) + "]-")
+
+for block in blocks:
+    block.mark_destroy()
+for coin in coins:
+    coin.mark_destroy()
+engine.tick()
+
+
+# Test #13
+import engine_main
+
+import engine
+from engine_nodes import CameraNode, EmptyNode
+import time
+import gc
+
+engine.disable_fps_limit()
+
+# Time spent walking nodes that have nothing to do,
+# should grow with the node count and not much else
+camera = CameraNode()
+
+class TickingNode(EmptyNode):
+    def __init__(self):
+        super().__init__(self)
+
+    def tick(self, dt):
+        pass
+
+def run(count, ticking_count):
+    nodes = []
+    for i in range(count):
+        nodes.append(EmptyNode(layer=i % 8))
+    for i in range(ticking_count):
+        nodes.append(TickingNode())
+
+    ticks = 0
+    ticks_end = 60
+    start_ms = time.ticks_ms()
+    while ticks < ticks_end:
+        engine.tick()
+        ticks = ticks + 1
+    elapsed_ms = time.ticks_diff(time.ticks_ms(), start_ms)
+
+    for node in nodes:
+        node.mark_destroy()
+    engine.tick()
+    nodes = None
+    gc.collect()
+
+    return elapsed_ms / ticks_end
+
+results = ""
+for count in [100, 1000, 5000]:
+    results = results + ", " + str(count) + " nodes: " + str(run(count, 10)) + "ms/tick"
+
+print("-[node_count_scaling_perf_test.py" + results + "]-")
+
+
+# Test #14
+import engine_main
+
+import engine
+import engine_debug
+from engine_nodes import CameraNode, EmptyNode, PhysicsCircle2DNode
+from engine_math import Vector2
+
+engine.disable_fps_limit()
+
+# Bullets spawned and destroyed every tick, each is a physics
+# node parented to a gun. After warming up the list node pool
+# should not grow anymore
+camera = CameraNode()
+gun = EmptyNode()
+
+bullets = []
+
+def spawn_and_despawn(ticks_end):
+    ticks = 0
+    while ticks < ticks_end:
+        for i in range(4):
+            bullet = PhysicsCircle2DNode(position=Vector2(0, 0), velocity=Vector2(2, i - 2), radius=2)
+            gun.add_child(bullet)
+            bullets.append(bullet)
+
+        while len(bullets) > 32:
+            bullets.pop(0).mark_destroy()
+
+        engine.tick()
+        ticks = ticks + 1
+
+spawn_and_despawn(30)
+in_use, high_water, slabs_warm = engine_debug.list_node_stats()
+
+spawn_and_despawn(60 * 5)
+in_use, high_water, slabs_end = engine_debug.list_node_stats()
+
+print("-[list_node_pool_perf_test.py, slabs after warm up: " + str(slabs_warm) + ", slabs after steady state: " + str(slabs_end) + ", high-water: " + str(high_water) + ", in use: " + str(in_use) + "]-")
+
+for bullet in bullets:
+    bullet.mark_destroy()
+bullets = []
+gun.mark_destroy()
+engine.tick()
+
+
+# Test #15
+import engine_main
+
+import engine
+import engine_draw
+from array import array
+import random
+import time
+
+# Starfield: 2000 pixels and 2000 small rects drawn one call
+# at a time versus one batch call each
+count = 2000
+frames = 30
+
+pixel_coordinates = array('h', [0] * (count * 2))
+rect_coordinates = array('h', [0] * (count * 4))
+colors = array('H', [0] * count)
+for i in range(count):
+    x = random.randint(0, 127)
+    y = random.randint(0, 127)
+    pixel_coordinates[i*2] = x
+    pixel_coordinates[i*2 + 1] = y
+    rect_coordinates[i*4] = x
+    rect_coordinates[i*4 + 1] = y
+    rect_coordinates[i*4 + 2] = 2
+    rect_coordinates[i*4 + 3] = 2
+    colors[i] = random.randint(0, 0xFFFF)
+
+def time_frames(draw):
+    start_ms = time.ticks_ms()
+    for frame in range(frames):
+        engine_draw.clear(engine_draw.black)
+        draw()
+        engine_draw.update()
+    return time.ticks_diff(time.ticks_ms(), start_ms) / frames
+
+def single_pixels():
+    for i in range(count):
+        engine_draw.pixel(colors[i], pixel_coordinates[i*2], pixel_coordinates[i*2 + 1], 1.0)
+
+def batch_pixels():
+    engine_draw.pixels(colors, pixel_coordinates, 1.0)
+
+def single_rects():
+    for i in range(count):
+        engine_draw.rect(colors[i], rect_coordinates[i*4], rect_coordinates[i*4 + 1], 2, 2, False, 1.0)
+
+def batch_rects():
+    engine_draw.rects(colors, rect_coordinates, False, 1.0)
+
+print("-[batch_draw_perf_test.py, ms/frame single pixels: " + str(time_frames(single_pixels)) + ", batch pixels: " + str(time_frames(batch_pixels)) + ", single rects: " + str(time_frames(single_rects)) + ", batch rects: " + str(time_frames(batch_rects)) + "]-")
+
+
+# Test #16
+import engine_main
+
+import engine
+import engine_draw
+from engine_nodes import CameraNode, Sprite2DNode, TileMap2DNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+import time
+import gc
+
+engine.disable_fps_limit()
+
+# Scrolling a 32x32 map of 8x8 tiles: one Sprite2DNode per
+# tile versus a TileMap2DNode without and with the chunk cache
+columns = 32
+rows = 32
+camera = CameraNode()
+
+# Four differently colored tiles side by side
+atlas = TextureResource(32, 8, engine_draw.black)
+for tile in range(4):
+    for y in range(8):
+        for x in range(8):
+            atlas.data[(y * 32 + tile * 8 + x) * 2] = 0x1F * (tile + 1)
+
+tiles = bytearray(columns * rows)
+for i in range(columns * rows):
+    tiles[i] = i % 5
+
+def run():
+    ticks = 0
+    ticks_end = 60
+    start_ms = time.ticks_ms()
+    while ticks < ticks_end:
+        camera.position.x = ticks * 2
+        camera.position.y = ticks
+        engine.tick()
+        ticks = ticks + 1
+    return time.ticks_diff(time.ticks_ms(), start_ms) / ticks_end
+
+def cleanup(nodes):
+    for node in nodes:
+        node.mark_destroy()
+    engine.tick()
+    gc.collect()
+
+sprites = []
+for i in range(columns * rows):
+    if tiles[i] == 0:
+        continue
+    sprite = Sprite2DNode(position=Vector2((i % columns) * 8 + 4, (i // columns) * 8 + 4), texture=atlas, frame_count_x=4, playing=False)
+    sprite.frame_current_x = tiles[i] - 1
+    sprites.append(sprite)
+sprite_ms = run()
+cleanup(sprites)
+sprites = None
+
+tile_map = TileMap2DNode(texture=atlas, tiles=tiles, columns=columns)
+tile_map_ms = run()
+tile_map.cache = True
+tile_map_cached_ms = run()
+cleanup([tile_map])
+
+print("-[tile_map_perf_test.py, ms/tick sprites: " + str(sprite_ms) + ", tile map: " + str(tile_map_ms) + ", cached tile map: " + str(tile_map_cached_ms) + "]-")
+
+
+# Test #17
+import engine_main
+
+import engine
+import engine_draw
+from engine_nodes import VoxelSpaceNode, CameraNode
+from engine_resources import TextureResource
+import math
+
+engine.disable_fps_limit()
+
+engine_draw.set_background_color(engine_draw.skyblue)
+
+# Same scene as Test #5 but drawn in `fast` mode
+C18W = TextureResource("C18W.bmp", True)
+D18 = TextureResource("D18.bmp", True)
+
+vox = VoxelSpaceNode(texture=C18W, heightmap=D18, fast=True)
+vox.position.x = 200
+vox.position.y = 0
+vox.scale.y = 10
+
+
+camera = CameraNode()
+camera.position.x = 175
+camera.position.y = 10
+camera.position.z = 75
+camera.view_distance = 350
+camera.fov = 70 * (math.pi/180)
+
+ticks = 0
+ticks_end = 60 * 5
+fps_total = 0
+while ticks < ticks_end:
+    engine.tick()
+    fps_total = fps_total + engine.get_running_fps()
+    ticks = ticks + 1
+
+
+print("-[vox_node_fast_perf_test.py, avg. FPS: " + str(fps_total / ticks_end) + "]-")
+
+
+
+# Test #18
+import engine_main
+
+import engine
+import engine_audio
+import engine_debug
+from engine_resources import ToneSoundResource
+
+# Cost of the audio interrupt per sample with 4 and then 8 channels
+# playing tones (one second of samples each)
+tones = []
+for i in range(8):
+    tone = ToneSoundResource()
+    tone.frequency = 220 + i * 110
+    tones.append(tone)
+
+results = []
+for count in (4, 8):
+    for i in range(count):
+        channel = engine_audio.play(tones[i], i, True)
+        channel.gain = 1 / 8
+    results.append(engine_debug.audio_mix_cycles(22050))
+
+for i in range(8):
+    engine_audio.stop(i)
+
+for cycles, us, active in results:
+    print("-[audio_mix_perf_test.py, channels: " + str(active) + ", cycles/sample: " + str(cycles) + ", us/sample: " + str(us) + "]-")
+
+
+# Test #19
+import engine_main
+
+import engine
+import engine_audio
+import engine_debug
+from engine_resources import WaveSoundResource
+import struct
+import os
+
+# Cost of the audio interrupt per sample for one channel playing a
+# 16-bit PCM .wav and then the same length of IMA-ADPCM (4-bit) .wav
+rate = 22050
+block_align = 256
+samples_per_block = (block_align - 4) * 2 + 1
+block_count = rate // samples_per_block + 1
+
+with open("pcm16.wav", "wb") as file:
+    data = bytearray(rate * 2)
+    for i in range(rate):
+        struct.pack_into("<h", data, i * 2, ((i * 97) % 4096 - 2048) * 8)
+    file.write(struct.pack("<4sI4s4sIHHIIHH4sI", b"RIFF", 36 + len(data), b"WAVE", b"fmt ", 16, 1, 1, rate, rate * 2, 2, 16, b"data", len(data)))
+    file.write(data)
+
+with open("adpcm.wav", "wb") as file:
+    data = bytearray(block_count * block_align)
+    for block in range(block_count):
+        for i in range(4, block_align):
+            data[block * block_align + i] = (block * 31 + i * 7) & 0xff
+        data[block * block_align + 2] = 40
+    file.write(struct.pack("<4sI4s4sIHHIIHHHH4sI", b"RIFF", 40 + len(data), b"WAVE", b"fmt ", 20, 0x11, 1, rate, rate * block_align // samples_per_block, block_align, 4, 2, samples_per_block, b"data", len(data)))
+    file.write(data)
+
+results = []
+for path in ("pcm16.wav", "adpcm.wav"):
+    wave = WaveSoundResource(path)
+    engine_audio.play(wave, 0, True)
+    results.append((path, engine_debug.audio_mix_cycles(22050)))
+    engine_audio.stop(0)
+
+os.remove("pcm16.wav")
+os.remove("adpcm.wav")
+
+for path, (cycles, us, active) in results:
+    print("-[adpcm_perf_test.py, file: " + path + ", cycles/sample: " + str(cycles) + ", us/sample: " + str(us) + "]-")
+
+
+# Test #20
+import engine_main
+
+import engine
+import engine_audio
+import engine_debug
+from engine_resources import ToneSoundResource
+
+# Cost of one tone sample from the wavetable oscillator against the
+# `sinf` oscillator it replaced, then the mixer cost per sample with
+# 8 channels of each tone waveform
+table_cycles, table_us, sinf_cycles, sinf_us = engine_debug.tone_sample_cycles(22050)
+print("-[tone_synth_perf_test.py, wavetable cycles/sample: " + str(table_cycles) + ", us/sample: " + str(table_us) + ", sinf cycles/sample: " + str(sinf_cycles) + ", us/sample: " + str(sinf_us) + "]-")
+
+tones = []
+for i in range(8):
+    tone = ToneSoundResource()
+    tone.frequency = 220 + i * 110
+    tone.attack = 0.5
+    tone.decay = 0.5
+    tone.sustain = 0.5
+    tones.append(tone)
+
+waveforms = (("sine", engine_audio.waveform_sine), ("square", engine_audio.waveform_square), ("triangle", engine_audio.waveform_triangle), ("saw", engine_audio.waveform_saw), ("noise", engine_audio.waveform_noise))
+
+for name, waveform in waveforms:
+    for i in range(8):
+        tones[i].waveform = waveform
+        channel = engine_audio.play(tones[i], i, True)
+        channel.gain = 1 / 8
+
+    cycles, us, active = engine_debug.audio_mix_cycles(22050)
+    print("-[tone_synth_perf_test.py, waveform: " + name + ", channels: " + str(active) + ", cycles/sample: " + str(cycles) + ", us/sample: " + str(us) + "]-")
+
+for i in range(8):
+    engine_audio.stop(i)
+
 engine.reset(True)
\ No newline at end of file
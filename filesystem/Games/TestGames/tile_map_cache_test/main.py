@@ -0,0 +1,52 @@
+import engine_main
+
+import engine
+import engine_draw
+from engine_nodes import CameraNode, TileMap2DNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+# A cached tile map has to draw the same frame as the uncached one. The
+# map has empty cells and uses the default `transparent_color`, so the
+# chunk cache has to pick its own key for the empty pixels. One tile is
+# all magenta, the first key the cache tries, so another key is needed
+engine.disable_fps_limit()
+engine_draw.set_background_color(engine_draw.skyblue)
+
+camera = CameraNode()
+
+# Tile 1 is white with a black border, tile 2 is magenta
+atlas = TextureResource(16, 8, engine_draw.black)
+for y in range(8):
+    for x in range(8):
+        border = x == 0 or y == 0 or x == 7 or y == 7
+        color = 0x0000 if border else 0xFFFF
+        atlas.data[(y * 16 + x) * 2] = color & 0xFF
+        atlas.data[(y * 16 + x) * 2 + 1] = color >> 8
+        atlas.data[(y * 16 + 8 + x) * 2] = 0xF81F & 0xFF
+        atlas.data[(y * 16 + 8 + x) * 2 + 1] = 0xF81F >> 8
+
+columns = 16
+tiles = bytearray(columns * 16)
+for i in range(len(tiles)):
+    tiles[i] = (i * 7 + i // columns) % 3
+
+tile_map = TileMap2DNode(position=Vector2(-64, -64), texture=atlas, tiles=tiles, columns=columns)
+
+def draw_frame():
+    engine.tick()
+    return bytes(engine_draw.front_fb_data())
+
+uncached = draw_frame()
+tile_map.cache = True
+cached = draw_frame()
+
+mismatches = 0
+for i in range(0, len(uncached), 2):
+    if uncached[i] != cached[i] or uncached[i+1] != cached[i+1]:
+        mismatches = mismatches + 1
+
+print("-[tile_map_cache_test.py, mismatched pixels: " + str(mismatches) + "]-")
+
+if mismatches != 0:
+    raise Exception("Cached tile map drew " + str(mismatches) + " pixels differently than the uncached tile map")
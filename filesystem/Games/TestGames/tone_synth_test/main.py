@@ -0,0 +1,161 @@
+import engine_main
+
+import engine
+import engine_audio
+from engine_resources import ToneSoundResource
+import array
+import math
+import os
+
+# Renders ToneSoundResource through each waveform and envelope stage
+# with all gains and volumes at 1.0 and checks the samples. Setting
+# the frequency fades out and back in over about 200 samples so that
+# part is skipped
+RATE = 22050
+FREQUENCY = 441     # Exactly 50 samples per period
+PERIOD = RATE // FREQUENCY
+SKIP_SAMPLES = 300
+
+channel = None
+
+def render(tone, seconds, loop=False):
+    global channel
+    channel = engine_audio.play(tone, 0, loop)
+    return render_more(seconds)
+
+def render_more(seconds):
+    engine_audio.render("render.wav", seconds)
+
+    with open("render.wav", "rb") as file:
+        file.seek(44)
+        return array.array("h", file.read())
+
+def steady_part(output):
+    periods = (len(output) - SKIP_SAMPLES) // PERIOD
+    return output[SKIP_SAMPLES:SKIP_SAMPLES + periods * PERIOD]
+
+master_volume = engine.setting_volume()
+engine.setting_volume(1.0, False)
+engine_audio.disable_playback()
+
+# Sine: fit the ideal sine's phase and measure what is left over
+tone = ToneSoundResource()
+tone.frequency = FREQUENCY
+samples = steady_part(render(tone, 0.25, True))
+
+a = 0
+b = 0
+for i in range(len(samples)):
+    angle = 2 * math.pi * FREQUENCY * (SKIP_SAMPLES + i) / RATE
+    a += samples[i] * math.sin(angle)
+    b += samples[i] * math.cos(angle)
+amplitude = 2 * math.sqrt(a * a + b * b) / len(samples)
+phase = math.atan2(b, a)
+
+error = 0
+for i in range(len(samples)):
+    angle = 2 * math.pi * FREQUENCY * (SKIP_SAMPLES + i) / RATE
+    difference = samples[i] - amplitude * math.sin(angle + phase)
+    error += difference * difference
+error = math.sqrt(error / len(samples)) / amplitude
+
+print("-[tone_synth_test.py, sine amplitude: " + str(amplitude) + ", RMS error: " + str(error) + "]-")
+if abs(amplitude - 32767) > 64 or error > 0.001:
+    raise Exception("Sine is off, amplitude " + str(amplitude) + " with RMS error " + str(error))
+
+# Square: always full scale, high for `duty` of each period
+tone.waveform = engine_audio.waveform_square
+tone.duty = 0.25
+samples = steady_part(render(tone, 0.25, True))
+
+high = 0
+for sample in samples:
+    if abs(sample) != 32767:
+        raise Exception("Square wave sample " + str(sample) + " is not full scale")
+    if sample > 0:
+        high += 1
+
+print("-[tone_synth_test.py, square duty: " + str(high / len(samples)) + "]-")
+if abs(high / len(samples) - 0.25) > 0.02:
+    raise Exception("Square wave is high " + str(high / len(samples)) + " of the time, expected 0.25")
+
+# Triangle and saw: a straight line from sample to sample except at the corners/jump
+for waveform, name, largest_step in ((engine_audio.waveform_triangle, "triangle", 2 * 65536 // PERIOD), (engine_audio.waveform_saw, "saw", 65536 // PERIOD)):
+    tone.waveform = waveform
+    samples = steady_part(render(tone, 0.25, True))
+
+    if max(samples) < 32000 or min(samples) > -32000:
+        raise Exception(name + " does not reach full scale")
+
+    jumps = 0
+    for i in range(1, len(samples)):
+        if abs(samples[i] - samples[i - 1]) > largest_step + 2:
+            jumps += 1
+
+    print("-[tone_synth_test.py, " + name + " jumps: " + str(jumps) + "]-")
+    if waveform == engine_audio.waveform_triangle and jumps != 0:
+        raise Exception("Triangle wave has " + str(jumps) + " jumps")
+    if waveform == engine_audio.waveform_saw and abs(jumps - len(samples) // PERIOD) > 1:
+        raise Exception("Saw wave jumps " + str(jumps) + " times, expected once per period")
+
+# Noise: holds a level for a period, levels are all over the place
+tone.waveform = engine_audio.waveform_noise
+samples = steady_part(render(tone, 0.25, True))
+levels = set(samples)
+print("-[tone_synth_test.py, noise levels: " + str(len(levels)) + "]-")
+if len(levels) < len(samples) // PERIOD // 2:
+    raise Exception("Noise only has " + str(len(levels)) + " different levels")
+
+engine_audio.stop(0)
+
+# Envelope: a square wave at 100% duty is the envelope level itself.
+# No frequency set so there is no fade. 10ms attack, 20ms decay to
+# nothing, and then the channel should stop by itself
+tone = ToneSoundResource()
+tone.waveform = engine_audio.waveform_square
+tone.duty = 1.0
+tone.attack = 0.01
+tone.decay = 0.02
+tone.sustain = 0.0
+samples = render(tone, 0.05)
+
+attack_end = int(0.01 * RATE)
+decay_middle = attack_end + int(0.01 * RATE)
+decay_end = attack_end + int(0.02 * RATE)
+
+print("-[tone_synth_test.py, attack middle: " + str(samples[attack_end // 2]) + ", peak: " + str(max(samples)) + ", decay middle: " + str(samples[decay_middle]) + ", done: " + str(channel.done) + "]-")
+if abs(samples[attack_end // 2] - 16384) > 600:
+    raise Exception("Attack is at " + str(samples[attack_end // 2]) + " half way through, expected about 16384")
+if max(samples) < 32000:
+    raise Exception("Attack never reaches full volume")
+if abs(samples[decay_middle] - 16384) > 600:
+    raise Exception("Decay is at " + str(samples[decay_middle]) + " half way through, expected about 16384")
+if max(samples[decay_end + 5:]) != 0:
+    raise Exception("Tone is not silent after decaying to a sustain of 0")
+if channel.done == False:
+    raise Exception("Channel did not stop after the tone decayed to a sustain of 0")
+
+# Sustain holds until note_off(), then 10ms of release
+tone.attack = 0.0
+tone.decay = 0.0
+tone.sustain = 0.5
+tone.release = 0.01
+samples = render(tone, 0.02)
+held = samples[len(samples) - 1]
+
+tone.note_off()
+samples = render_more(0.02)
+release_end = int(0.01 * RATE)
+
+print("-[tone_synth_test.py, sustain: " + str(held) + ", release middle: " + str(samples[release_end // 2]) + ", done: " + str(channel.done) + "]-")
+if abs(held - 16384) > 8:
+    raise Exception("Sustain level is " + str(held) + ", expected 16384")
+if abs(samples[release_end // 2] - 8192) > 600:
+    raise Exception("Release is at " + str(samples[release_end // 2]) + " half way through, expected about 8192")
+if max(samples[release_end + 5:]) != 0 or channel.done == False:
+    raise Exception("Channel did not stop after the release")
+
+engine_audio.enable_playback()
+engine.setting_volume(master_volume, False)
+
+os.remove("render.wav")
@@ -11,6 +11,15 @@
 #include "resources/engine_rtttl_sound_resource.h"
 
 
+void audio_channel_reset_adpcm(audio_channel_class_obj_t *channel){
+    channel->adpcm_predictor = 0;
+    channel->adpcm_step_index = 0;
+    channel->adpcm_high_nibble = 0xff;
+    channel->adpcm_block_bytes_left = 0;
+    channel->adpcm_read_offset = 0;
+}
+
+
 mp_obj_t audio_channel_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args){
     ENGINE_INFO_PRINTF("New AudioChannel");
     mp_arg_check_num(n_args, n_kw, 0, 0, false);
@@ -22,9 +31,17 @@ mp_obj_t audio_channel_class_new(const mp_obj_type_t *type, size_t n_args, size_
     self->base.type = &audio_channel_class_type;
 
     self->source = NULL;   // Set to NULL to indicate that source/channel not active
+    self->get_sample = NULL;
     self->source_byte_offset = 0;
     self->gain = 1.0f;
-    self->time = 0.0f;
+    self->gain_q15 = ENGINE_AUDIO_Q15_ONE;
+    self->amplitude = 0;
+    self->playback_rate = 1.0f;
+    self->interpolation = ENGINE_AUDIO_INTERPOLATION_LINEAR;
+    self->phase = 0;
+    self->phase_step = ENGINE_AUDIO_PHASE_ONE;
+    memset(self->history, 0, sizeof(self->history));
+    audio_channel_reset_adpcm(self);
     self->done = true;
     self->loop = false;
     self->buffers[0] = (uint8_t*)malloc(CHANNEL_BUFFER_SIZE);   // Use C heap. Easier to avoid gc and we have a consistent number of buffers anyways
@@ -44,16 +61,23 @@ mp_obj_t audio_channel_class_new(const mp_obj_type_t *type, size_t n_args, size_
 
     // https://github.com/raspberrypi/pico-examples/blob/eca13acf57916a0bd5961028314006983894fc84/dma/hello_dma/hello_dma.c#L21-L30
     // https://github.com/raspberrypi/pico-examples/blob/master/flash/xip_stream/flash_xip_stream.c#L58-L70 (see pg. 127 of rp2040 datasheet: https://datasheets.raspberrypi.com/rp2040/rp2040-datasheet.pdf)
-    // Get a free DMA channel and panic if there isn't one,
-    // get a default DMA config, and set the transfer size
-    // to 8-bits since smallest audio sample bit-depth is 8
-    // (using 16 would mean we'd copy too much data in 8-bit case)
+    // Get a free DMA channel (if there are none left, -1 is stored
+    // and the ISR copies wave data itself), get a default DMA config,
+    // and set the transfer size to 8-bits since smallest audio sample
+    // bit-depth is 8 (using 16 would mean we'd copy too much data in
+    // 8-bit case)
     #if defined(__EMSCRIPTEN__)
 
     #elif defined(__unix__)
 
     #elif defined(__arm__)
-        self->dma_channel = dma_claim_unused_channel(true);
+        self->dma_channel = dma_claim_unused_channel(false);
+
+        if(self->dma_channel < 0){
+            ENGINE_WARNING_PRINTF("AudioChannel: No DMA channels left, wave data will be copied in the audio interrupt for this channel");
+            return MP_OBJ_FROM_PTR(self);
+        }
+
         self->dma_config = dma_channel_get_default_config(self->dma_channel);
         channel_config_set_transfer_data_size(&self->dma_config, DMA_SIZE_8);
         channel_config_set_read_increment(&self->dma_config, true);
@@ -104,6 +128,7 @@ mp_obj_t audio_channel_stop(mp_obj_t self_in){
 
     // Set true, busy adjusting source, don't want the ISR doing
     // anything with this channel when in the middle of it
+    engine_audio_lock_channels();
     channel->busy = true;
 
     // Make sure that if this channel has a source, that
@@ -120,10 +145,16 @@ mp_obj_t audio_channel_stop(mp_obj_t self_in){
     }
 
     channel->source = NULL;
+    channel->get_sample = NULL;
     channel->source_byte_offset = 0;
     channel->gain = 1.0f;
-    channel->time = 0.0f;
-    channel->amplitude = 0.0f;
+    channel->gain_q15 = ENGINE_AUDIO_Q15_ONE;
+    channel->amplitude = 0;
+    channel->playback_rate = 1.0f;
+    channel->phase = 0;
+    channel->phase_step = ENGINE_AUDIO_PHASE_ONE;
+    memset(channel->history, 0, sizeof(channel->history));
+    audio_channel_reset_adpcm(channel);
     channel->done = true;
     channel->loop = false;
     channel->buffers_ends[0] = CHANNEL_BUFFER_SIZE;
@@ -135,6 +166,7 @@ mp_obj_t audio_channel_stop(mp_obj_t self_in){
 
     // Set back to false now that we're done readjusting the channel
     channel->busy = false;
+    engine_audio_unlock_channels();
 
     ENGINE_INFO_PRINTF("Done stopping!");
 
@@ -143,16 +175,31 @@ mp_obj_t audio_channel_stop(mp_obj_t self_in){
 MP_DEFINE_CONST_FUN_OBJ_1(audio_channel_stop_obj, audio_channel_stop);
 
 
+// Works out how far to step through the source for each engine
+// sample. Only wave sources have their own sample rate
+void audio_channel_update_phase_step(audio_channel_class_obj_t *channel){
+    float source_rate = ENGINE_AUDIO_SAMPLE_RATE;
+
+    if(channel->source != NULL && mp_obj_is_type(channel->source, &wave_sound_resource_class_type)){
+        source_rate = (float)((sound_resource_base_class_obj_t*)channel->source)->sample_rate;
+    }
+
+    channel->phase_step = (uint32_t)(source_rate / ENGINE_AUDIO_SAMPLE_RATE * channel->playback_rate * (float)ENGINE_AUDIO_PHASE_ONE + 0.5f);
+}
+
+
 /*  --- doc ---
     NAME: AudioChannel
     ID: AudioChannel
-    DESC: Object for controlling audio on one of the 4 available channels
+    DESC: Object for controlling audio on one of the available channels (8 unless the firmware was built with a different `CHANNEL_COUNT`, see `engine_audio.channel_count`)
     ATTR: [type=function]   [name={ref_link:audio_channel_play}]    [value=function]
     ATTR: [type=function]   [name={ref_link:audio_channel_stop}]    [value=function]
     ATTR: [type=object]     [name=source]                           [value={ref_link:WaveSoundResource} or {ref_link:ToneSoundResource}]
     ATTR: [type=float]      [name=gain]                             [value=0.0 to 1.0 (default is 1.0)]
     ATTR: [type=float]      [name=time]                             [value=0.0 to time at the end of the media being played (if there is an end) (read-only and is updated to represent the current time in seconds of teh media being played)]
     ATTR: [type=float]      [name=amplitude]                        [value=0.0 to 1.0 (the amplitude of the last sample played on this channel, read-only)]
+    ATTR: [type=float]      [name=playback_rate]                    [value=0.0 to 4.0 (default is 1.0). Speed that wave sources play at, 2.0 is twice as fast and an octave higher. Reset to 1.0 by play/stop]
+    ATTR: [type=enum/int]   [name=interpolation]                    [value=engine_audio.interpolation_nearest, engine_audio.interpolation_linear (default), or engine_audio.interpolation_cubic. How wave sources are resampled when their rate (times `playback_rate`) is not 22050Hz. Kept between plays, reset to linear when the engine resets]
     ATTR: [type=boolean]    [name=loop]                             [value=True or False (whether to loop audio or not)]
     ATTR: [type=boolean]    [name=done]                             [value=True or False (set True when audio finishes playing if not looping, read-only)]
 */ 
@@ -178,10 +225,30 @@ static void audio_channel_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t
                 destination[0] = mp_obj_new_float(self->gain);
             break;
             case MP_QSTR_time:
-                destination[0] = mp_obj_new_float(self->time);
+            {
+                // Only wave sources have a position to report. Worked out
+                // here instead of every sample in the ISR
+                float time = 0.0f;
+                if(self->source != NULL && mp_obj_is_type(self->source, &wave_sound_resource_class_type)){
+                    sound_resource_base_class_obj_t *source = self->source;
+
+                    if(source->format_type == WAVE_FORMAT_IMA_ADPCM){
+                        time = ((float)self->source_byte_offset / (float)source->block_align * (float)source->samples_per_block) / (float)source->sample_rate;
+                    }else{
+                        time = (float)(self->source_byte_offset / source->bytes_per_sample) / (float)source->sample_rate;
+                    }
+                }
+                destination[0] = mp_obj_new_float(time);
+            }
             break;
             case MP_QSTR_amplitude:
-                destination[0] = mp_obj_new_float(self->amplitude);
+                destination[0] = mp_obj_new_float((float)self->amplitude / (float)INT16_MAX);
+            break;
+            case MP_QSTR_playback_rate:
+                destination[0] = mp_obj_new_float(self->playback_rate);
+            break;
+            case MP_QSTR_interpolation:
+                destination[0] = mp_obj_new_int(self->interpolation);
             break;
             case MP_QSTR_loop:
                 destination[0] = mp_obj_new_bool(self->loop);
@@ -195,10 +262,17 @@ static void audio_channel_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t
     }else if(destination[1] != MP_OBJ_NULL){    // Store
         switch(attribute){
             case MP_QSTR_source:
+                engine_audio_lock_channels();
+                self->busy = true;
+                self->get_sample = engine_audio_get_sample_function(destination[1], self->interpolation);
                 self->source = destination[1];
+                audio_channel_update_phase_step(self);
+                self->busy = false;
+                engine_audio_unlock_channels();
             break;
             case MP_QSTR_gain:
                 self->gain = engine_math_clamp(mp_obj_get_float(destination[1]), 0.0f, 1.0f);
+                self->gain_q15 = (uint16_t)(self->gain * ENGINE_AUDIO_Q15_ONE);
             break;
             // case MP_QSTR_time:
             //     self->time = mp_obj_get_float(destination[1]);
@@ -206,6 +280,28 @@ static void audio_channel_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t
             case MP_QSTR_amplitude:
                 mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("AudioChannel: ERROR: Setting the sample amplitude is not allowed!"));
             break;
+            case MP_QSTR_playback_rate:
+                self->playback_rate = engine_math_clamp(mp_obj_get_float(destination[1]), 0.0f, 4.0f);
+                audio_channel_update_phase_step(self);
+            break;
+            case MP_QSTR_interpolation:
+            {
+                mp_int_t interpolation = mp_obj_get_int(destination[1]);
+
+                if(interpolation < ENGINE_AUDIO_INTERPOLATION_NEAREST || interpolation > ENGINE_AUDIO_INTERPOLATION_CUBIC){
+                    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("AudioChannel: ERROR: Unknown interpolation, use one of the `engine_audio.interpolation_*` values"));
+                }
+
+                engine_audio_lock_channels();
+                self->busy = true;
+                self->interpolation = interpolation;
+                if(self->source != NULL){
+                    self->get_sample = engine_audio_get_sample_function(self->source, self->interpolation);
+                }
+                self->busy = false;
+                engine_audio_unlock_channels();
+            }
+            break;
             case MP_QSTR_loop:
                 self->loop = mp_obj_get_int(destination[1]);
             break;
@@ -12,9 +12,14 @@
     #include "hardware/dma.h"
 #endif
 
-// The number of total audio channels that
-// can be active at a single time
-#define CHANNEL_COUNT 4
+// The number of total audio channels that can be active at a
+// single time. Can be set to something else at compile time (e.g.
+// 16) so games can layer more sound effects. Each channel claims a
+// DMA channel for streaming wave data out of flash while there are
+// some left, channels without one copy the data in the interrupt
+#ifndef CHANNEL_COUNT
+    #define CHANNEL_COUNT 8
+#endif
 
 
 // The total number of bytes dedicated to storing audio
@@ -32,13 +37,40 @@
 // and into RAM faster than that
 #define CHANNEL_BUFFER_SIZE 512
 
+// Samples are mixed as signed Q15 integers (-32768 ~ 32767 is -1.0 ~ 1.0)
+#define ENGINE_AUDIO_Q15_ONE 32768
+
+// Positions between two source samples are Q16 (0 ~ 65535)
+#define ENGINE_AUDIO_PHASE_ONE 65536
+
+// How wave sources are resampled to the engine's sample rate
+enum engine_audio_interpolation{
+    ENGINE_AUDIO_INTERPOLATION_NEAREST, // Repeat/skip samples (cheapest, sounds harsh when the rates differ)
+    ENGINE_AUDIO_INTERPOLATION_LINEAR,  // Straight line between the two nearest samples
+    ENGINE_AUDIO_INTERPOLATION_CUBIC,   // Catmull-Rom through the four nearest samples
+};
+
+struct audio_channel_class_obj_t;
+typedef int16_t (*audio_channel_get_sample_t)(struct audio_channel_class_obj_t *channel, bool *complete);
+
 typedef struct audio_channel_class_obj_t{
     mp_obj_base_t base;
     mp_obj_t source;                            // Source of the audio for the channel, currently
+    audio_channel_get_sample_t get_sample;      // Picked for the type of 'source' on play so the ISR doesn't check types. NULL when not playing
     uint32_t source_byte_offset;                // The total byte position inside the source that the ISR is using to start filling from
     float gain;                                 // Multiplier on each sample, 1.0 changes nothing
-    float time;                                 // Where in the 'channel_source' the audio is being played from
-    float amplitude;                            // Last amplitude on this channel to be played (before clamping or gain)
+    uint16_t gain_q15;                          // 'gain' as 0 ~ ENGINE_AUDIO_Q15_ONE for the mixer
+    int16_t amplitude;                          // Last Q15 amplitude on this channel to be played (before clamping or gain)
+    float playback_rate;                        // Multiplier on the speed (and pitch) wave sources are played at, 1.0 changes nothing
+    uint8_t interpolation;                      // One of `engine_audio_interpolation`, picks which 'get_sample' wave sources use
+    uint32_t phase;                             // Q16 position between 'history[1]' and 'history[2]' that the next wave sample is taken from
+    uint32_t phase_step;                        // Q16 number of source samples to move per engine sample (source rate / engine rate * 'playback_rate')
+    int16_t history[4];                         // Last four Q15 samples read from a wave source, oldest first
+    int16_t adpcm_predictor;                    // IMA-ADPCM decoder: last decoded sample
+    uint8_t adpcm_step_index;                   // IMA-ADPCM decoder: index into the step size table
+    uint8_t adpcm_high_nibble;                  // IMA-ADPCM decoder: second sample of the last byte read, 0xff once used
+    uint16_t adpcm_block_bytes_left;            // IMA-ADPCM decoder: bytes of samples left in the current block, 0 when the next byte starts a new block
+    uint32_t adpcm_read_offset;                 // IMA-ADPCM decoder: position in the source data of the next byte to decode (buffers are filled ahead of this)
     bool loop;                                  // Loop back to the start of the 'channel_source' at the end or set it to mp_const_none
     bool done;                                  // After starting a sound on this channel, this is set to true and then false when the end is reached (never set false in the case of 'looping' being true)
     uint8_t *buffers[2];                        // Dual buffers for audio, one gets DMA'ed to while the other is read from
@@ -62,5 +94,7 @@ extern const mp_obj_type_t audio_channel_class_type;
 
 mp_obj_t audio_channel_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 mp_obj_t audio_channel_stop(mp_obj_t self_in);
+void audio_channel_update_phase_step(audio_channel_class_obj_t *channel);
+void audio_channel_reset_adpcm(audio_channel_class_obj_t *channel);
 
 #endif  // ENGINE_AUDIO_CHANNEL_H
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "py/obj.h"
+#include "py/nlr.h"
 #include "py/mpthread.h"
 #include "engine_audio_module.h"
 #include "resources/engine_sound_resource_base.h"
@@ -15,7 +16,7 @@
 
 
 
-// 4 audio channels. Since audio is large it has to stay in
+// CHANNEL_COUNT audio channels. Since audio is large it has to stay in
 // flash, but flash is slow to get data from which is a problem
 // when sample retrieval time/latency needs to be small to keep
 // on track at the relatively high sample rate good audio requires.
@@ -29,9 +30,25 @@ volatile mp_obj_t channels[CHANNEL_COUNT];
 volatile float master_volume = 1.0f;    // Set by settings file, games cannot set this and affects all audio
 volatile float game_volume = 1.0f;      // Games are allowed to set this through `set_volume`
 
+// The two volumes above multiplied together as Q8 (256 is 1.0) for
+// the mixer. Capped so that every channel playing a full scale sample
+// still can't overflow the 32-bit mix before it is clamped
+#define ENGINE_AUDIO_MIX_VOLUME_MAX (INT32_MAX / (CHANNEL_COUNT * ENGINE_AUDIO_Q15_ONE))
+volatile int32_t mix_volume = 256;
+
+// False after `disable_playback()`: nothing pulls samples from the
+// channels unless `render(...)` is called
+bool playback_enabled = true;
+
+
+static void engine_audio_update_mix_volume(){
+    mix_volume = (int32_t)engine_math_clamp(game_volume * master_volume * 256.0f, 0.0f, (float)ENGINE_AUDIO_MIX_VOLUME_MAX);
+}
+
 
 void engine_audio_apply_master_volume(float volume){
     master_volume = volume;
+    engine_audio_update_mix_volume();
 }
 
 
@@ -44,7 +61,7 @@ float engine_audio_get_master_volume(){
     // Nothing to do
 #elif defined(__unix__)
     #include <SDL2/SDL.h>
-    SDL_AudioSpec audio;
+    SDL_AudioDeviceID audio_device = 0;     // Stays 0 if SDL could not open an audio device (e.g. running headless)
 #elif defined(__arm__)
     #include "pico/stdlib.h"
     #include "hardware/dma.h"
@@ -60,10 +77,13 @@ float engine_audio_get_master_volume(){
     #include "io/engine_io_rp3.h"
 
     pwm_config pwm_timer_config;
+#endif
 
-    uint8_t *current_source_data = NULL;
 
+uint8_t *current_source_data = NULL;
 
+
+#if defined(__arm__)
     void ENGINE_FAST_FUNCTION(engine_audio_handle_buffer)(audio_channel_class_obj_t *channel, bool *complete){
         // When 'buffer_byte_offset = 0' that means the buffer hasn't been filled before, fill it (see that after this function it is immediately incremented)
         // When 'buffer_byte_offset >= channel->buffer_end' that means the index has run out of data, fill it with more
@@ -92,7 +112,7 @@ float engine_audio_get_master_volume(){
             // xip_ctrl_hw->stream_ctr = channel->buffer_end;
 
             // Just in case we were too quick, wait while previous DMA might still be active
-            if(dma_channel_is_busy(channel->dma_channel)){
+            if(channel->dma_channel >= 0 && dma_channel_is_busy(channel->dma_channel)){
                 ENGINE_WARNING_PRINTF("AudioModule: Waiting on previous DMA transfer to complete, this ideally shouldn't happen");
                 dma_channel_wait_for_finish_blocking(channel->dma_channel);
             }
@@ -100,15 +120,21 @@ float engine_audio_get_master_volume(){
             channel->reading_buffer_index = 1 - channel->reading_buffer_index;
             channel->filling_buffer_index = 1 - channel->filling_buffer_index;
 
-            // https://github.com/raspberrypi/pico-examples/blob/master/flash/xip_stream/flash_xip_stream.c#L58-L70
-            dma_channel_configure(
-                channel->dma_channel,                                   // Channel to be configured
-                &channel->dma_config,                                   // The configuration we just created
-                channel->buffers[channel->filling_buffer_index],        // The initial write address
-                current_source_data,                                    // The initial read address
-                channel->buffers_ends[channel->filling_buffer_index],   // Number of transfers; in this case each is 1 byte
-                true                                                    // Start immediately
-            );
+            if(channel->dma_channel >= 0){
+                // https://github.com/raspberrypi/pico-examples/blob/master/flash/xip_stream/flash_xip_stream.c#L58-L70
+                dma_channel_configure(
+                    channel->dma_channel,                                   // Channel to be configured
+                    &channel->dma_config,                                   // The configuration we just created
+                    channel->buffers[channel->filling_buffer_index],        // The initial write address
+                    current_source_data,                                    // The initial read address
+                    channel->buffers_ends[channel->filling_buffer_index],   // Number of transfers; in this case each is 1 byte
+                    true                                                    // Start immediately
+                );
+            }else{
+                // Ran out of DMA channels when this audio channel
+                // was made (see `CHANNEL_COUNT`), copy it here instead
+                memcpy(channel->buffers[channel->filling_buffer_index], current_source_data, channel->buffers_ends[channel->filling_buffer_index]);
+            }
 
             // Filled amount will always be equal to or less than to
             // 0 the 'size' passed to 'fill_buffer'. In the case it was
@@ -139,7 +165,9 @@ float engine_audio_get_master_volume(){
             // 1 then load the other buffer while not blocking so that it
             // can be switched to next time for reading
             if(channel->reading_buffer_index == channel->filling_buffer_index){
-                dma_channel_wait_for_finish_blocking(channel->dma_channel);
+                if(channel->dma_channel >= 0){
+                    dma_channel_wait_for_finish_blocking(channel->dma_channel);
+                }
 
                 // Flip only the buffer to fill since we're going to fill it now
                 channel->filling_buffer_index = 1 - channel->filling_buffer_index;
@@ -149,114 +177,355 @@ float engine_audio_get_master_volume(){
             }
         }
     }
+#else
+    // No DMA, copy the next piece of the source straight
+    // into the buffer being read from once it runs out
+    void engine_audio_handle_buffer(audio_channel_class_obj_t *channel, bool *complete){
+        uint8_t buffer_index = channel->reading_buffer_index;
 
+        if(channel->buffers_byte_offsets[buffer_index] != 0 && channel->buffers_byte_offsets[buffer_index] < channel->buffers_ends[buffer_index]){
+            return;
+        }
+
+        channel->buffers_byte_offsets[buffer_index] = 0;
+
+        if(channel->source == NULL){
+            return;
+        }
 
-    float ENGINE_FAST_FUNCTION(get_wave_sample)(audio_channel_class_obj_t *channel, bool *complete){
         sound_resource_base_class_obj_t *source = channel->source;
 
-        // Keep returning current sample until time to get next one
-        if(source->play_counter != 0){
-            if(source->play_counter == source->play_counter_max){
-                source->play_counter = 0;
+        current_source_data = source->get_data(channel, CHANNEL_BUFFER_SIZE, &channel->buffers_ends[buffer_index]);
+        memcpy(channel->buffers[buffer_index], current_source_data, channel->buffers_ends[buffer_index]);
+
+        if(channel->buffers_ends[buffer_index] > 0){
+            channel->source_byte_offset += channel->buffers_ends[buffer_index];
+        }else{
+            channel->source_byte_offset = 0;
+
+            if(channel->loop == false){
+                *complete = true;
             }else{
-                source->play_counter++;
-                return source->last_sample;
+                engine_audio_handle_buffer(channel, complete);
             }
         }
+    }
+#endif
 
-        // Fill buffer with data whether first time or looping
-        engine_audio_handle_buffer(channel, complete);
 
-        uint8_t buffer_index = channel->reading_buffer_index;
-        uint16_t buffer_byte_offset = channel->buffers_byte_offsets[buffer_index];
-
-        // Add samples to total
-        switch(source->bytes_per_sample){
-            case 1:
-            {
-                uint8_t sample_byte = channel->buffers[buffer_index][buffer_byte_offset];       // Get sample as unsigned 8-bit value from 0 to 255
-                source->last_sample = (int8_t)(sample_byte - 128);                              // Center sample in preparation for scaling to -1.0 ~ 1.0. Subtract 128 so that 0 -> -128 and 255 -> 127
-                source->last_sample = source->last_sample / (float)INT8_MAX;                    // Scale from -128 ~ 127 to -1.0078 ~ 1.0 (will clamp later)
-            }
-            break;
-            case 2:
-            {
-                uint8_t sample_byte_lsb = channel->buffers[buffer_index][buffer_byte_offset];   // Get the right-most 8-bits as unsigned 8-bit (really is signed 16-bit byte, bits will still exist in same pattern)
-                uint8_t sample_byte_msb = channel->buffers[buffer_index][buffer_byte_offset+1]; // Get the left-most 8-bits as unsigned 8-bit (really is signed 16-bit byte, bits will still exist in same pattern)
-                source->last_sample = (int16_t)((sample_byte_msb << 8) + sample_byte_lsb);      // Combine bytes to make signed 16-bit value from -32768 ~ 32767
-                source->last_sample = source->last_sample / (float)INT16_MAX;                   // Scale from -32768 ~ 32767 to -1.000031 ~ 1.0 (will clamp later)
-            }
-            break;
-            default:
-                ENGINE_ERROR_PRINTF("AudioModule: Audio source with %d bytes per sample is not supported!", source->bytes_per_sample);
-        }
+// IMA-ADPCM step sizes and how the step index moves after each 4-bit sample
+// https://www.cs.columbia.edu/~hgs/audio/dvi/IMA_ADPCM.pdf
+static const int16_t engine_audio_adpcm_steps[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
 
-        // Set for the next sample
-        channel->buffers_byte_offsets[buffer_index] += source->bytes_per_sample;
+static const int8_t engine_audio_adpcm_index_changes[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
 
-        // Calculate the current time that we're at in the channel's source
-        channel->time = (1.0f / source->sample_rate) * (channel->source_byte_offset / source->bytes_per_sample);
 
-        source->play_counter++;
+// Reads the next byte of a wave source out of the channel's buffers
+static inline uint8_t engine_audio_read_wave_byte(audio_channel_class_obj_t *channel, bool *complete){
+    // Fill buffer with data whether first time or looping
+    engine_audio_handle_buffer(channel, complete);
+
+    uint8_t buffer_index = channel->reading_buffer_index;
+    uint8_t byte = channel->buffers[buffer_index][channel->buffers_byte_offsets[buffer_index]];
+    channel->buffers_byte_offsets[buffer_index] += 1;
+    return byte;
+}
+
 
-        return source->last_sample;
+// Same as above but keeps track of where the decoder is in the source
+// data so that it knows where the blocks start, even after looping
+static inline uint8_t engine_audio_read_adpcm_byte(audio_channel_class_obj_t *channel, sound_resource_base_class_obj_t *source, bool *complete){
+    channel->adpcm_read_offset++;
+    if(channel->adpcm_read_offset >= source->total_data_size){
+        channel->adpcm_read_offset = 0;
     }
 
+    return engine_audio_read_wave_byte(channel, complete);
+}
+
+
+static inline int16_t engine_audio_decode_adpcm_nibble(audio_channel_class_obj_t *channel, uint8_t nibble){
+    int32_t step = engine_audio_adpcm_steps[channel->adpcm_step_index];
+
+    // About ((nibble & 7) + 0.5) * step / 4, but rounded down
+    // piece by piece the same way as the reference decoder
+    int32_t difference = step >> 3;
+    if(nibble & 4) difference += step;
+    if(nibble & 2) difference += step >> 1;
+    if(nibble & 1) difference += step >> 2;
+
+    int32_t predictor = channel->adpcm_predictor;
+    predictor = (nibble & 8) ? predictor - difference : predictor + difference;
+    channel->adpcm_predictor = (int16_t)max(INT16_MIN, min(INT16_MAX, predictor));
+
+    int32_t step_index = channel->adpcm_step_index + engine_audio_adpcm_index_changes[nibble];
+    channel->adpcm_step_index = (uint8_t)max(0, min(88, step_index));
+
+    return channel->adpcm_predictor;
+}
 
-    float ENGINE_FAST_FUNCTION(get_tone_sample)(audio_channel_class_obj_t *channel){
-        return tone_sound_resource_get_sample(channel->source);
+
+// Decodes the next sample of an IMA-ADPCM source straight out of the
+// channel's buffers. Each block starts with a 4 byte header holding
+// the first sample and the step index, then every byte after that
+// has two 4-bit samples (low nibble first)
+static inline int16_t engine_audio_read_adpcm_sample(audio_channel_class_obj_t *channel, sound_resource_base_class_obj_t *source, bool *complete){
+    uint8_t nibble = 0;
+
+    if(channel->adpcm_high_nibble != 0xff){
+        nibble = channel->adpcm_high_nibble;
+        channel->adpcm_high_nibble = 0xff;
+    }else if(channel->adpcm_block_bytes_left == 0){
+        // The last block can be shorter than the others
+        uint32_t block_size = min(source->block_align, source->total_data_size - channel->adpcm_read_offset);
+
+        uint8_t predictor_lsb = engine_audio_read_adpcm_byte(channel, source, complete);
+        uint8_t predictor_msb = engine_audio_read_adpcm_byte(channel, source, complete);
+        uint8_t step_index = engine_audio_read_adpcm_byte(channel, source, complete);
+        engine_audio_read_adpcm_byte(channel, source, complete);   // Reserved
+
+        channel->adpcm_predictor = (int16_t)((predictor_msb << 8) | predictor_lsb);
+        channel->adpcm_step_index = min(step_index, 88);
+        channel->adpcm_block_bytes_left = block_size - 4;
+
+        return channel->adpcm_predictor;
+    }else{
+        uint8_t byte = engine_audio_read_adpcm_byte(channel, source, complete);
+        channel->adpcm_block_bytes_left--;
+
+        nibble = byte & 0x0f;
+        channel->adpcm_high_nibble = byte >> 4;
     }
 
+    return engine_audio_decode_adpcm_nibble(channel, nibble);
+}
+
 
-    float ENGINE_FAST_FUNCTION(get_rtttl_sample)(audio_channel_class_obj_t *channel, bool *complete){
-        return rtttl_sound_resource_get_sample(channel->source, complete);
+// Reads the next sample of a wave source out of the channel's buffers as Q15
+static inline int16_t engine_audio_read_wave_sample(audio_channel_class_obj_t *channel, sound_resource_base_class_obj_t *source, bool *complete){
+    if(source->format_type == WAVE_FORMAT_IMA_ADPCM){
+        return engine_audio_read_adpcm_sample(channel, source, complete);
     }
 
+    // Fill buffer with data whether first time or looping
+    engine_audio_handle_buffer(channel, complete);
 
-    // Samples each channel, adds, normalizes, and sets PWM
-    void repeating_audio_callback(){
-        float total_sample = 0;
-        bool play_sample = false;
+    uint8_t buffer_index = channel->reading_buffer_index;
+    uint16_t buffer_byte_offset = channel->buffers_byte_offsets[buffer_index];
+    int16_t sample = 0;
 
-        for(uint8_t icx=0; icx<CHANNEL_COUNT; icx++){
-            bool complete = false;
-            audio_channel_class_obj_t *channel = channels[icx];
+    // Convert to Q15
+    switch(source->bytes_per_sample){
+        case 1:
+        {
+            uint8_t sample_byte = channel->buffers[buffer_index][buffer_byte_offset];       // Get sample as unsigned 8-bit value from 0 to 255
+            sample = (int16_t)((sample_byte - 128) * 256);                                  // Center so that 0 -> -128 and 255 -> 127, then scale to -32768 ~ 32512
+        }
+        break;
+        case 2:
+        {
+            uint8_t sample_byte_lsb = channel->buffers[buffer_index][buffer_byte_offset];   // Get the right-most 8-bits as unsigned 8-bit (really is signed 16-bit byte, bits will still exist in same pattern)
+            uint8_t sample_byte_msb = channel->buffers[buffer_index][buffer_byte_offset+1]; // Get the left-most 8-bits as unsigned 8-bit (really is signed 16-bit byte, bits will still exist in same pattern)
+            sample = (int16_t)((sample_byte_msb << 8) | sample_byte_lsb);                   // Combine bytes to make signed 16-bit value from -32768 ~ 32767 (already Q15)
+        }
+        break;
+        default:
+            ENGINE_ERROR_PRINTF("AudioModule: Audio source with %d bytes per sample is not supported!", source->bytes_per_sample);
+    }
 
-            if(channel->source == NULL || channel->busy){
-                continue;
-            }
+    // Set for the next sample
+    channel->buffers_byte_offsets[buffer_index] += source->bytes_per_sample;
 
-            // Playing at least one sample, switch flag
-            play_sample = true;
-            float sample = 0.0f;
+    return sample;
+}
 
-            if(mp_obj_is_type(channel->source, &wave_sound_resource_class_type)){
-                sample = get_wave_sample(channel, &complete);
-            }else if(mp_obj_is_type(channel->source, &tone_sound_resource_class_type)){
-                sample = get_tone_sample(channel);
-            }else if(mp_obj_is_type(channel->source, &rtttl_sound_resource_class_type)){
-                sample = get_rtttl_sample(channel, &complete);
-            }
 
-            // Set the amplitude just retrieved as the last sample to have been played on the channel
-            channel->amplitude = sample;
+// Moves the channel forward by one engine sample in the wave
+// source, reading every source sample that is passed into the
+// history. Sources slower than the engine read one sample only
+// every few calls, faster sources read more than one
+static inline void engine_audio_advance_wave(audio_channel_class_obj_t *channel, bool *complete){
+    sound_resource_base_class_obj_t *source = channel->source;
 
-            total_sample += sample * channel->gain * game_volume * master_volume;
+    channel->phase += channel->phase_step;
 
-            if(complete && channel->loop == false){
-                audio_channel_stop(channel);
-            }
+    while(channel->phase >= ENGINE_AUDIO_PHASE_ONE){
+        channel->phase -= ENGINE_AUDIO_PHASE_ONE;
+
+        channel->history[0] = channel->history[1];
+        channel->history[1] = channel->history[2];
+        channel->history[2] = channel->history[3];
+        channel->history[3] = engine_audio_read_wave_sample(channel, source, complete);
+
+        // Reached the end and not looping, the channel gets stopped
+        if(*complete){
+            return;
         }
+    }
+}
 
-        if(play_sample){
-            // Up to the user to make sure all playing channels do not add up and
-            // go out of -1.0 ~ 1.0 range. Clamp the total sample sum since
-            // very likely it could end of out of bounds, and map to PWM levels
-            // NOTE: Set PWM wrap to 512 levels so it will use values from 0 to 511
-            total_sample = engine_math_map_clamp(total_sample, -1.0f, 1.0f, 0.0f, 511.0f);
 
-            // Actually set the wrap value to play this sample
-            pwm_set_gpio_level(AUDIO_PWM_PIN, (uint32_t)(total_sample));
+// The wave sample functions return the source at 'phase' between
+// 'history[1]' and 'history[2]' (so output lags the source by a
+// few samples) and then move forward for the next call
+
+int16_t ENGINE_FAST_FUNCTION(get_wave_sample_nearest)(audio_channel_class_obj_t *channel, bool *complete){
+    int16_t sample = channel->history[1];
+    engine_audio_advance_wave(channel, complete);
+    return sample;
+}
+
+
+int16_t ENGINE_FAST_FUNCTION(get_wave_sample_linear)(audio_channel_class_obj_t *channel, bool *complete){
+    int32_t a = channel->history[1];
+    int32_t b = channel->history[2];
+    int32_t t = channel->phase >> 1;    // Q15
+
+    // (b - a) fits in 17 bits and t in 15 so this can't overflow
+    int16_t sample = (int16_t)(a + (((b - a) * t) >> 15));
+
+    engine_audio_advance_wave(channel, complete);
+    return sample;
+}
+
+
+int16_t ENGINE_FAST_FUNCTION(get_wave_sample_cubic)(audio_channel_class_obj_t *channel, bool *complete){
+    int32_t h0 = channel->history[0];
+    int32_t h1 = channel->history[1];
+    int32_t h2 = channel->history[2];
+    int32_t h3 = channel->history[3];
+    int64_t t = channel->phase >> 1;    // Q15
+
+    // Catmull-Rom with every coefficient doubled to stay in integers:
+    // 2 * (y - h1) = t * (c1 + t * (c2 + t * c3))
+    // https://en.wikipedia.org/wiki/Cubic_Hermite_spline#Catmull%E2%80%93Rom_spline
+    int32_t c1 = h2 - h0;
+    int32_t c2 = 2*h0 - 5*h1 + 4*h2 - h3;
+    int32_t c3 = 3*(h1 - h2) + h3 - h0;
+
+    int64_t y = c3;
+    y = ((y * t) >> 15) + c2;
+    y = ((y * t) >> 15) + c1;
+    y = h1 + ((y * t) >> 16);
+
+    // Can overshoot between samples that are close to full scale
+    int16_t sample = (int16_t)max(INT16_MIN, min(INT16_MAX, y));
+
+    engine_audio_advance_wave(channel, complete);
+    return sample;
+}
+
+
+int16_t ENGINE_FAST_FUNCTION(get_tone_sample)(audio_channel_class_obj_t *channel, bool *complete){
+    tone_sound_resource_class_obj_t *tone = channel->source;
+    int16_t sample = tone_sound_resource_get_sample(tone);
+
+    // Only ends once released (or decayed to a sustain of 0)
+    *complete = (tone->envelope_stage == TONE_ENVELOPE_DONE);
+    return sample;
+}
+
+
+int16_t ENGINE_FAST_FUNCTION(get_rtttl_sample)(audio_channel_class_obj_t *channel, bool *complete){
+    return rtttl_sound_resource_get_sample(channel->source, complete);
+}
+
+
+audio_channel_get_sample_t engine_audio_get_sample_function(mp_obj_t sound_resource_obj, uint8_t interpolation){
+    if(mp_obj_is_type(sound_resource_obj, &wave_sound_resource_class_type)){
+        switch(interpolation){
+            case ENGINE_AUDIO_INTERPOLATION_NEAREST:
+                return &get_wave_sample_nearest;
+            case ENGINE_AUDIO_INTERPOLATION_CUBIC:
+                return &get_wave_sample_cubic;
+            default:
+                return &get_wave_sample_linear;
+        }
+    }else if(mp_obj_is_type(sound_resource_obj, &tone_sound_resource_class_type)){
+        return &get_tone_sample;
+    }else if(mp_obj_is_type(sound_resource_obj, &rtttl_sound_resource_class_type)){
+        return &get_rtttl_sample;
+    }
+
+    return NULL;
+}
+
+
+bool ENGINE_FAST_FUNCTION(engine_audio_mix_sample)(int16_t *output){
+    int32_t total_sample = 0;
+    bool play_sample = false;
+
+    for(uint8_t icx=0; icx<CHANNEL_COUNT; icx++){
+        bool complete = false;
+        audio_channel_class_obj_t *channel = channels[icx];
+
+        if(channel->get_sample == NULL || channel->busy){
+            continue;
+        }
+
+        // Playing at least one sample, switch flag
+        play_sample = true;
+
+        int16_t sample = channel->get_sample(channel, &complete);
+
+        // Set the amplitude just retrieved as the last sample to have been played on the channel
+        channel->amplitude = sample;
+
+        total_sample += (sample * channel->gain_q15) >> 15;
+
+        if(complete && channel->loop == false){
+            audio_channel_stop(channel);
+        }
+    }
+
+    if(play_sample == false){
+        return false;
+    }
+
+    // Up to the user to make sure all playing channels do not add up and
+    // go out of -1.0 ~ 1.0 range. Clamp the total sample sum since
+    // very likely it could end of out of bounds
+    total_sample = (total_sample * mix_volume) >> 8;
+    *output = (int16_t)max(INT16_MIN, min(INT16_MAX, total_sample));
+
+    return true;
+}
+
+
+#if defined(__EMSCRIPTEN__)
+    // Nothing to do
+#elif defined(__unix__)
+    // Stands in for the PWM interrupt. SDL calls this from
+    // its audio thread whenever the device needs more samples
+    static void engine_audio_sdl_callback(void *user_data, uint8_t *stream, int length){
+        int16_t *samples = (int16_t*)stream;
+        uint32_t sample_count = length / sizeof(int16_t);
+
+        for(uint32_t isx=0; isx<sample_count; isx++){
+            int16_t sample = 0;
+            engine_audio_mix_sample(&sample);
+            samples[isx] = sample;
+        }
+    }
+#elif defined(__arm__)
+    // Mixes a sample from the channels and sets PWM
+    void repeating_audio_callback(){
+        int16_t sample = 0;
+
+        if(engine_audio_mix_sample(&sample)){
+            // Map Q15 -32768 ~ 32767 to PWM levels
+            // NOTE: Set PWM wrap to 512 levels so it will use values from 0 to 511
+            pwm_set_gpio_level(AUDIO_PWM_PIN, (uint32_t)(sample + 32768) >> 7);
         }
 
         pwm_clear_irq(PWM_AUDIO_TIMER_SLICE_NUM);
@@ -264,6 +533,228 @@ float engine_audio_get_master_volume(){
 #endif
 
 
+// Stops the interrupt (or SDL audio thread) from pulling
+// samples so that the calling core can mix them instead
+static void engine_audio_output_pause(){
+    #if defined(__EMSCRIPTEN__)
+        // Nothing to do
+    #elif defined(__unix__)
+        if(audio_device != 0){
+            SDL_PauseAudioDevice(audio_device, 1);
+        }
+    #elif defined(__arm__)
+        pwm_set_irq_enabled(PWM_AUDIO_TIMER_SLICE_NUM, false);
+    #endif
+}
+
+
+// Undoes `engine_audio_output_pause()` unless playback is disabled
+static void engine_audio_output_resume(){
+    if(playback_enabled == false){
+        return;
+    }
+
+    #if defined(__EMSCRIPTEN__)
+        // Nothing to do
+    #elif defined(__unix__)
+        if(audio_device != 0){
+            SDL_PauseAudioDevice(audio_device, 0);
+        }
+    #elif defined(__arm__)
+        pwm_clear_irq(PWM_AUDIO_TIMER_SLICE_NUM);
+        pwm_set_irq_enabled(PWM_AUDIO_TIMER_SLICE_NUM, true);
+    #endif
+}
+
+
+void engine_audio_lock_channels(){
+    #if defined(__EMSCRIPTEN__)
+        // Nothing to do
+    #elif defined(__unix__)
+        // Waits for the SDL audio thread to finish the callback it may
+        // be in and keeps it out until unlocked. SDL holds this same
+        // (recursive) lock while calling the callback, so channels
+        // stopped from inside the mixer can take it again
+        if(audio_device != 0){
+            SDL_LockAudioDevice(audio_device);
+        }
+    #elif defined(__arm__)
+        // Nothing to do, the interrupt checks `busy`
+    #endif
+}
+
+
+void engine_audio_unlock_channels(){
+    #if defined(__EMSCRIPTEN__)
+        // Nothing to do
+    #elif defined(__unix__)
+        if(audio_device != 0){
+            SDL_UnlockAudioDevice(audio_device);
+        }
+    #elif defined(__arm__)
+        // Nothing to do
+    #endif
+}
+
+
+static void engine_audio_set_playback_enabled(bool enabled){
+    playback_enabled = enabled;
+
+    if(enabled){
+        engine_audio_output_resume();
+    }else{
+        engine_audio_output_pause();
+    }
+}
+
+
+void engine_audio_benchmark(void (*function)(void *data), void *data, uint32_t call_count, float *cycles_per_call, float *us_per_call){
+    uint64_t total_cycles = 0;
+    float total_us = 0.0f;
+
+    // Don't let the interrupt/audio thread mix at the same time
+    engine_audio_output_pause();
+
+    #if defined(__arm__)
+        // Count CPU clock cycles around each call with SysTick (24-bit
+        // down counter) and put back whatever it was set to after
+        uint32_t systick_csr = systick_hw->csr;
+        uint32_t systick_rvr = systick_hw->rvr;
+        systick_hw->rvr = 0x00FFFFFF;
+        systick_hw->cvr = 0;
+        systick_hw->csr = 0x5;  // Enabled, processor clock, no interrupt
+
+        uint64_t start_us = time_us_64();
+
+        for(uint32_t icx=0; icx<call_count; icx++){
+            uint32_t start_count = systick_hw->cvr;
+            function(data);
+            total_cycles += (start_count - systick_hw->cvr) & 0x00FFFFFF;
+        }
+
+        total_us = (float)(time_us_64() - start_us);
+
+        systick_hw->rvr = systick_rvr;
+        systick_hw->csr = systick_csr;
+    #else
+        uint32_t start_ms = millis();
+
+        for(uint32_t icx=0; icx<call_count; icx++){
+            function(data);
+        }
+
+        total_us = (float)millis_diff(millis(), start_ms) * 1000.0f;
+    #endif
+
+    engine_audio_output_resume();
+
+    *cycles_per_call = (float)total_cycles / (float)call_count;
+    *us_per_call = total_us / (float)call_count;
+}
+
+
+static void engine_audio_benchmark_mix_sample(void *data){
+    engine_audio_mix_sample((int16_t*)data);
+}
+
+
+void engine_audio_benchmark_mix(uint32_t sample_count, float *cycles_per_sample, float *us_per_sample, uint8_t *active_channel_count){
+    *active_channel_count = 0;
+
+    for(uint8_t icx=0; icx<CHANNEL_COUNT; icx++){
+        audio_channel_class_obj_t *channel = channels[icx];
+
+        if(channel->get_sample != NULL){
+            *active_channel_count += 1;
+        }
+    }
+
+    int16_t sample = 0;
+    engine_audio_benchmark(&engine_audio_benchmark_mix_sample, &sample, sample_count, cycles_per_sample, us_per_sample);
+}
+
+
+void engine_audio_render_to_wave(mp_obj_t filepath, uint32_t sample_count){
+    // Standard 44 byte header for 16-bit mono PCM: https://www.mmsp.ece.mcgill.ca/Documents/AudioFormats/WAVE/WAVE.html
+    uint32_t data_size = sample_count * sizeof(int16_t);
+    uint32_t sample_rate = (uint32_t)ENGINE_AUDIO_SAMPLE_RATE;
+    uint8_t header[44] = {
+        'R', 'I', 'F', 'F',
+        0, 0, 0, 0,                         // File size - 8, filled in below
+        'W', 'A', 'V', 'E',
+        'f', 'm', 't', ' ',
+        16, 0, 0, 0,                        // Format chunk size
+        1, 0,                               // PCM
+        1, 0,                               // Mono
+        0, 0, 0, 0,                         // Sample rate, filled in below
+        0, 0, 0, 0,                         // Byte rate, filled in below
+        2, 0,                               // Bytes per sample (block align)
+        16, 0,                              // Bits per sample
+        'd', 'a', 't', 'a',
+        0, 0, 0, 0,                         // Data size, filled in below
+    };
+
+    uint32_t riff_size = 36 + data_size;
+    uint32_t byte_rate = sample_rate * 2;
+
+    for(uint8_t ibx=0; ibx<4; ibx++){
+        header[4+ibx]  = (riff_size >> (ibx*8)) & 0xff;
+        header[24+ibx] = (sample_rate >> (ibx*8)) & 0xff;
+        header[28+ibx] = (byte_rate >> (ibx*8)) & 0xff;
+        header[40+ibx] = (data_size >> (ibx*8)) & 0xff;
+    }
+
+    engine_file_open_create_write(0, filepath);
+
+    // Mix in blocks on this core, without the interrupt/audio
+    // thread also pulling samples, so the output only depends
+    // on what was played and not on timing
+    engine_audio_output_pause();
+
+    // Don't leave the output paused or the file open if writing fails
+    nlr_buf_t nlr;
+    if(nlr_push(&nlr) == 0){
+        if(engine_file_write(0, header, sizeof(header)) != sizeof(header)){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineAudio: ERROR: Could not write the render, out of space?"));
+        }
+
+        uint8_t block[512];
+        uint32_t samples_left = sample_count;
+
+        while(samples_left > 0){
+            uint16_t block_sample_count = min(samples_left, sizeof(block) / sizeof(int16_t));
+
+            for(uint16_t isx=0; isx<block_sample_count; isx++){
+                int16_t sample = 0;
+                engine_audio_mix_sample(&sample);
+
+                // Always little-endian
+                block[isx*2]   = (uint16_t)sample & 0xff;
+                block[isx*2+1] = (uint16_t)sample >> 8;
+            }
+
+            if(engine_file_write(0, block, block_sample_count * sizeof(int16_t)) != block_sample_count * sizeof(int16_t)){
+                mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineAudio: ERROR: Could not write the render, out of space?"));
+            }
+
+            samples_left -= block_sample_count;
+        }
+
+        nlr_pop();
+    }else{
+        engine_audio_output_resume();
+        engine_file_close(0);
+        nlr_jump(nlr.ret_val);
+    }
+
+    engine_audio_output_resume();
+
+    engine_file_close(0);
+}
+
+
+
+
 void engine_audio_setup_playback(){
     #if defined(__EMSCRIPTEN__)
         // Nothing to do
@@ -318,8 +809,28 @@ void engine_audio_setup(){
     #if defined(__EMSCRIPTEN__)
         // Nothing to do
     #elif defined(__unix__)
-        audio.freq = 22050;
-        audio.format = AUDIO_U16;
+        // Play in real-time through SDL, mixing on its audio thread.
+        // Audio is optional here (e.g. CI without a sound card, or use
+        // SDL_AUDIODRIVER=dummy), `render(...)` works either way
+        SDL_AudioSpec desired;
+        SDL_zero(desired);
+        desired.freq = (int)ENGINE_AUDIO_SAMPLE_RATE;
+        desired.format = AUDIO_S16SYS;
+        desired.channels = 1;
+        desired.samples = 512;
+        desired.callback = engine_audio_sdl_callback;
+
+        if(SDL_InitSubSystem(SDL_INIT_AUDIO) < 0){
+            ENGINE_WARNING_PRINTF("EngineAudio: Could not initialize SDL audio, only `render(...)` will produce audio: %s", SDL_GetError());
+        }else{
+            audio_device = SDL_OpenAudioDevice(NULL, 0, &desired, NULL, 0);
+
+            if(audio_device == 0){
+                ENGINE_WARNING_PRINTF("EngineAudio: Could not open an SDL audio device, only `render(...)` will produce audio: %s", SDL_GetError());
+            }else if(playback_enabled){
+                SDL_PauseAudioDevice(audio_device, 0);
+            }
+        }
     #elif defined(__arm__)
         // Start the main ENGINE_AUDIO_SAMPLE_RATE (22050Hz) audio sample rate playback interrupt
         //
@@ -345,18 +856,39 @@ void engine_audio_reset(){
     // By default, set the game volume back to max
     // (the master volume can still scale this lower)
     game_volume = 1.0f;
+    engine_audio_update_mix_volume();
+
+    // Games that disabled playback (to render) get it back
+    if(playback_enabled == false){
+        engine_audio_set_playback_enabled(true);
+    }
 
     for(uint8_t icx=0; icx<CHANNEL_COUNT; icx++){
         // Check that each channel is not NULL since reset
         // can be called before hardware init
         if(channels[icx] != NULL){
             audio_channel_stop(channels[icx]);
+            ((audio_channel_class_obj_t*)channels[icx])->interpolation = ENGINE_AUDIO_INTERPOLATION_LINEAR;
         }
     }
 }
 
 
 void engine_audio_play_on_channel(mp_obj_t sound_resource_obj, audio_channel_class_obj_t *channel, mp_obj_t loop_obj){
+    // Figure out how to get samples from this source now
+    // instead of checking its type for every sample
+    audio_channel_get_sample_t get_sample = engine_audio_get_sample_function(sound_resource_obj, channel->interpolation);
+
+    if(get_sample == NULL){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("AudioModule: ERROR: Can only play WaveSoundResource, ToneSoundResource, or RTTTLSoundResource sources"));
+    }
+
+    // Can raise, get it before the channel is locked
+    bool loop = mp_obj_get_int(loop_obj);
+
+    // Keep the mixer off this channel until it is set up
+    engine_audio_lock_channels();
+
     // Before anything, make sure to stop the channel
     // incase of two `.play(...)` calls in a row
     audio_channel_stop(channel);
@@ -379,6 +911,10 @@ void engine_audio_play_on_channel(mp_obj_t sound_resource_obj, audio_channel_cla
         // is playing it (if one is) so that it can remove itself from the linked channel's
         // source
         source->channel = channel;
+
+        // Every play starts at the beginning of a period and of the envelope
+        source->phase = 0;
+        tone_sound_resource_note_on(source);
     }else if(mp_obj_is_type(sound_resource_obj, &rtttl_sound_resource_class_type)){
         rtttl_sound_resource_class_obj_t *source = sound_resource_obj;
 
@@ -389,11 +925,14 @@ void engine_audio_play_on_channel(mp_obj_t sound_resource_obj, audio_channel_cla
     }
 
     channel->source = sound_resource_obj;
-    channel->loop = mp_obj_get_int(loop_obj);
+    channel->get_sample = get_sample;
+    audio_channel_update_phase_step(channel);
+    channel->loop = loop;
     channel->done = false;
 
     // Now let the interrupt use it
     channel->busy = false;
+    engine_audio_unlock_channels();
 }
 
 
@@ -401,13 +940,13 @@ void engine_audio_play_on_channel(mp_obj_t sound_resource_obj, audio_channel_cla
     NAME: stop
     ID: audio_stop
     DESC: Stops playing audio on channel at index
-    PARAM: [type=int]       [name=channel_index]  [value=0 ~ 3]
+    PARAM: [type=int]       [name=channel_index]  [value=0 ~ channel_count-1]
     RETURN: None
 */
 static mp_obj_t engine_audio_stop(mp_obj_t channel_index_obj){
-    uint8_t channel_index = mp_obj_get_int(channel_index_obj);
+    mp_int_t channel_index = mp_obj_get_int(channel_index_obj);
 
-    if(channel_index > 3){
+    if(channel_index < 0 || channel_index >= CHANNEL_COUNT){
         mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("AudioModule: ERROR: Tried to stop audio channel using an index that does not exist"));
     }
 
@@ -423,14 +962,19 @@ MP_DEFINE_CONST_FUN_OBJ_1(engine_audio_stop_obj, engine_audio_stop);
     ID: audio_play
     DESC: Starts playing an audio source on a given channel and looping or not. It is up to the user to change the gains of the returned channels so that the audio does not clip.
     PARAM: [type=object]    [name=sound_resource] [value={ref_link:WaveSoundResource} or {ref_link:ToneSoundResource}]
-    PARAM: [type=int]       [name=channel_index]  [value=0 ~ 3]
+    PARAM: [type=int]       [name=channel_index]  [value=0 ~ channel_count-1]
     PARAM: [type=boolean]   [name=loop]           [value=True or False]
     RETURN: {ref_link:AudioChannel}
 */
 static mp_obj_t engine_audio_play(mp_obj_t sound_resource_obj, mp_obj_t channel_index_obj, mp_obj_t loop_obj){
     // Should probably make sure this doesn't
     // interfere with DMA or interrupt: TODO
-    uint8_t channel_index = mp_obj_get_int(channel_index_obj);
+    mp_int_t channel_index = mp_obj_get_int(channel_index_obj);
+
+    if(channel_index < 0 || channel_index >= CHANNEL_COUNT){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("AudioModule: ERROR: Tried to play on an audio channel using an index that does not exist"));
+    }
+
     audio_channel_class_obj_t *channel = channels[channel_index];
 
     engine_audio_play_on_channel(sound_resource_obj, channel, loop_obj);
@@ -452,6 +996,7 @@ static mp_obj_t engine_audio_set_volume(mp_obj_t new_volume){
     // which adds more area under the curve and therefore
     // is louder (sounds worse though)
     game_volume = mp_obj_get_float(new_volume);
+    engine_audio_update_mix_volume();
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(engine_audio_set_volume_obj, engine_audio_set_volume);
@@ -469,6 +1014,53 @@ static mp_obj_t engine_audio_get_volume(){
 MP_DEFINE_CONST_FUN_OBJ_0(engine_audio_get_volume_obj, engine_audio_get_volume);
 
 
+/*  --- doc ---
+    NAME: enable_playback
+    ID: enable_playback
+    DESC: Starts playing audio in real-time again after `disable_playback()` (through the speaker, or SDL on unix). Enabled by default and after every engine reset
+    RETURN: None
+*/
+static mp_obj_t engine_audio_enable_playback(){
+    engine_audio_set_playback_enabled(true);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_audio_enable_playback_obj, engine_audio_enable_playback);
+
+
+/*  --- doc ---
+    NAME: disable_playback
+    ID: disable_playback
+    DESC: Stops playing audio in real-time. Channels keep their sources but do not advance until playback is enabled again or samples are pulled by {ref_link:audio_render}. Use before starting sources that are going to be rendered so that the output only depends on the script
+    RETURN: None
+*/
+static mp_obj_t engine_audio_disable_playback(){
+    engine_audio_set_playback_enabled(false);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_audio_disable_playback_obj, engine_audio_disable_playback);
+
+
+/*  --- doc ---
+    NAME: render
+    ID: audio_render
+    DESC: Mixes the next `seconds` of audio from the channels as fast as possible and writes it to a 16-bit mono 22050Hz `.wav` file instead of playing it. The same mixer as real-time playback is used, so the file shows exactly what would have been heard. Given the same script, the output is the same every time (with playback disabled) which makes it usable for comparing against known good files in tests
+    PARAM: [type=string]    [name=filepath]       [value=string]
+    PARAM: [type=float]     [name=seconds]        [value=any positive number]
+    RETURN: None
+*/
+static mp_obj_t engine_audio_render(mp_obj_t filepath_obj, mp_obj_t seconds_obj){
+    float seconds = mp_obj_get_float(seconds_obj);
+
+    if(seconds <= 0.0f){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("AudioModule: ERROR: Can only render a positive number of seconds"));
+    }
+
+    engine_audio_render_to_wave(filepath_obj, (uint32_t)(seconds * ENGINE_AUDIO_SAMPLE_RATE + 0.5f));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(engine_audio_render_obj, engine_audio_render);
+
+
 static mp_obj_t engine_audio_module_init(){
     engine_main_raise_if_not_initialized();
     return mp_const_none;
@@ -479,12 +1071,24 @@ MP_DEFINE_CONST_FUN_OBJ_0(engine_audio_module_init_obj, engine_audio_module_init
 /*  --- doc ---
     NAME: engine_audio
     ID: engine_audio
-    DESC: Module for controlling/playing audio through four channels.
+    DESC: Module for controlling/playing audio through `channel_count` channels (8 unless the firmware was built with a different `CHANNEL_COUNT`).
     ATTR: [type=object]     [name={ref_link:AudioChannel}]  [value=function]
     ATTR: [type=function]   [name={ref_link:audio_play}]    [value=function]
     ATTR: [type=function]   [name={ref_link:audio_stop}]    [value=function]
     ATTR: [type=function]   [name={ref_link:set_volume}]    [value=function]
     ATTR: [type=function]   [name={ref_link:get_volume}]    [value=function]
+    ATTR: [type=function]   [name={ref_link:enable_playback}]   [value=function]
+    ATTR: [type=function]   [name={ref_link:disable_playback}]  [value=function]
+    ATTR: [type=function]   [name={ref_link:audio_render}]  [value=function]
+    ATTR: [type=int]        [name=channel_count]            [value=number of channels that can play at once]
+    ATTR: [type=enum/int]   [name=interpolation_nearest]    [value=0]
+    ATTR: [type=enum/int]   [name=interpolation_linear]     [value=1]
+    ATTR: [type=enum/int]   [name=interpolation_cubic]      [value=2]
+    ATTR: [type=enum/int]   [name=waveform_sine]            [value=0]
+    ATTR: [type=enum/int]   [name=waveform_square]          [value=1]
+    ATTR: [type=enum/int]   [name=waveform_triangle]        [value=2]
+    ATTR: [type=enum/int]   [name=waveform_saw]             [value=3]
+    ATTR: [type=enum/int]   [name=waveform_noise]           [value=4]
 */
 static const mp_rom_map_elem_t engine_audio_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_engine_audio) },
@@ -494,6 +1098,18 @@ static const mp_rom_map_elem_t engine_audio_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_stop), (mp_obj_t)&engine_audio_stop_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_volume), (mp_obj_t)&engine_audio_set_volume_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_volume), (mp_obj_t)&engine_audio_get_volume_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_enable_playback), (mp_obj_t)&engine_audio_enable_playback_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_disable_playback), (mp_obj_t)&engine_audio_disable_playback_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_render), (mp_obj_t)&engine_audio_render_obj },
+    { MP_ROM_QSTR(MP_QSTR_channel_count), MP_ROM_INT(CHANNEL_COUNT) },
+    { MP_ROM_QSTR(MP_QSTR_interpolation_nearest), MP_ROM_INT(ENGINE_AUDIO_INTERPOLATION_NEAREST) },
+    { MP_ROM_QSTR(MP_QSTR_interpolation_linear), MP_ROM_INT(ENGINE_AUDIO_INTERPOLATION_LINEAR) },
+    { MP_ROM_QSTR(MP_QSTR_interpolation_cubic), MP_ROM_INT(ENGINE_AUDIO_INTERPOLATION_CUBIC) },
+    { MP_ROM_QSTR(MP_QSTR_waveform_sine), MP_ROM_INT(TONE_WAVEFORM_SINE) },
+    { MP_ROM_QSTR(MP_QSTR_waveform_square), MP_ROM_INT(TONE_WAVEFORM_SQUARE) },
+    { MP_ROM_QSTR(MP_QSTR_waveform_triangle), MP_ROM_INT(TONE_WAVEFORM_TRIANGLE) },
+    { MP_ROM_QSTR(MP_QSTR_waveform_saw), MP_ROM_INT(TONE_WAVEFORM_SAW) },
+    { MP_ROM_QSTR(MP_QSTR_waveform_noise), MP_ROM_INT(TONE_WAVEFORM_NOISE) },
 };
 
 // Module init
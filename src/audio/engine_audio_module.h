@@ -14,7 +14,39 @@ void engine_audio_freq_adjust();
 void engine_audio_setup();
 void engine_audio_setup_playback();
 
+// Channels are changed between these so that the mixer never sees one
+// half set up. Needed on unix where the mixer runs on SDL's audio
+// thread alongside the interpreter, on the device the mixer is an
+// interrupt on the same core and the channel's `busy` flag is enough.
+// Nothing in between should raise
+void engine_audio_lock_channels();
+void engine_audio_unlock_channels();
+
 void engine_audio_play_on_channel(mp_obj_t sound_resource_obj, audio_channel_class_obj_t *channel, mp_obj_t loop_obj);
 void engine_audio_reset();
 
+// Returns the function that gets Q15 samples out of this type of
+// sound resource (resampled with `interpolation` for wave sources),
+// or NULL if `sound_resource_obj` is not one
+audio_channel_get_sample_t engine_audio_get_sample_function(mp_obj_t sound_resource_obj, uint8_t interpolation);
+
+// Gets the next sample from every playing channel and mixes them
+// into `output` as Q15 with the channel gains and volumes applied.
+// Returns false if nothing is playing. Run by the audio interrupt
+bool engine_audio_mix_sample(int16_t *output);
+
+// Calls `function` with `data` `call_count` times on the calling core
+// with the audio interrupt held off and measures how long each call
+// took. Cycles are 0 where there is no cycle counter to read
+void engine_audio_benchmark(void (*function)(void *data), void *data, uint32_t call_count, float *cycles_per_call, float *us_per_call);
+
+// Runs the mixer `sample_count` times on the calling core with the
+// audio interrupt held off and measures how long each sample took
+// with what is playing right now
+void engine_audio_benchmark_mix(uint32_t sample_count, float *cycles_per_sample, float *us_per_sample, uint8_t *active_channel_count);
+
+// Mixes `sample_count` samples on the calling core and writes them to
+// a 16-bit mono `.wav` at `filepath` instead of playing them
+void engine_audio_render_to_wave(mp_obj_t filepath, uint32_t sample_count);
+
 #endif  // ENGINE_AUDIO_MODULE
\ No newline at end of file
@@ -2,6 +2,13 @@
 #include "py/obj.h"
 
 #include "debug_print.h"
+#include "physics/engine_physics.h"
+#include "physics/collision_contact_2d.h"
+#include "nodes/3D/camera_node.h"
+#include "utility/linked_list.h"
+#include "draw/engine_color.h"
+#include "audio/engine_audio_module.h"
+#include "resources/engine_tone_sound_resource.h"
 #include "../fault/engine_trace_portable.h"
 
 #undef DEBUG_TRACER_NUMBER
@@ -81,6 +88,145 @@ static mp_obj_t engine_debug_enable_setting(mp_obj_t debug_setting){
 MP_DEFINE_CONST_FUN_OBJ_1(engine_debug_enable_setting_obj, engine_debug_enable_setting);
 
 
+/*  --- doc ---
+    NAME: physics_pair_tests
+    ID: physics_pair_tests
+    DESC: Returns how many pairs of physics nodes passed the broad-phase and were checked for collision during the last physics step
+    RETURN: int
+*/
+static mp_obj_t engine_debug_physics_pair_tests(){
+    return mp_obj_new_int(engine_physics_get_pair_test_count());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_physics_pair_tests_obj, engine_debug_physics_pair_tests);
+
+
+/*  --- doc ---
+    NAME: physics_heap_contacts
+    ID: physics_heap_contacts
+    DESC: Returns how many contacts passed to `on_collide` callbacks during the last physics step did not fit in the contact pool and were allocated on the heap instead
+    RETURN: int
+*/
+static mp_obj_t engine_debug_physics_heap_contacts(){
+    return mp_obj_new_int(collision_contact_2d_pool_get_heap_count());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_physics_heap_contacts_obj, engine_debug_physics_heap_contacts);
+
+
+/*  --- doc ---
+    NAME: drawn_nodes
+    ID: drawn_nodes
+    DESC: Returns how many times 2D nodes (Rectangle2DNode, Line2DNode, Circle2DNode, Sprite2DNode and Text2DNode) were drawn for a camera during the last draw pass. A node seen by two cameras counts twice
+    RETURN: int
+*/
+static mp_obj_t engine_debug_drawn_nodes(){
+    return mp_obj_new_int(engine_camera_get_drawn_count());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_drawn_nodes_obj, engine_debug_drawn_nodes);
+
+
+/*  --- doc ---
+    NAME: culled_nodes
+    ID: culled_nodes
+    DESC: Returns how many times 2D nodes were not drawn for a camera during the last draw pass because their bounds were completely off the screen
+    RETURN: int
+*/
+static mp_obj_t engine_debug_culled_nodes(){
+    return mp_obj_new_int(engine_camera_get_culled_count());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_culled_nodes_obj, engine_debug_culled_nodes);
+
+
+/*  --- doc ---
+    NAME: list_node_stats
+    ID: list_node_stats
+    DESC: Returns a tuple of the number of list nodes the engine is using right now to track nodes (children, cameras, physics, gui and deletion lists), the most it has used at once, and the number of slabs allocated to hold them. Once the high-water mark is reached, spawning and destroying nodes should not allocate any more slabs
+    RETURN: (in_use, high_water, slabs)
+*/
+static mp_obj_t engine_debug_list_node_stats(){
+    uint32_t in_use = 0;
+    uint32_t high_water = 0;
+    uint32_t slab_count = 0;
+    linked_list_get_pool_stats(&in_use, &high_water, &slab_count);
+
+    mp_obj_t stats[3];
+    stats[0] = mp_obj_new_int(in_use);
+    stats[1] = mp_obj_new_int(high_water);
+    stats[2] = mp_obj_new_int(slab_count);
+    return mp_obj_new_tuple(3, stats);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_list_node_stats_obj, engine_debug_list_node_stats);
+
+
+/*  --- doc ---
+    NAME: color_blend_mismatches
+    ID: color_blend_mismatches
+    DESC: Blends every pair of RGB565 channel values at every 1/256 step blend amount (the amounts shaders store) with both the table based color blend used for drawing and the float version it replaced. Returns how many results differ, which should be 0. Amounts between the steps are rounded to the nearest step first, so there a channel can be 1 off from the float version. Slow, only meant for tests
+    RETURN: int
+*/
+static mp_obj_t engine_debug_color_blend_mismatches(){
+    return mp_obj_new_int(engine_color_blend_count_mismatches());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_color_blend_mismatches_obj, engine_debug_color_blend_mismatches);
+
+
+/*  --- doc ---
+    NAME: audio_mix_cycles
+    ID: audio_mix_cycles
+    DESC: Runs the audio mixer used by the audio interrupt `sample_count` times with whatever is playing on the channels right now (the interrupt is held off while this runs, so audio stutters). Returns the average CPU cycles and microseconds each sample took along with how many channels were playing. Cycles are only counted on the device and do not include entering/leaving the interrupt
+    PARAM: [type=int]       [name=sample_count]     [value=any positive int (22050 is one second of audio)]
+    RETURN: (cycles_per_sample, us_per_sample, active_channel_count)
+*/
+static mp_obj_t engine_debug_audio_mix_cycles(mp_obj_t sample_count_obj){
+    mp_int_t sample_count = mp_obj_get_int(sample_count_obj);
+
+    if(sample_count <= 0){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDebug: ERROR: Sample count must be greater than 0"));
+    }
+
+    float cycles_per_sample = 0.0f;
+    float us_per_sample = 0.0f;
+    uint8_t active_channel_count = 0;
+    engine_audio_benchmark_mix(sample_count, &cycles_per_sample, &us_per_sample, &active_channel_count);
+
+    mp_obj_t results[3];
+    results[0] = mp_obj_new_float(cycles_per_sample);
+    results[1] = mp_obj_new_float(us_per_sample);
+    results[2] = mp_obj_new_int(active_channel_count);
+    return mp_obj_new_tuple(3, results);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_debug_audio_mix_cycles_obj, engine_debug_audio_mix_cycles);
+
+
+/*  --- doc ---
+    NAME: tone_sample_cycles
+    ID: tone_sample_cycles
+    DESC: Generates `sample_count` samples of a 440Hz sine with the wavetable oscillator ToneSoundResource uses and then with the `sinf` oscillator it replaced, and returns the average CPU cycles and microseconds each sample took for both (the audio interrupt is held off while this runs). Cycles are only counted on the device
+    PARAM: [type=int]       [name=sample_count]     [value=any positive int (22050 is one second of audio)]
+    RETURN: (wavetable_cycles_per_sample, wavetable_us_per_sample, sinf_cycles_per_sample, sinf_us_per_sample)
+*/
+static mp_obj_t engine_debug_tone_sample_cycles(mp_obj_t sample_count_obj){
+    mp_int_t sample_count = mp_obj_get_int(sample_count_obj);
+
+    if(sample_count <= 0){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDebug: ERROR: Sample count must be greater than 0"));
+    }
+
+    float table_cycles = 0.0f;
+    float table_us = 0.0f;
+    float sinf_cycles = 0.0f;
+    float sinf_us = 0.0f;
+    tone_sound_resource_benchmark(sample_count, &table_cycles, &table_us, &sinf_cycles, &sinf_us);
+
+    mp_obj_t results[4];
+    results[0] = mp_obj_new_float(table_cycles);
+    results[1] = mp_obj_new_float(table_us);
+    results[2] = mp_obj_new_float(sinf_cycles);
+    results[3] = mp_obj_new_float(sinf_us);
+    return mp_obj_new_tuple(4, results);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_debug_tone_sample_cycles_obj, engine_debug_tone_sample_cycles);
+
+
 /*  --- doc ---
     NAME: engine_debug
     ID: engine_debug
@@ -88,6 +234,14 @@ MP_DEFINE_CONST_FUN_OBJ_1(engine_debug_enable_setting_obj, engine_debug_enable_s
     ATTR: [type=function]   [name={ref_link:enable_all}]        [value=function]
     ATTR: [type=function]   [name={ref_link:disable_all}]       [value=function]
     ATTR: [type=function]   [name={ref_link:enable_setting}]    [value=function]
+    ATTR: [type=function]   [name={ref_link:physics_pair_tests}] [value=function]
+    ATTR: [type=function]   [name={ref_link:physics_heap_contacts}] [value=function]
+    ATTR: [type=function]   [name={ref_link:drawn_nodes}]       [value=function]
+    ATTR: [type=function]   [name={ref_link:culled_nodes}]      [value=function]
+    ATTR: [type=function]   [name={ref_link:list_node_stats}]   [value=function]
+    ATTR: [type=function]   [name={ref_link:color_blend_mismatches}] [value=function]
+    ATTR: [type=function]   [name={ref_link:audio_mix_cycles}]  [value=function]
+    ATTR: [type=function]   [name={ref_link:tone_sample_cycles}] [value=function]
     ATTR: [type=enum/int]   [name=info]                         [value=0]
     ATTR: [type=enum/int]   [name=warnings]                     [value=1]
     ATTR: [type=enum/int]   [name=errors]                       [value=2]
@@ -99,6 +253,14 @@ static const mp_rom_map_elem_t engine_debug_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_runtime_tracer_breakpoint), (mp_obj_t)&engine_runtime_tracer_breakpoint_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_disable_all), (mp_obj_t)&engine_debug_disable_all_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_enable_setting), (mp_obj_t)&engine_debug_enable_setting_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_physics_pair_tests), (mp_obj_t)&engine_debug_physics_pair_tests_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_physics_heap_contacts), (mp_obj_t)&engine_debug_physics_heap_contacts_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_drawn_nodes), (mp_obj_t)&engine_debug_drawn_nodes_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_culled_nodes), (mp_obj_t)&engine_debug_culled_nodes_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_list_node_stats), (mp_obj_t)&engine_debug_list_node_stats_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_color_blend_mismatches), (mp_obj_t)&engine_debug_color_blend_mismatches_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_audio_mix_cycles), (mp_obj_t)&engine_debug_audio_mix_cycles_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_tone_sample_cycles), (mp_obj_t)&engine_debug_tone_sample_cycles_obj },
     { MP_ROM_QSTR(MP_QSTR_info), MP_ROM_INT(DEBUG_SETTING_INFO) },
     { MP_ROM_QSTR(MP_QSTR_warnings), MP_ROM_INT(DEBUG_SETTING_WARNINGS) },
     { MP_ROM_QSTR(MP_QSTR_errors), MP_ROM_INT(DEBUG_SETTING_ERRORS) },
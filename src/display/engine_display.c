@@ -65,6 +65,12 @@ float engine_display_get_brightness(){
 void engine_display_clear(){
     uint16_t *engine_fill_background = engine_display_get_background();
 
+    // Only put the background back where something was drawn
+    if(engine_display_get_damage_tracking()){
+        engine_display_clear_damage(engine_fill_background, engine_display_get_color());
+        return;
+    }
+
     // Clear the new active screen buffer
     if(engine_fill_background != NULL){
         engine_draw_fill_buffer(engine_fill_background, active_screen_buffer);
@@ -75,7 +81,75 @@ void engine_display_clear(){
 }
 
 
+// Sends rows [row_start, row_end) of the active screen buffer
+static void engine_display_send_rows(uint8_t row_start, uint8_t row_end){
+    #if defined(__EMSCRIPTEN__)
+        // Whole frame is always sent, see `engine_display_send_damage`
+    #elif defined(__unix__)
+        engine_display_sdl_update_rows(active_screen_buffer, row_start, row_end);
+    #elif defined(__arm__)
+        engine_display_gc9107_update_rows(active_screen_buffer, row_start, row_end);
+    #endif
+}
+
+
+// Only send bands of rows that differ from what is on the screen
+// (the other screen buffer). Bands separated by only a few unchanged
+// rows are merged since each band costs a window change
+#define DAMAGE_BAND_MERGE_GAP 4
+
+static void engine_display_send_changed_rows(){
+    int16_t band_start = -1;
+    int16_t band_end = -1;
+
+    for(uint8_t y=0; y<SCREEN_HEIGHT; y++){
+        if(engine_display_damage_row_changed(y) == false){
+            continue;
+        }
+
+        if(band_start != -1 && y - band_end > DAMAGE_BAND_MERGE_GAP){
+            engine_display_send_rows(band_start, band_end);
+            band_start = -1;
+        }
+
+        if(band_start == -1){
+            band_start = y;
+        }
+
+        band_end = y + 1;
+    }
+
+    if(band_start != -1){
+        engine_display_send_rows(band_start, band_end);
+    }
+}
+
+
+static void engine_display_send_damage(){
+    #if defined(__EMSCRIPTEN__)
+        engine_display_damage_consume_full_send();
+        engine_display_web_update_screen(active_screen_buffer);
+    #else
+        if(engine_display_damage_consume_full_send()){
+            engine_display_send_rows(0, SCREEN_HEIGHT);
+        }else{
+            engine_display_send_changed_rows();
+        }
+
+        #if defined(__unix__)
+            engine_display_sdl_present();
+        #endif
+    #endif
+}
+
+
 void engine_display_send(){
+    if(engine_display_get_damage_tracking()){
+        engine_display_send_damage();
+        engine_switch_active_screen_buffer();
+        return;
+    }
+
     // Send the screen buffer to the display
     // Send the screen buffer to the display
     #if defined(__EMSCRIPTEN__)
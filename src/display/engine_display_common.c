@@ -4,8 +4,10 @@
 #include "utility/engine_defines.h"
 #include "utility/engine_mp.h"
 #include "resources/engine_resource_manager.h"
+#include "math/engine_math.h"
 #include "py/misc.h"
 #include <stdlib.h>
+#include <string.h>
 #include "py/objarray.h"
 
 // The current screen buffer that should be getting drawn to (the other
@@ -14,6 +16,14 @@ uint16_t *screen_buffers[2];
 uint16_t *active_screen_buffer;
 uint16_t *depth_buffer;
 
+// What has been drawn to each screen buffer since it was last
+// cleared, see `engine_display_damage_t`
+engine_display_damage_t screen_damages[2];
+engine_display_damage_t *active_screen_damage = &screen_damages[0];
+
+bool damage_tracking_enabled = false;
+static bool damage_full_send = false;
+
 // Used to clear the screen
 uint16_t engine_fill_color = 0x0000;
 uint16_t *engine_fill_background = NULL;
@@ -24,16 +34,24 @@ static uint8_t active_screen_buffer_index = 0;
 
 
 void engine_display_set_fill_color(uint16_t color){
+    // Parts of the screen buffers that were not drawn
+    // to still have the old background
+    if(color != engine_fill_color || engine_fill_background != NULL){
+        engine_display_damage_all();
+    }
+
     engine_fill_color = color;
 }
 
 void engine_display_set_fill_background(uint16_t *data){
     engine_fill_background = data;
+    engine_display_damage_all();
 }
 
 void engine_display_reset_fills(){
     engine_fill_color = 0x0000;
     engine_fill_background = NULL;
+    engine_display_damage_all();
 }
 
 
@@ -89,6 +107,7 @@ void engine_init_screen_buffers(){
     engine_draw_fill_color(0x0, screen_buffers[1]);
 
     active_screen_buffer = screen_buffers[0];
+    engine_display_damage_all();
 }
 
 
@@ -109,6 +128,7 @@ void engine_switch_active_screen_buffer(){
     // Switch which screen buffer should be drawn to (back buffer)
     active_screen_buffer_index = 1 - active_screen_buffer_index;
     active_screen_buffer = screen_buffers[active_screen_buffer_index];
+    active_screen_damage = &screen_damages[active_screen_buffer_index];
 
     // Now that we switched the old back buffer 0 to the new front buffer,
     // make the new back buffer the old front buffer (active_screen_buffer_index=1)
@@ -118,6 +138,7 @@ void engine_switch_active_screen_buffer(){
 
 void ENGINE_FAST_FUNCTION(engine_display_clear_screen_buffer)(uint16_t color){
     engine_draw_fill_color(color, active_screen_buffer);
+    engine_display_damage_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 }
 
 
@@ -160,4 +181,103 @@ bool ENGINE_FAST_FUNCTION(engine_display_store_check_depth)(uint8_t sx, uint8_t
 
 uint16_t *engine_display_get_depth_buffer(){
     return depth_buffer;
+}
+
+
+static void engine_display_damage_reset(engine_display_damage_t *damage){
+    memset(damage->x_start, SCREEN_WIDTH, SCREEN_HEIGHT);
+    memset(damage->x_end, 0, SCREEN_HEIGHT);
+}
+
+
+void engine_display_damage_rect(int32_t x_start, int32_t y_start, int32_t x_end, int32_t y_end){
+    if(damage_tracking_enabled == false){
+        return;
+    }
+
+    x_start = max(x_start, 0);
+    y_start = max(y_start, 0);
+    x_end = min(x_end, SCREEN_WIDTH);
+    y_end = min(y_end, SCREEN_HEIGHT);
+
+    if(x_start >= x_end){
+        return;
+    }
+
+    for(int32_t y=y_start; y<y_end; y++){
+        engine_display_damage_span(y, x_start, x_end);
+    }
+}
+
+
+void engine_display_damage_all(){
+    for(uint8_t i=0; i<2; i++){
+        memset(screen_damages[i].x_start, 0, SCREEN_HEIGHT);
+        memset(screen_damages[i].x_end, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+
+    damage_full_send = true;
+}
+
+
+void engine_display_set_damage_tracking(bool enabled){
+    // Whatever was drawn while not tracking is unknown (and
+    // the screen may not match either buffer), start full
+    if(enabled && !damage_tracking_enabled){
+        engine_display_damage_all();
+    }
+
+    damage_tracking_enabled = enabled;
+}
+
+
+bool engine_display_get_damage_tracking(){
+    return damage_tracking_enabled;
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_display_clear_damage)(uint16_t *background, uint16_t color){
+    for(uint8_t y=0; y<SCREEN_HEIGHT; y++){
+        uint8_t x_start = active_screen_damage->x_start[y];
+        uint8_t x_end = active_screen_damage->x_end[y];
+
+        if(x_start >= x_end){
+            continue;
+        }
+
+        uint32_t offset = y * SCREEN_WIDTH + x_start;
+        uint16_t count = x_end - x_start;
+
+        if(background != NULL){
+            memcpy(active_screen_buffer + offset, background + offset, count * sizeof(uint16_t));
+        }else{
+            uint16_t *dest = active_screen_buffer + offset;
+            while(count--) *dest++ = color;
+        }
+    }
+
+    engine_display_damage_reset(active_screen_damage);
+}
+
+
+bool ENGINE_FAST_FUNCTION(engine_display_damage_row_changed)(uint8_t y){
+    engine_display_damage_t *last_damage = &screen_damages[1 - active_screen_buffer_index];
+
+    uint8_t x_start = MIN(active_screen_damage->x_start[y], last_damage->x_start[y]);
+    uint8_t x_end = MAX(active_screen_damage->x_end[y], last_damage->x_end[y]);
+
+    // Neither drew here, both are background
+    if(x_start >= x_end){
+        return false;
+    }
+
+    uint32_t offset = y * SCREEN_WIDTH + x_start;
+    return memcmp(active_screen_buffer + offset, screen_buffers[1 - active_screen_buffer_index] + offset, (x_end - x_start) * sizeof(uint16_t)) != 0;
+}
+
+
+bool engine_display_damage_consume_full_send(){
+    bool full_send = damage_full_send;
+    damage_full_send = false;
+    return full_send;
 }
\ No newline at end of file
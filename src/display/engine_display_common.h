@@ -61,4 +61,47 @@ uint16_t *engine_display_get_depth_buffer();
 bool engine_display_store_check_depth_index(uint16_t index, uint16_t depth);
 bool engine_display_store_check_depth(uint8_t sx, uint8_t sy, uint16_t depth);
 
+
+// Per row extents [x_start, x_end) of everything drawn into a screen
+// buffer since it was last cleared. Only recorded while damage tracking
+// is enabled and used to limit clearing and sending the screen buffers
+typedef struct engine_display_damage_t{
+    uint8_t x_start[SCREEN_HEIGHT];
+    uint8_t x_end[SCREEN_HEIGHT];
+}engine_display_damage_t;
+
+// Defined in engine_display_common.c, damage of `active_screen_buffer`
+extern engine_display_damage_t *active_screen_damage;
+extern bool damage_tracking_enabled;
+
+// Record that pixels [x_start, x_end) of row `y` were drawn to (must be on screen).
+// Does nothing while damage tracking is off, turning it on damages everything
+static inline void engine_display_damage_span(int32_t y, int32_t x_start, int32_t x_end){
+    if(damage_tracking_enabled == false) return;
+    if(x_start < active_screen_damage->x_start[y]) active_screen_damage->x_start[y] = x_start;
+    if(x_end > active_screen_damage->x_end[y]) active_screen_damage->x_end[y] = x_end;
+}
+
+// Same as above but for a rectangle, clipped to the screen
+void engine_display_damage_rect(int32_t x_start, int32_t y_start, int32_t x_end, int32_t y_end);
+
+// Marks every row of both screen buffers as fully drawn so that
+// the next clear of each is full (used when the background changes)
+void engine_display_damage_all();
+
+void engine_display_set_damage_tracking(bool enabled);
+bool engine_display_get_damage_tracking();
+
+// Clears only the damaged parts of the active screen buffer
+// to the background and resets its damage
+void engine_display_clear_damage(uint16_t *background, uint16_t color);
+
+// Returns true if row `y` of the active screen buffer differs from
+// the same row in the other (last sent) screen buffer. Only the parts
+// of the row that either buffer drew to are compared
+bool engine_display_damage_row_changed(uint8_t y);
+
+// Gets and clears the flag that the next send needs to be the whole frame
+bool engine_display_damage_consume_full_send();
+
 #endif  // ENGINE_DISPLAY_COMMON
\ No newline at end of file
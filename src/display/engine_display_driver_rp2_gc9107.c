@@ -79,14 +79,19 @@ static void gc9107_write_cmd(uint8_t cmd, const uint8_t* data, size_t length){
 }
 
 
-void gc9107_reset_window(){
+// Set the window to full width rows [row_start, row_end)
+void gc9107_set_row_window(uint8_t row_start, uint8_t row_end){
+    const uint16_t window_addr_y1 = WINDOW_ADDR_Y1 + row_start;
+    const uint16_t window_addr_y2 = WINDOW_ADDR_Y1 + row_end - 1;
+
     gc9107_write_cmd(0x36, (uint8_t[]){ 0x00 }, 1);
     gc9107_write_cmd(0x2a, (uint8_t[]){ WINDOW_ADDR_X1>>8, WINDOW_ADDR_X1, WINDOW_ADDR_X2>>8, WINDOW_ADDR_X2 }, 4);
-    gc9107_write_cmd(0x2b, (uint8_t[]){ WINDOW_ADDR_Y1>>8, WINDOW_ADDR_Y1, WINDOW_ADDR_Y2>>8, WINDOW_ADDR_Y2 }, 4);
+    gc9107_write_cmd(0x2b, (uint8_t[]){ window_addr_y1>>8, window_addr_y1, window_addr_y2>>8, window_addr_y2 }, 4);
     gc9107_write_cmd(0x2c, NULL, 0);
 }
 
 
+
 void engine_display_gc9107_apply_brightness(float brightness){
     pio_pwm_set_level(pio, sm, (uint32_t)(255.0f*brightness));
 }
@@ -235,9 +240,16 @@ void engine_display_gc9107_init(){
 void engine_display_gc9107_update(uint16_t *screen_buffer_to_render){
     if(dma_channel_is_busy(dma_tx)){
         ENGINE_WARNING_PRINTF("Waiting on previous DMA transfer to complete. Could have done more last frame!");
-        dma_channel_wait_for_finish_blocking(dma_tx);
     }
 
+    engine_display_gc9107_update_rows(screen_buffer_to_render, 0, SCREEN_HEIGHT);
+}
+
+
+void engine_display_gc9107_update_rows(uint16_t *screen_buffer_to_render, uint8_t row_start, uint8_t row_end){
+    // Expected when sending more than one band of rows per frame
+    dma_channel_wait_for_finish_blocking(dma_tx);
+
     // For SPI must also wait for FIFO to flush and reset format
     // https://github.com/Bodmer/TFT_eSPI/blob/5162af0a0e13e0d4bc0e4c792ed28d38599a1f23/Processors/TFT_eSPI_RP2040.c#L600-L602
     while (spi_get_hw(spi0)->sr & SPI_SSPSR_BSY_BITS) {};
@@ -245,9 +257,9 @@ void engine_display_gc9107_update(uint16_t *screen_buffer_to_render){
 
     // Point DMA to active screen buffer that should be
     // sent now that the last frame is finished sending
-    txbuf = screen_buffer_to_render;
+    txbuf = screen_buffer_to_render + row_start * SCREEN_WIDTH;
 
-    gc9107_reset_window();
+    gc9107_set_row_window(row_start, row_end);
 
     gpio_put(PIN_GP17_SPI0_CSn__TO__CS, 0);
     gpio_put(PIN_GP16__TO__DC,          1);
@@ -256,6 +268,6 @@ void engine_display_gc9107_update(uint16_t *screen_buffer_to_render){
     dma_channel_configure(dma_tx, &dma_config,
                           &spi_get_hw(spi0)->dr,        // write address
                           txbuf,                        // read address
-                          SCREEN_BUFFER_SIZE_PIXELS,    // element count (each element is of size DMA_SIZE_16)
+                          (row_end - row_start) * SCREEN_WIDTH,    // element count (each element is of size DMA_SIZE_16)
                           true);                        // don't start yet, need to set active frame buffer later
 }
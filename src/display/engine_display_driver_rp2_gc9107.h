@@ -9,4 +9,8 @@ void engine_display_gc9107_apply_brightness(float brightness);
 void engine_display_gc9107_init();
 void engine_display_gc9107_update(uint16_t *screen_buffer_to_render);
 
+// Only send rows [row_start, row_end), waits on any transfer
+// that is still going before changing the window
+void engine_display_gc9107_update_rows(uint16_t *screen_buffer_to_render, uint8_t row_start, uint8_t row_end);
+
 #endif  // ENGINE_DISPLAY_DRIVER_RP2_GC9107_H
@@ -23,6 +23,19 @@
     }
 
 
+    void engine_display_sdl_update_rows(uint16_t *screen_buffer_to_render, uint8_t row_start, uint8_t row_end){
+        SDL_Rect rows = {.x = 0, .y = row_start, .w = SCREEN_WIDTH, .h = row_end - row_start};
+        SDL_UpdateTexture(window_frame_buffer, &rows, screen_buffer_to_render + row_start * SCREEN_WIDTH, SCREEN_WIDTH*sizeof(uint16_t));
+    }
+
+
+    void engine_display_sdl_present(){
+        SDL_RenderClear(window_renderer);
+        SDL_RenderCopy(window_renderer, window_frame_buffer, NULL, NULL);
+        SDL_RenderPresent(window_renderer);
+    }
+
+
     void engine_display_sdl_init(){
         // https://dev.to/noah11012/using-sdl2-opening-a-window-79c
         if(SDL_Init(SDL_INIT_VIDEO) < 0){
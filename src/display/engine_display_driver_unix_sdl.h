@@ -6,5 +6,10 @@
 void engine_display_sdl_init();
 void engine_display_sdl_update_screen(uint16_t *screen_buffer_to_render);
 
+// Only update rows [row_start, row_end) of the window texture,
+// call `engine_display_sdl_present()` after all rows are updated
+void engine_display_sdl_update_rows(uint16_t *screen_buffer_to_render, uint8_t row_start, uint8_t row_end);
+void engine_display_sdl_present();
+
 
 #endif  // ENGINE_DISPLAY_DRIVER_UNIX_SDL_H
\ No newline at end of file
@@ -31,8 +31,70 @@ static inline void engine_color_split_u16(uint16_t color, uint16_t *r, uint16_t
     *b = (color >>  0) & bitmask_5_bit;
 }
 
+// Squares of every 5 and 6-bit channel value
+static const uint16_t engine_color_blend_squares[64] = {
+       0,    1,    4,    9,   16,   25,   36,   49,   64,   81,  100,  121,  144,  169,  196,  225,
+     256,  289,  324,  361,  400,  441,  484,  529,  576,  625,  676,  729,  784,  841,  900,  961,
+    1024, 1089, 1156, 1225, 1296, 1369, 1444, 1521, 1600, 1681, 1764, 1849, 1936, 2025, 2116, 2209,
+    2304, 2401, 2500, 2601, 2704, 2809, 2916, 3025, 3136, 3249, 3364, 3481, 3600, 3721, 3844, 3969,
+};
+
+// Smallest blended square (scaled by `ENGINE_COLOR_BLEND_FIXED_ONE`) whose
+// rounded square root is the index: 256 * (k - 0.5)^2 = 64 * (2k - 1)^2
+static const uint32_t engine_color_blend_sqrt_thresholds[64] = {
+         0,     64,    576,   1600,   3136,   5184,   7744,  10816,
+     14400,  18496,  23104,  28224,  33856,  40000,  46656,  53824,
+     61504,  69696,  78400,  87616,  97344, 107584, 118336, 129600,
+    141376, 153664, 166464, 179776, 193600, 207936, 222784, 238144,
+    254016, 270400, 287296, 304704, 322624, 341056, 360000, 379456,
+    399424, 419904, 440896, 462400, 484416, 506944, 529984, 553536,
+    577600, 602176, 627264, 652864, 678976, 705600, 732736, 760384,
+    788544, 817216, 846400, 876096, 906304, 937024, 968256, 1000000,
+};
+
+// round(sqrt((1-t) * from^2 + t * to^2)) for one channel. The result is
+// always between `from` and `to` so only that range of the table is searched
+static inline uint16_t engine_color_blend_channel(uint16_t from, uint16_t to, uint16_t amount){
+    uint32_t mixed = (ENGINE_COLOR_BLEND_FIXED_ONE - amount) * engine_color_blend_squares[from] + amount * engine_color_blend_squares[to];
+
+    uint16_t low = min(from, to);
+    uint16_t high = max(from, to);
+
+    while(low < high){
+        uint16_t middle = (low + high + 1) >> 1;
+
+        if(engine_color_blend_sqrt_thresholds[middle] <= mixed){
+            low = middle;
+        }else{
+            high = middle - 1;
+        }
+    }
+
+    return low;
+}
+
 // https://stackoverflow.com/a/29321264
+uint16_t ENGINE_FAST_FUNCTION(engine_color_blend_fixed)(uint16_t from, uint16_t to, uint16_t amount){
+    uint16_t from_r, from_g, from_b;
+    engine_color_split_u16(from, &from_r, &from_g, &from_b);
+    uint16_t to_r, to_g, to_b;
+    engine_color_split_u16(to, &to_r, &to_g, &to_b);
+
+    const uint16_t out_r = engine_color_blend_channel(from_r, to_r, amount);
+    const uint16_t out_g = engine_color_blend_channel(from_g, to_g, amount);
+    const uint16_t out_b = engine_color_blend_channel(from_b, to_b, amount);
+
+    return (out_r << 11) | (out_g << 5) | (out_b << 0);
+}
+
+
 uint16_t ENGINE_FAST_FUNCTION(engine_color_blend)(uint16_t from, uint16_t to, float amount){
+    return engine_color_blend_fixed(from, to, engine_color_blend_amount_to_fixed(amount));
+}
+
+
+// Float version of the blend above that the tables are checked against
+uint16_t engine_color_blend_reference(uint16_t from, uint16_t to, float amount){
     uint16_t from_r, from_g, from_b;
     engine_color_split_u16(from, &from_r, &from_g, &from_b);
     uint16_t to_r, to_g, to_b;
@@ -46,6 +108,31 @@ uint16_t ENGINE_FAST_FUNCTION(engine_color_blend)(uint16_t from, uint16_t to, fl
 }
 
 
+uint32_t engine_color_blend_count_mismatches(){
+    uint32_t mismatches = 0;
+
+    // Every pair of channel values at every blend amount. A channel
+    // is 6 bits at most, so putting the same value in all three
+    // channels (clamped to 5 bits for red and blue) covers them all
+    for(uint16_t from=0; from<=bitmask_6_bit; from++){
+        for(uint16_t to=0; to<=bitmask_6_bit; to++){
+            uint16_t from_color = (min(from, bitmask_5_bit) << 11) | (from << 5) | (min(from, bitmask_5_bit) << 0);
+            uint16_t to_color = (min(to, bitmask_5_bit) << 11) | (to << 5) | (min(to, bitmask_5_bit) << 0);
+
+            for(uint16_t amount=0; amount<=ENGINE_COLOR_BLEND_FIXED_ONE; amount++){
+                float amount_float = amount * (1.0f / ENGINE_COLOR_BLEND_FIXED_ONE);
+
+                if(engine_color_blend_fixed(from_color, to_color, amount) != engine_color_blend_reference(from_color, to_color, amount_float)){
+                    mismatches++;
+                }
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+
 // https://stackoverflow.com/a/19060243
 uint16_t ENGINE_FAST_FUNCTION(engine_color_alpha_blend)(uint16_t background, uint16_t foreground, float alpha){
     uint16_t bg_r, bg_g, bg_b;
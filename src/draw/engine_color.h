@@ -41,7 +41,60 @@ mp_obj_t engine_color_wrap_opt(mp_obj_t color_or_none);
 
 mp_obj_t color_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
+// Rounds `amount` to the nearest 1/256 first. At amounts that are already
+// a multiple of 1/256 (what shader programs store) the result is the same as
+// `engine_color_blend_reference`, at others a channel can be 1 off from it
 uint16_t ENGINE_FAST_FUNCTION(engine_color_blend)(uint16_t from, uint16_t to, float amount);
+
+// Same as `engine_color_blend` with a 0 ~ 256 (`ENGINE_COLOR_BLEND_FIXED_ONE`)
+// amount. Uses square and square root tables instead of floats
+uint16_t ENGINE_FAST_FUNCTION(engine_color_blend_fixed)(uint16_t from, uint16_t to, uint16_t amount);
+
+// The float blend the tables replace and the number of colors and 1/256 step
+// amounts where the two differ (should always be 0, see `engine_debug.color_blend_mismatches()`)
+uint16_t engine_color_blend_reference(uint16_t from, uint16_t to, float amount);
+uint32_t engine_color_blend_count_mismatches();
 uint16_t ENGINE_FAST_FUNCTION(engine_color_alpha_blend)(uint16_t background, uint16_t foreground, float alpha);
 
+
+// Integer opacity used by the `_fixed` blending paths: 0 ~ 32 where 32 is fully opaque
+#define ENGINE_ALPHA_FIXED_ONE      32
+
+// RGB565 spread so that each channel has room to be multiplied by a
+// 0 ~ 32 opacity without running into the next: 00000GGGGGG00000RRRRR000000BBBBB
+#define ENGINE_COLOR_SPREAD_MASK    0x07E0F81F
+
+// Integer amount used by `engine_color_blend_fixed`: 0 ~ 256 where 256 is all `to`
+#define ENGINE_COLOR_BLEND_FIXED_ONE 256
+
+static inline uint16_t engine_color_blend_amount_to_fixed(float amount){
+    if(amount <= 0.0f) return 0;
+    if(amount >= 1.0f) return ENGINE_COLOR_BLEND_FIXED_ONE;
+    return (uint16_t)(amount * ENGINE_COLOR_BLEND_FIXED_ONE + 0.5f);
+}
+
+static inline uint8_t engine_color_alpha_to_fixed(float alpha){
+    if(alpha <= 0.0f) return 0;
+    if(alpha >= 1.0f) return ENGINE_ALPHA_FIXED_ONE;
+    return (uint8_t)(alpha * ENGINE_ALPHA_FIXED_ONE + 0.5f);
+}
+
+static inline uint32_t engine_color_spread(uint16_t color){
+    return (color | ((uint32_t)color << 16)) & ENGINE_COLOR_SPREAD_MASK;
+}
+
+static inline uint16_t engine_color_unspread(uint32_t spread){
+    spread &= ENGINE_COLOR_SPREAD_MASK;
+    return (uint16_t)(spread | (spread >> 16));
+}
+
+// Blends all three channels with a single multiply, `alpha` is 0 ~ 32
+// https://www.virtualdub.org/blog2/entry_117.html
+static inline uint16_t engine_color_alpha_blend_fixed(uint16_t background, uint16_t foreground, uint8_t alpha){
+    uint32_t bg = engine_color_spread(background);
+    uint32_t fg = engine_color_spread(foreground);
+
+    return engine_color_unspread((((fg - bg) * alpha) >> 5) + bg);
+}
+
 #endif  /// ENGINE_COLOR_H
@@ -11,6 +11,7 @@
 #include "math/engine_math.h"
 #include "draw/engine_color.h"
 #include "draw/engine_shader.h"
+#include "draw/engine_draw_commands.h"
 
 #include "py/objstr.h"
 #include "py/objtype.h"
@@ -38,8 +39,17 @@ void ENGINE_FAST_FUNCTION(engine_draw_fill_buffer)(uint16_t* src_buffer, uint16_
 
 void ENGINE_FAST_FUNCTION(engine_draw_pixel)(uint16_t color, int32_t x, int32_t y, float alpha, engine_shader_t *shader){
     if((x >= 0 && x < SCREEN_WIDTH) && (y >= 0 && y < SCREEN_HEIGHT)){
+        if(engine_draw_commands_recording()){
+            engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_PIXEL, alpha, shader);
+            command->pixel.color = color;
+            command->pixel.x = x;
+            command->pixel.y = y;
+            return;
+        }
+
         uint16_t index = y * SCREEN_WIDTH + x;
 
+        engine_display_damage_span(y, x, x+1);
         active_screen_buffer[index] = shader->execute(active_screen_buffer[index], color, alpha, shader);
     }
 }
@@ -47,12 +57,94 @@ void ENGINE_FAST_FUNCTION(engine_draw_pixel)(uint16_t color, int32_t x, int32_t
 
 void ENGINE_FAST_FUNCTION(engine_draw_pixel_no_check)(uint16_t color, int32_t x, int32_t y, float alpha, engine_shader_t *shader){
     uint16_t index = y * SCREEN_WIDTH + x;
+    engine_display_damage_span(y, x, x+1);
     active_screen_buffer[index] = shader->execute(active_screen_buffer[index], color, alpha, shader);
 }
 
 
+void ENGINE_FAST_FUNCTION(engine_draw_hspan)(uint16_t color, int32_t x_start, int32_t x_end, int32_t y, float alpha, engine_shader_t *shader){
+    // Clip the whole span once
+    if(y < 0 || y >= SCREEN_HEIGHT){
+        return;
+    }
+
+    x_start = max(x_start, 0);
+    x_end = min(x_end, SCREEN_WIDTH);
+
+    if(x_start >= x_end){
+        return;
+    }
+
+    engine_display_damage_span(y, x_start, x_end);
+
+    uint16_t *dest = active_screen_buffer + y * SCREEN_WIDTH + x_start;
+    uint16_t *dest_end = active_screen_buffer + y * SCREEN_WIDTH + x_end;
+
+    uint8_t alpha_fixed = engine_color_alpha_to_fixed(alpha);
+
+    // The builtin shaders are common enough that it's worth
+    // not calling through `execute` for every pixel of the span
+    if(shader->execute == engine_pixel_shader_empty || (shader->execute == engine_pixel_shader_alpha && alpha_fixed == ENGINE_ALPHA_FIXED_ONE)){
+        while(dest < dest_end) *dest++ = color;
+    }else if(shader->execute == engine_pixel_shader_alpha){
+        if(alpha_fixed == 0){
+            return;
+        }
+
+        // Foreground is the same for the whole span, spread and
+        // pre-multiply it once: out = (fg*a + bg*(32-a)) / 32
+        uint32_t fg_weighted = engine_color_spread(color) * alpha_fixed;
+        uint32_t bg_weight = ENGINE_ALPHA_FIXED_ONE - alpha_fixed;
+
+        // Get to a 32-bit boundary
+        if(((uintptr_t)dest & 0b11) != 0){
+            *dest = engine_color_unspread((fg_weighted + engine_color_spread(*dest) * bg_weight) >> 5);
+            dest++;
+        }
+
+        // Two pixels per word: masking the word directly gives the R and B
+        // of the low pixel with the G of the high pixel and masking it with
+        // halves swapped gives the rest. Both are laid out like a spread
+        // pixel so they blend against the same spread foreground
+        uint32_t *dest_pair = (uint32_t*)dest;
+        uint32_t *dest_pair_end = (uint32_t*)(dest + ((dest_end - dest) & ~1));
+
+        while(dest_pair < dest_pair_end){
+            uint32_t bg_pair = *dest_pair;
+            uint32_t bg_swapped = (bg_pair >> 16) | (bg_pair << 16);
+
+            uint32_t out_a = ((fg_weighted + (bg_pair & ENGINE_COLOR_SPREAD_MASK) * bg_weight) >> 5) & ENGINE_COLOR_SPREAD_MASK;
+            uint32_t out_b = ((fg_weighted + (bg_swapped & ENGINE_COLOR_SPREAD_MASK) * bg_weight) >> 5) & ENGINE_COLOR_SPREAD_MASK;
+
+            *dest_pair++ = out_a | (((out_b >> 16) | (out_b << 16)) & ~ENGINE_COLOR_SPREAD_MASK);
+        }
+
+        // Odd pixel left over at the end
+        dest = (uint16_t*)dest_pair;
+        if(dest < dest_end){
+            *dest = engine_color_unspread((fg_weighted + engine_color_spread(*dest) * bg_weight) >> 5);
+        }
+    }else{
+        while(dest < dest_end){
+            *dest = shader->execute(*dest, color, alpha, shader);
+            dest++;
+        }
+    }
+}
+
+
 // https://en.wikipedia.org/wiki/Digital_differential_analyzer_(graphics_algorithm)
 void engine_draw_line(uint16_t color, float x_start, float y_start, float x_end, float y_end, float alpha, engine_shader_t *shader){
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_LINE, alpha, shader);
+        command->line.color = color;
+        command->line.x_start = x_start;
+        command->line.y_start = y_start;
+        command->line.x_end = x_end;
+        command->line.y_end = y_end;
+        return;
+    }
+
     // Distance difference between endpoints
     float dx = x_end - x_start;
     float dy = y_end - y_start;
@@ -84,7 +176,83 @@ void engine_draw_line(uint16_t color, float x_start, float y_start, float x_end,
 
 
 
+// Figure out where the top-left of an unrotated and unscaled bitmap lands
+// on the screen. Matches what the rotating loops below produce for these
+// cases so that switching between the paths never shifts a sprite by a pixel
+static inline void engine_draw_axis_aligned_origin(float center_x, float center_y, int32_t width, int32_t height, int32_t *origin_x, int32_t *origin_y){
+    int32_t dim = (int32_t)sqrtf((float)(width*width) + (float)(height*height));
+    float dim_half = (dim / 2.0f);
+
+    *origin_x = (int32_t)floorf(center_x - dim_half) - (int32_t)floorf(width * 0.5f - dim_half);
+    *origin_y = (int32_t)floorf(center_y - dim_half) - (int32_t)floorf(height * 0.5f - dim_half);
+}
+
+
+// Fast path for bitmaps that are not rotated or scaled: clip the destination
+// once and then walk source and destination rows directly
+static void engine_draw_blit_axis_aligned(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, uint16_t transparent_color, float alpha, bool depth_test, uint16_t depth, engine_shader_t *shader){
+    int32_t origin_x, origin_y;
+    engine_draw_axis_aligned_origin(center_x, center_y, window_width, window_height, &origin_x, &origin_y);
+
+    int32_t dest_x_start = max(origin_x, 0);
+    int32_t dest_y_start = max(origin_y, 0);
+    int32_t dest_x_end = min(origin_x + window_width, SCREEN_WIDTH);
+    int32_t dest_y_end = min(origin_y + window_height, SCREEN_HEIGHT);
+
+    // Completely off screen
+    if(dest_x_start >= dest_x_end || dest_y_start >= dest_y_end){
+        return;
+    }
+
+    engine_display_damage_rect(dest_x_start, dest_y_start, dest_x_end, dest_y_end);
+
+    // Rows are decoded all at once by the kernel picked for the
+    // texture's format and then blended from these
+    uint16_t row_colors[SCREEN_WIDTH];
+    uint8_t row_alphas[SCREEN_WIDTH];
+    uint16_t row_count = dest_x_end - dest_x_start;
+    uint8_t alpha_fixed = engine_color_alpha_to_fixed(alpha);
+
+    for(int32_t dest_y=dest_y_start; dest_y<dest_y_end; dest_y++){
+        uint32_t dest_offset = dest_y * SCREEN_WIDTH + dest_x_start;
+        uint32_t src_offset = offset + (dest_y - origin_y) * pixels_stride + (dest_x_start - origin_x);
+
+        texture->get_row(texture, src_offset, row_count, row_colors, row_alphas);
+
+        for(uint16_t i=0; i<row_count; i++){
+            uint16_t src_color = row_colors[i];
+
+            if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
+                if(depth_test == false || engine_display_store_check_depth_index(dest_offset, depth)){
+                    // 0 ~ 255 texture alpha times 0 ~ 32 opacity back to 0 ~ 32
+                    uint8_t pixel_alpha = (row_alphas[i] * alpha_fixed + 128) >> 8;
+                    active_screen_buffer[dest_offset] = shader->execute_fixed(active_screen_buffer[dest_offset], src_color, pixel_alpha, shader);
+                }
+            }
+
+            dest_offset++;
+        }
+    }
+}
+
+
 void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, engine_shader_t *shader){
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_BLIT, alpha, shader);
+        command->blit.texture = texture;
+        command->blit.offset = offset;
+        command->blit.center_x = center_x;
+        command->blit.center_y = center_y;
+        command->blit.window_width = window_width;
+        command->blit.window_height = window_height;
+        command->blit.pixels_stride = pixels_stride;
+        command->blit.x_scale = x_scale;
+        command->blit.y_scale = y_scale;
+        command->blit.rotation_radians = rotation_radians;
+        command->blit.transparent_color = transparent_color;
+        return;
+    }
+
     /*  https://cohost.org/tomforsyth/post/891823-rotation-with-three#:~:text=But%20the%20TL%3BDR%20is%20you%20do%20three%20shears%3A
         https://stackoverflow.com/questions/65909025/rotating-a-bitmap-with-3-shears    Lots of inspiration from here
         https://computergraphics.stackexchange.com/questions/10599/rotate-a-bitmap-with-shearing
@@ -105,6 +273,17 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
         The displacements are performed twice on the x-axis and once on the y axis in x y x order.
     */
 
+    // Most sprites are drawn without rotation or scale,
+    // skip walking the rotated bounding square for those
+    if(rotation_radians == 0.0f && x_scale == 1.0f && y_scale == 1.0f){
+        engine_draw_blit_axis_aligned(texture, offset, center_x, center_y, window_width, window_height, pixels_stride, transparent_color, alpha, false, 0, shader);
+        return;
+    }
+
+    // Opacity is blended as a 0 ~ 32 integer, only textures with
+    // an alpha channel need it combined per pixel
+    uint8_t alpha_fixed = engine_color_alpha_to_fixed(alpha);
+
     // ENGINE_PERFORMANCE_CYCLES_START();
     float inverse_x_scale = 1.0f / x_scale;
     float inverse_y_scale = 1.0f / y_scale;
@@ -116,6 +295,8 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
     // Used to traverse about rotation
     float sin_angle_inv_scaled = sin_angle * inverse_y_scale;
     float cos_angle_inv_scaled = cos_angle * inverse_x_scale;
+    int32_t sin_angle_inv_scaled_fixed = ENGINE_FLOAT_TO_FIXED(sin_angle_inv_scaled);
+    int32_t cos_angle_inv_scaled_fixed = ENGINE_FLOAT_TO_FIXED(cos_angle_inv_scaled);
 
     // Controls the scale of the destination rectangle,
     // which in turn defines the total scale of the bitmap
@@ -163,6 +344,9 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
     // by the amount we are left clipping the dest rect
     uint32_t next_dest_row_offset = SCREEN_WIDTH - dim + i_start;
 
+    // Everything drawn lands somewhere in the clipped destination square
+    engine_display_damage_rect(top_left_x+i_start, top_left_y+j_start, top_left_x+dim, top_left_y+dim);
+
     int32_t i, j;
 
     // Start from clipped top and go until max destination rectangle
@@ -177,9 +361,9 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
 
         // Calculate the location of the SRC pixel. If the destination
         // gets scaled larger then we need to inversely scale into the
-        // src, and vice versa
-        float x = (half_scaled_window_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale;
-        float y = (half_scaled_window_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale;
+        // src, and vice versa. Traversed in 16.16 fixed-point
+        int32_t x = ENGINE_FLOAT_TO_FIXED((half_scaled_window_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale);
+        int32_t y = ENGINE_FLOAT_TO_FIXED((half_scaled_window_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale);
 
         for(i=i_start; i<dim; i++){
             // Check if drawing to draw out of bounds to the right,
@@ -191,13 +375,13 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
                 // screen_buffer[dest_offset] = 0b11111000000000;
 
                 // Floor these otherwise get artifacts (don't exactly know why).
-                // Floor + int seems to be faster than comparing floats
-                int32_t rotX = (int32_t)floorf(x);
-                int32_t rotY = (int32_t)floorf(y);
+                // The fixed-point shift floors without any float work
+                int32_t rotX = ENGINE_FIXED_TO_INT(x);
+                int32_t rotY = ENGINE_FIXED_TO_INT(y);
 
                 // If statements are expensive! Don't need to check if withing screen
                 // bounds since those dimensions are clipped (destination rect)
-                if((rotX >= 0 && rotX < window_width) && (rotY >= 0 && rotY < window_height)){
+                if((uint32_t)rotX < (uint32_t)window_width && (uint32_t)rotY < (uint32_t)window_height){
                     uint32_t src_offset = rotY * pixels_stride + rotX;
                     // uint16_t src_color = pixels[src_offset];
                     float src_alpha = 1.0f;
@@ -205,13 +389,14 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
 
                     if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
                         // active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], src_color, alpha, shader);
-                        active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], src_color, alpha*src_alpha, shader);
+                        uint8_t pixel_alpha = texture->has_alpha ? engine_color_alpha_to_fixed(alpha*src_alpha) : alpha_fixed;
+                        active_screen_buffer[dest_offset] = shader->execute_fixed(active_screen_buffer[dest_offset], src_color, pixel_alpha, shader);
                     }
                 }
 
                 // While in row, keep traversing about rotation
-                x += cos_angle_inv_scaled;
-                y -= sin_angle_inv_scaled;
+                x += cos_angle_inv_scaled_fixed;
+                y -= sin_angle_inv_scaled_fixed;
 
                 // Go to next pixel next time to set it
                 dest_offset += 1;
@@ -234,6 +419,23 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
 
 
 void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, uint16_t depth, engine_shader_t *shader){
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_BLIT_DEPTH, alpha, shader);
+        command->blit.texture = texture;
+        command->blit.offset = offset;
+        command->blit.center_x = center_x;
+        command->blit.center_y = center_y;
+        command->blit.window_width = window_width;
+        command->blit.window_height = window_height;
+        command->blit.pixels_stride = pixels_stride;
+        command->blit.x_scale = x_scale;
+        command->blit.y_scale = y_scale;
+        command->blit.rotation_radians = rotation_radians;
+        command->blit.transparent_color = transparent_color;
+        command->blit.depth = depth;
+        return;
+    }
+
     /*  https://cohost.org/tomforsyth/post/891823-rotation-with-three#:~:text=But%20the%20TL%3BDR%20is%20you%20do%20three%20shears%3A
         https://stackoverflow.com/questions/65909025/rotating-a-bitmap-with-3-shears    Lots of inspiration from here
         https://computergraphics.stackexchange.com/questions/10599/rotate-a-bitmap-with-shearing
@@ -254,6 +456,15 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
         The displacements are performed twice on the x-axis and once on the y axis in x y x order.
     */
 
+    if(rotation_radians == 0.0f && x_scale == 1.0f && y_scale == 1.0f){
+        engine_draw_blit_axis_aligned(texture, offset, center_x, center_y, window_width, window_height, pixels_stride, transparent_color, alpha, true, depth, shader);
+        return;
+    }
+
+    // Opacity is blended as a 0 ~ 32 integer, only textures with
+    // an alpha channel need it combined per pixel
+    uint8_t alpha_fixed = engine_color_alpha_to_fixed(alpha);
+
     // ENGINE_PERFORMANCE_CYCLES_START();
     float inverse_x_scale = 1.0f / x_scale;
     float inverse_y_scale = 1.0f / y_scale;
@@ -265,6 +476,8 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
     // Used to traverse about rotation
     float sin_angle_inv_scaled = sin_angle * inverse_y_scale;
     float cos_angle_inv_scaled = cos_angle * inverse_x_scale;
+    int32_t sin_angle_inv_scaled_fixed = ENGINE_FLOAT_TO_FIXED(sin_angle_inv_scaled);
+    int32_t cos_angle_inv_scaled_fixed = ENGINE_FLOAT_TO_FIXED(cos_angle_inv_scaled);
 
     // Controls the scale of the destination rectangle,
     // which in turn defines the total scale of the bitmap
@@ -312,6 +525,9 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
     // by the amount we are left clipping the dest rect
     uint32_t next_dest_row_offset = SCREEN_WIDTH - dim + i_start;
 
+    // Everything drawn lands somewhere in the clipped destination square
+    engine_display_damage_rect(top_left_x+i_start, top_left_y+j_start, top_left_x+dim, top_left_y+dim);
+
     int32_t i, j;
 
     // Start from clipped top and go until max destination rectangle
@@ -326,9 +542,9 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
 
         // Calculate the location of the SRC pixel. If the destination
         // gets scaled larger then we need to inversely scale into the
-        // src, and vice versa
-        float x = (half_scaled_window_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale;
-        float y = (half_scaled_window_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale;
+        // src, and vice versa. Traversed in 16.16 fixed-point
+        int32_t x = ENGINE_FLOAT_TO_FIXED((half_scaled_window_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale);
+        int32_t y = ENGINE_FLOAT_TO_FIXED((half_scaled_window_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale);
 
         for(i=i_start; i<dim; i++){
             // Check if drawing to draw out of bounds to the right,
@@ -340,13 +556,13 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
                 // screen_buffer[dest_offset] = 0b11111000000000;
 
                 // Floor these otherwise get artifacts (don't exactly know why).
-                // Floor + int seems to be faster than comparing floats
-                int32_t rotX = (int32_t)floorf(x);
-                int32_t rotY = (int32_t)floorf(y);
+                // The fixed-point shift floors without any float work
+                int32_t rotX = ENGINE_FIXED_TO_INT(x);
+                int32_t rotY = ENGINE_FIXED_TO_INT(y);
 
                 // If statements are expensive! Don't need to check if withing screen
                 // bounds since those dimensions are clipped (destination rect)
-                if((rotX >= 0 && rotX < window_width) && (rotY >= 0 && rotY < window_height)){
+                if((uint32_t)rotX < (uint32_t)window_width && (uint32_t)rotY < (uint32_t)window_height){
                     uint32_t src_offset = rotY * pixels_stride + rotX;
                     // uint16_t src_color = pixels[src_offset];
                     float src_alpha = 1.0f;
@@ -354,14 +570,15 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
 
                     if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
                         if(engine_display_store_check_depth_index(dest_offset, depth)){
-                            active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], src_color, alpha*src_alpha, shader);
+                            uint8_t pixel_alpha = texture->has_alpha ? engine_color_alpha_to_fixed(alpha*src_alpha) : alpha_fixed;
+                            active_screen_buffer[dest_offset] = shader->execute_fixed(active_screen_buffer[dest_offset], src_color, pixel_alpha, shader);
                         }
                     }
                 }
 
                 // While in row, keep traversing about rotation
-                x += cos_angle_inv_scaled;
-                y -= sin_angle_inv_scaled;
+                x += cos_angle_inv_scaled_fixed;
+                y -= sin_angle_inv_scaled_fixed;
 
                 // Go to next pixel next time to set it
                 dest_offset += 1;
@@ -384,6 +601,19 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
 
 
 void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t width, int32_t height, float x_scale, float y_scale, float rotation_radians, float alpha, engine_shader_t *shader){
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_RECT, alpha, shader);
+        command->rect.color = color;
+        command->rect.center_x = center_x;
+        command->rect.center_y = center_y;
+        command->rect.width = width;
+        command->rect.height = height;
+        command->rect.x_scale = x_scale;
+        command->rect.y_scale = y_scale;
+        command->rect.rotation_radians = rotation_radians;
+        return;
+    }
+
     /*  https://cohost.org/tomforsyth/post/891823-rotation-with-three#:~:text=But%20the%20TL%3BDR%20is%20you%20do%20three%20shears%3A
         https://stackoverflow.com/questions/65909025/rotating-a-bitmap-with-3-shears    Lots of inspiration from here
         https://computergraphics.stackexchange.com/questions/10599/rotate-a-bitmap-with-shearing
@@ -404,7 +634,26 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
         The displacements are performed twice on the x-axis and once on the y axis in x y x order.
     */
 
+    // Unrotated and unscaled rectangles are just a stack of spans
+    if(rotation_radians == 0.0f && x_scale == 1.0f && y_scale == 1.0f){
+        int32_t origin_x, origin_y;
+        engine_draw_axis_aligned_origin(center_x, center_y, width, height, &origin_x, &origin_y);
+
+        // Spans clip horizontally on their own
+        int32_t dest_x_start = origin_x;
+        int32_t dest_y_start = max(origin_y, 0);
+        int32_t dest_x_end = origin_x + width;
+        int32_t dest_y_end = min(origin_y + height, SCREEN_HEIGHT);
+
+        for(int32_t dest_y=dest_y_start; dest_y<dest_y_end; dest_y++){
+            engine_draw_hspan(color, dest_x_start, dest_x_end, dest_y, alpha, shader);
+        }
+
+        return;
+    }
+
     // ENGINE_PERFORMANCE_CYCLES_START();
+    uint8_t alpha_fixed = engine_color_alpha_to_fixed(alpha);
     float inverse_x_scale = 1.0f / x_scale;
     float inverse_y_scale = 1.0f / y_scale;
     
@@ -415,6 +664,8 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
     // Used to traverse about rotation
     float sin_angle_inv_scaled = sin_angle * inverse_y_scale;
     float cos_angle_inv_scaled = cos_angle * inverse_x_scale;
+    int32_t sin_angle_inv_scaled_fixed = ENGINE_FLOAT_TO_FIXED(sin_angle_inv_scaled);
+    int32_t cos_angle_inv_scaled_fixed = ENGINE_FLOAT_TO_FIXED(cos_angle_inv_scaled);
 
     // Controls the scale of the destination rectangle,
     // which in turn defines the total scale of the bitmap
@@ -462,6 +713,9 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
     // by the amount we are left clipping the dest rect
     uint32_t next_dest_row_offset = SCREEN_WIDTH - dim + i_start;
 
+    // Everything drawn lands somewhere in the clipped destination square
+    engine_display_damage_rect(top_left_x+i_start, top_left_y+j_start, top_left_x+dim, top_left_y+dim);
+
     int32_t i, j;
 
     // Start from clipped top and go until max destination rectangle
@@ -476,9 +730,9 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
 
         // Calculate the location of the SRC pixel. If the destination
         // gets scaled larger then we need to inversely scale into the
-        // src, and vice versa
-        float x = (half_scaled_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale;
-        float y = (half_scaled_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale;
+        // src, and vice versa. Traversed in 16.16 fixed-point
+        int32_t x = ENGINE_FLOAT_TO_FIXED((half_scaled_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale);
+        int32_t y = ENGINE_FLOAT_TO_FIXED((half_scaled_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale);
 
         for(i=i_start; i<dim; i++){
             // Check if drawing to draw out of bounds to the right,
@@ -490,19 +744,19 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
                 // screen_buffer[dest_offset] = 0b11111000000000;
 
                 // Floor these otherwise get artifacts (don't exactly know why).
-                // Floor + int seems to be faster than comparing floats
-                int32_t rotX = (int32_t)floorf(x);
-                int32_t rotY = (int32_t)floorf(y);
+                // The fixed-point shift floors without any float work
+                int32_t rotX = ENGINE_FIXED_TO_INT(x);
+                int32_t rotY = ENGINE_FIXED_TO_INT(y);
 
                 // If statements are expensive! Don't need to check if withing screen
                 // bounds since those dimensions are clipped (destination rect)
-                if((rotX >= 0 && rotX < width) && (rotY >= 0 && rotY < height)){
-                    active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], color, alpha, shader);
+                if((uint32_t)rotX < (uint32_t)width && (uint32_t)rotY < (uint32_t)height){
+                    active_screen_buffer[dest_offset] = shader->execute_fixed(active_screen_buffer[dest_offset], color, alpha_fixed, shader);
                 }
 
                 // While in row, keep traversing about rotation
-                x += cos_angle_inv_scaled;
-                y -= sin_angle_inv_scaled;
+                x += cos_angle_inv_scaled_fixed;
+                y -= sin_angle_inv_scaled_fixed;
 
                 // Go to next pixel next time to set it
                 dest_offset += 1;
@@ -524,58 +778,121 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
 }
 
 
+// https://en.wikipedia.org/wiki/Midpoint_circle_algorithm
 void engine_draw_outline_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader){
-    // https://stackoverflow.com/a/58629898
-    float distance = radius;
-    float angle_increment = acosf(1 - 1/distance) * 2.0f;   // Multiply by 2.0 since care about speed and not accuracy as much
-
-    for(float angle = 0; angle <= 90; angle += angle_increment){
-        float cx = distance * cosf(angle);
-        float cy = distance * sinf(angle);
-        
-        // Bottom right quadrant of the circle
-        int brx = (int)(center_x+cx);
-        int bry = (int)(center_y+cy);
-
-        // Bottom left quadrant of the circle
-        int blx = (int)(center_x-cx);
-        int bly = (int)(center_y+cy);
-
-        // Top right quadrant of the circle
-        int trx = (int)(center_x+cx);
-        int try = (int)(center_y-cy);
-
-        // Top left quadrant of the circle
-        int tlx = (int)(center_x-cx);
-        int tly = (int)(center_y-cy);
-
-        engine_draw_pixel(color, brx, bry, alpha, shader);
-        engine_draw_pixel(color, blx, bly, alpha, shader);
-        engine_draw_pixel(color, trx, try, alpha, shader);
-        engine_draw_pixel(color, tlx, tly, alpha, shader);
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_OUTLINE_CIRCLE, alpha, shader);
+        command->circle.color = color;
+        command->circle.center_x = center_x;
+        command->circle.center_y = center_y;
+        command->circle.radius = radius;
+        return;
+    }
+
+    int32_t cx = (int32_t)center_x;
+    int32_t cy = (int32_t)center_y;
+    int32_t x = (int32_t)radius;
+    int32_t y = 0;
+    int32_t decision = 1 - x;
+
+    // Walk one octant with integer steps and mirror it to the other
+    // seven. Points on the axes and diagonals are shared by two
+    // octants, only draw those once so alpha isn't applied twice
+    while(x >= y){
+        engine_draw_pixel(color, cx + x, cy + y, alpha, shader);
+        engine_draw_pixel(color, cx - x, cy - y, alpha, shader);
+
+        if(y != 0){
+            engine_draw_pixel(color, cx + x, cy - y, alpha, shader);
+            engine_draw_pixel(color, cx - x, cy + y, alpha, shader);
+        }
+
+        if(x != y){
+            engine_draw_pixel(color, cx + y, cy + x, alpha, shader);
+            engine_draw_pixel(color, cx - y, cy - x, alpha, shader);
+
+            if(y != 0){
+                engine_draw_pixel(color, cx - y, cy + x, alpha, shader);
+                engine_draw_pixel(color, cx + y, cy - x, alpha, shader);
+            }
+        }
+
+        y++;
+
+        if(decision < 0){
+            decision += 2 * y + 1;
+        }else{
+            x--;
+            decision += 2 * (y - x) + 1;
+        }
     }
 }
 
 
+// https://en.wikipedia.org/wiki/Midpoint_circle_algorithm
 void engine_draw_filled_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader){
-    float radius_sqr = radius * radius;
-    int x_min = (int)(-radius);
-    int x_max = (int)radius;
-
-    // https://stackoverflow.com/a/59211338
-    for(int x=x_min; x<x_max; x++){
-        int hh = (int)sqrt(radius_sqr - x * x);
-        int rx = (int)center_x + x;
-        int ph = (int)center_y + hh;
-
-        for(int y=(int)center_y-hh; y<ph; y++){
-            engine_draw_pixel(color, rx, y, alpha, shader);
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_FILLED_CIRCLE, alpha, shader);
+        command->circle.color = color;
+        command->circle.center_x = center_x;
+        command->circle.center_y = center_y;
+        command->circle.radius = radius;
+        return;
+    }
+
+    int32_t cx = (int32_t)center_x;
+    int32_t cy = (int32_t)center_y;
+    int32_t x = (int32_t)radius;
+    int32_t y = 0;
+    int32_t decision = 1 - x;
+
+    // Same walk as the outline but each step fills the rows the
+    // octant points are on. Every row must only be filled once,
+    // otherwise translucent circles get darker bands
+    while(x >= y){
+        // Rows `cy +/- y` advance every step, x is the widest here
+        engine_draw_hspan(color, cx - x, cx + x + 1, cy + y, alpha, shader);
+
+        if(y != 0){
+            engine_draw_hspan(color, cx - x, cx + x + 1, cy - y, alpha, shader);
+        }
+
+        y++;
+
+        if(decision < 0){
+            decision += 2 * y + 1;
+        }else{
+            // Rows `cy +/- x` are only done once x is about to
+            // change (widest they get) and if not already filled above
+            if(x >= y){
+                engine_draw_hspan(color, cx - (y-1), cx + (y-1) + 1, cy + x, alpha, shader);
+                engine_draw_hspan(color, cx - (y-1), cx + (y-1) + 1, cy - x, alpha, shader);
+            }
+
+            x--;
+            decision += 2 * (y - x) + 1;
         }
     }
 }
 
 
 void engine_draw_text(font_resource_class_obj_t *font, mp_obj_t text, float center_x, float center_y, float text_box_width, float text_box_height, float letter_spacing, float line_spacing, float x_scale, float y_scale, float rotation_radians, float alpha, engine_shader_t *shader){    
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_TEXT, alpha, shader);
+        command->text.font = font;
+        command->text.text = text;
+        command->text.center_x = center_x;
+        command->text.center_y = center_y;
+        command->text.text_box_width = text_box_width;
+        command->text.text_box_height = text_box_height;
+        command->text.letter_spacing = letter_spacing;
+        command->text.line_spacing = line_spacing;
+        command->text.x_scale = x_scale;
+        command->text.y_scale = y_scale;
+        command->text.rotation_radians = rotation_radians;
+        return;
+    }
+
     float sin_angle = sinf(rotation_radians);
     float cos_angle = cosf(rotation_radians);
 
@@ -687,61 +1004,187 @@ float edge_function(float x0, float y0, float x1, float y1, float x2, float y2){
 
 // https://fgiesen.wordpress.com/2013/02/08/triangle-rasterization-in-practice/#:~:text=trivial%20to%20traverse.-,This%20gives%3A,-void%20drawTri(const
 // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=In%20our%20basic%20triangle%20rasterization%20loop
+// Scanline triangle fill. Pixel centers are sampled at +0.5 and spans are
+// half-open so triangles sharing an edge don't draw it twice
 void engine_draw_filled_triangle(uint16_t color, float x0, float y0, float x1, float y1, float x2, float y2, float alpha, engine_shader_t *shader){
-    // // Triangle setup
-    // int16_t A01 = (int16_t)(y0 - y1), B01 = (int16_t)(x1 - x0);
-    // int16_t A12 = (int16_t)(y1 - y2), B12 = (int16_t)(x2 - x1);
-    // int16_t A20 = (int16_t)(y2 - y0), B20 = (int16_t)(x0 - x2);
-
-    // // Compute triangle bounding box
-    // int16_t minX = (int16_t)min3(x0, x1, x2);
-    // int16_t minY = (int16_t)min3(y0, y1, y2);
-    // int16_t maxX = (int16_t)max3(x0, x1, x2);
-    // int16_t maxY = (int16_t)max3(y0, y1, y2);
-
-    // // Clip against screen bounds
-    // minX = max(minX, 0);
-    // minY = max(minY, 0);
-    // maxX = min(maxX, SCREEN_WIDTH_MINUS_1);
-    // maxY = min(maxY, SCREEN_HEIGHT_MINUS_1);
-
-    // int16_t px = minX;
-    // int16_t py = minY;
-
-    // int16_t w0_row = (int16_t)orient2d(x1, y1, x2, y2, px, py);
-    // int16_t w1_row = (int16_t)orient2d(x2, y2, x0, y0, px, py);
-    // int16_t w2_row = (int16_t)orient2d(x0, y0, x1, y1, px, py);
-
-    // // Rasterize
-    // for(py = minY; py <= maxY; py++){
-    //     // Barycentric coordinates at start of row
-    //     int16_t w0 = w0_row;
-    //     int16_t w1 = w1_row;
-    //     int16_t w2 = w2_row;
-
-    //     for(px = minX; px <= maxX; px++){
-    //         // If p is on or inside all edges, render pixel.
-    //         // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=if%20((w0%20%7C%20w1%20%7C%20w2)%20%3E%3D%200)
-    //         if ((w0 | w1 | w2) >= 0){
-    //             // if(engine_display_store_check_depth(px, py, depth)){
-    //                 engine_draw_pixel_no_check(color, px, py, alpha, shader);
-    //             // }
-    //         }
-
-    //         // One step to the right
-    //         w0 += A12;
-    //         w1 += A20;
-    //         w2 += A01;
-    //     }
-
-    //     // One row step
-    //     w0_row += B12;
-    //     w1_row += B20;
-    //     w2_row += B01;
-    // }
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_FILLED_TRIANGLE, alpha, shader);
+        command->triangle.color = color;
+        command->triangle.ax = x0;
+        command->triangle.ay = y0;
+        command->triangle.bx = x1;
+        command->triangle.by = y1;
+        command->triangle.cx = x2;
+        command->triangle.cy = y2;
+        return;
+    }
+
+    float temp;
+
+    // Sort vertices by y so that 0 is the top and 2 is the bottom
+    if(y1 < y0){ temp = x0; x0 = x1; x1 = temp; temp = y0; y0 = y1; y1 = temp; }
+    if(y2 < y0){ temp = x0; x0 = x2; x2 = temp; temp = y0; y0 = y2; y2 = temp; }
+    if(y2 < y1){ temp = x1; x1 = x2; x2 = temp; temp = y1; y1 = y2; y2 = temp; }
+
+    // Flat, nothing to fill
+    if(y2 - y0 <= 0.0f){
+        return;
+    }
+
+    int32_t row_start = max((int32_t)ceilf(y0 - 0.5f), 0);
+    int32_t row_middle = (int32_t)ceilf(y1 - 0.5f);
+    int32_t row_end = min((int32_t)ceilf(y2 - 0.5f), SCREEN_HEIGHT);
+
+    // Inverse slopes (x change per row) of the long edge (0 -> 2)
+    // and the two short edges (0 -> 1 and 1 -> 2)
+    float long_slope = (x2 - x0) / (y2 - y0);
+    float top_slope = (y1 - y0) > 0.0f ? (x1 - x0) / (y1 - y0) : 0.0f;
+    float bottom_slope = (y2 - y1) > 0.0f ? (x2 - x1) / (y2 - y1) : 0.0f;
+
+    for(int32_t row=row_start; row<row_end; row++){
+        float sample_y = row + 0.5f;
+
+        float long_x = x0 + (sample_y - y0) * long_slope;
+        float short_x;
+
+        if(row < row_middle){
+            short_x = x0 + (sample_y - y0) * top_slope;
+        }else{
+            short_x = x1 + (sample_y - y1) * bottom_slope;
+        }
+
+        int32_t span_start = (int32_t)ceilf(min(long_x, short_x) - 0.5f);
+        int32_t span_end = (int32_t)ceilf(max(long_x, short_x) - 0.5f);
+
+        engine_draw_hspan(color, span_start, span_end, row, alpha, shader);
+    }
+}
+
+
+// Triangle vertices are snapped to 28.4 fixed-point so that edge functions can
+// be stepped with integer adds. Edge values are kept in 64-bits since vertices
+// of triangles close to the camera can land far outside the screen
+#define ENGINE_RASTER_SUBPIXEL_BITS 4
+#define ENGINE_RASTER_SUBPIXEL_ONE  (1 << ENGINE_RASTER_SUBPIXEL_BITS)
+
+// Size of the square blocks of pixels that are accepted or
+// rejected as a whole before looking at individual pixels
+#define ENGINE_RASTER_BLOCK_SIZE    8
+
+
+typedef struct{
+    int64_t origin;     // Value at the pixel center of the bounding box top-left
+    int64_t step_x;     // Change in value for one pixel to the right
+    int64_t step_y;     // Change in value for one pixel down
+}engine_raster_edge_t;
+
+
+typedef struct{
+    float origin;
+    float step_x;
+    float step_y;
+}engine_raster_plane_t;
+
+
+// https://fgiesen.wordpress.com/2013/02/08/triangle-rasterization-in-practice/
+// Sets up the edge function for the edge going from 0 to 1, all in 28.4 fixed-point.
+// Pixels exactly on an edge are only drawn if it is a top or left edge so that
+// triangles sharing an edge never both draw it
+static inline void engine_raster_edge_setup(engine_raster_edge_t *edge, int64_t x0, int64_t y0, int64_t x1, int64_t y1, int64_t origin_x, int64_t origin_y){
+    // Triangles are clockwise on screen (y-down) when not culled, left edges
+    // go up and top edges are horizontal going right
+    bool top_left = (y1 < y0) || (y1 == y0 && x1 > x0);
+
+    edge->origin = (x1 - x0) * (origin_y - y0) - (y1 - y0) * (origin_x - x0);
+    edge->step_x = (y0 - y1) * ENGINE_RASTER_SUBPIXEL_ONE;
+    edge->step_y = (x1 - x0) * ENGINE_RASTER_SUBPIXEL_ONE;
+
+    // Pushing non top-left edges in by one unit makes
+    // a `>= 0` test exclude pixels exactly on them
+    if(top_left == false){
+        edge->origin -= 1;
+    }
+}
+
+
+// Sets up an attribute that varies linearly in screen space over the triangle
+// from its per-vertex values and the barycentric gradients of the triangle
+static inline void engine_raster_plane_setup(engine_raster_plane_t *plane, float qa, float qb, float qc, float *l_origin, float *l_step_x, float *l_step_y){
+    plane->origin = qa*l_origin[0] + qb*l_origin[1] + qc*l_origin[2];
+    plane->step_x = qa*l_step_x[0] + qb*l_step_x[1] + qc*l_step_x[2];
+    plane->step_y = qa*l_step_y[0] + qb*l_step_y[1] + qc*l_step_y[2];
 }
 
 
+static inline float engine_raster_plane_at(engine_raster_plane_t *plane, int32_t rel_x, int32_t rel_y){
+    return plane->origin + plane->step_x * rel_x + plane->step_y * rel_y;
+}
+
+
+// Draws a run of covered pixels on one row. Depth is linear in screen space and
+// stepped in 24.8 fixed-point. UVs are made perspective correct at both ends of the
+// span and stepped linearly in 16.16 fixed-point between them, spans are at most a
+// block wide so the error from not dividing per-pixel stays small
+static void engine_raster_depth_span(texture_resource_class_obj_t *texture, int32_t x_start, int32_t x_end, int32_t y, int32_t origin_x, int32_t origin_y,
+                                     engine_raster_plane_t *depth_plane, engine_raster_plane_t *inv_w_plane, engine_raster_plane_t *u_plane, engine_raster_plane_t *v_plane,
+                                     float alpha, engine_shader_t *shader){
+    int32_t rel_y = y - origin_y;
+    int32_t rel_x_start = x_start - origin_x;
+    int32_t rel_x_end = x_end - origin_x;
+    int32_t count = x_end - x_start;
+
+    float inv_w_start = engine_raster_plane_at(inv_w_plane, rel_x_start, rel_y);
+    float inv_w_end = engine_raster_plane_at(inv_w_plane, rel_x_end, rel_y);
+
+    float u_start = engine_raster_plane_at(u_plane, rel_x_start, rel_y) / inv_w_start;
+    float v_start = engine_raster_plane_at(v_plane, rel_x_start, rel_y) / inv_w_start;
+    float u_end = engine_raster_plane_at(u_plane, rel_x_end, rel_y) / inv_w_end;
+    float v_end = engine_raster_plane_at(v_plane, rel_x_end, rel_y) / inv_w_end;
+
+    float inverse_count = (count > 0) ? 1.0f / count : 0.0f;
+
+    int32_t u = ENGINE_FLOAT_TO_FIXED(u_start);
+    int32_t v = ENGINE_FLOAT_TO_FIXED(v_start);
+    int32_t u_step = ENGINE_FLOAT_TO_FIXED((u_end - u_start) * inverse_count);
+    int32_t v_step = ENGINE_FLOAT_TO_FIXED((v_end - v_start) * inverse_count);
+
+    int32_t depth = (int32_t)(engine_raster_plane_at(depth_plane, rel_x_start, rel_y) * 256.0f);
+    int32_t depth_step = (int32_t)(depth_plane->step_x * 256.0f);
+
+    int32_t texture_width = texture->width;
+    int32_t texture_height = texture->height;
+    uint16_t (*get_pixel)(struct texture_resource_class_obj_t *texture, uint32_t offset, float *out_alpha) = texture->get_pixel;
+    bool has_alpha = texture->has_alpha;
+    uint8_t alpha_fixed = engine_color_alpha_to_fixed(alpha);
+
+    uint16_t dest_offset = y * SCREEN_WIDTH + x_start;
+
+    engine_display_damage_span(y, x_start, x_end+1);
+
+    for(int32_t x=x_start; x<=x_end; x++){
+        if(engine_display_store_check_depth_index(dest_offset, (uint16_t)(depth >> 8))){
+            // Clamp so that UVs slightly outside the
+            // texture from rounding don't read past it
+            int32_t tu = min(max(ENGINE_FIXED_TO_INT(u), 0), texture_width-1);
+            int32_t tv = min(max(ENGINE_FIXED_TO_INT(v), 0), texture_height-1);
+
+            float texture_pixel_alpha = 1.0f;
+            uint16_t texture_pixel_color = get_pixel(texture, tv * texture_width + tu, &texture_pixel_alpha);
+            uint8_t pixel_alpha = has_alpha ? engine_color_alpha_to_fixed(alpha*texture_pixel_alpha) : alpha_fixed;
+
+            active_screen_buffer[dest_offset] = shader->execute_fixed(active_screen_buffer[dest_offset], texture_pixel_color, pixel_alpha, shader);
+        }
+
+        u += u_step;
+        v += v_step;
+        depth += depth_step;
+        dest_offset++;
+    }
+}
+
+
+// https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/
+// https://fgiesen.wordpress.com/2011/07/06/a-trip-through-the-graphics-pipeline-2011-part-6/ (block traversal)
 void engine_draw_filled_triangle_depth(texture_resource_class_obj_t *texture, uint16_t color,
                                        float ax, float ay, uint16_t depth_az, float au, float av,
                                        float bx, float by, uint16_t depth_bz, float bu, float bv,
@@ -760,118 +1203,164 @@ void engine_draw_filled_triangle_depth(texture_resource_class_obj_t *texture, ui
         return;
     }
 
-    // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=the%20triangle%27s%20vertices
-    // Compute triangle bounding box. Each pixel in this box will be
-    // determined to be inside or outside of the triangle
-    int32_t min_x = (int32_t)min3(ax, bx, cx);
-    int32_t min_y = (int32_t)min3(ay, by, cy);
-    int32_t max_x = (int32_t)max3(ax, bx, cx);
-    int32_t max_y = (int32_t)max3(ay, by, cy);
-
-    // Clip against screen bounds (added this). Don't want to
-    // check if pixels are inside the triangle if not visible
-    min_x = max(min_x, 0);
-    min_y = max(min_y, 0);
-    max_x = min(max_x, SCREEN_WIDTH_MINUS_1);
-    max_y = min(max_y, SCREEN_HEIGHT_MINUS_1);
-
-    // Start at the minimum x and y corner of the triangle view box
-    int16_t px = (int16_t)min_x;
-    int16_t py = (int16_t)min_y;
-
-    // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=this%20triangle%0A%7D-,Back%20to%20business,-So%2C%20why%20is
-    // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=In%20our%20basic%20triangle%20rasterization%20loop
-    // Calculate our edge functions. If (px, py) is on the
-    // right side of all of the edges, each of these will
-    // be a positive number
-    float BCP_ROW = edge_function(bx, by, cx, cy, px, py) / ABC;
-    float CAP_ROW = edge_function(cx, cy, ax, ay, px, py) / ABC;
-    float ABP_ROW = edge_function(ax, ay, bx, by, px, py) / ABC;
-
-    // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=In%20our%20basic%20triangle%20rasterization%20loop
-    float dy_bc = (float)(by - cy) / ABC;
-    float dx_bc = (float)(cx - bx) / ABC;
-    
-    float dy_ca = (float)(cy - ay) / ABC;
-    float dx_ca = (float)(ax - cx) / ABC;
-
-    float dy_ab = (float)(ay - by) / ABC;
-    float dx_ab = (float)(bx - ax) / ABC;
-
-
-    // Go through all pixels in triangle view box and check if each
-    // point is inside or outside the triangle inside the box
-    for(py=min_y; py<=max_y; py++){
-        // Barycentric coordinates at start of row
-        float BCP = BCP_ROW;
-        float CAP = CAP_ROW;
-        float ABP = ABP_ROW;
-
-        for(px=min_x; px<=max_x; px++){
-
-            // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=get%20the%20interpolated%20colour
-            // BCP + CAP + ABP = 1.0
-            uint16_t depth_p = (uint16_t)((float)depth_az*BCP + (float)depth_bz*CAP + (float)depth_cz*ABP);
-
-            // Check that the pixel is on the right side of each
-            // edge for all the edge functions calculated. Instead of
-            // comparing directly to 0.0, make sure triangles get filled
-            // by comparing to numbers above some small negative number
-            if((ABP >= -0.001f && BCP >= -0.001f && CAP >= -0.001f) && engine_display_store_check_depth(px, py, depth_p)){
-
-                // https://stackoverflow.com/questions/12360023/barycentric-coordinates-texture-mapping
-                // https://computergraphics.stackexchange.com/a/4091
-                // https://www.reddit.com/r/opengl/comments/49fdhc/comment/d0rlh12/
-                // https://web.archive.org/web/20240416044207/https://www.scratchapixel.com/lessons/3d-basic-rendering/rasterization-practical-implementation/perspective-correct-interpolation-vertex-attributes.html
-                float w = BCP/w0 + CAP/w1 + ABP/w2;
+    // Culled triangles are never recorded
+    if(engine_draw_commands_recording()){
+        engine_draw_command_t *command = engine_draw_commands_push(ENGINE_DRAW_COMMAND_FILLED_TRIANGLE_DEPTH, alpha, shader);
+        command->triangle.texture = texture;
+        command->triangle.color = color;
+        command->triangle.ax = ax;
+        command->triangle.ay = ay;
+        command->triangle.depth_az = depth_az;
+        command->triangle.au = au;
+        command->triangle.av = av;
+        command->triangle.bx = bx;
+        command->triangle.by = by;
+        command->triangle.depth_bz = depth_bz;
+        command->triangle.bu = bu;
+        command->triangle.bv = bv;
+        command->triangle.cx = cx;
+        command->triangle.cy = cy;
+        command->triangle.depth_cz = depth_cz;
+        command->triangle.cu = cu;
+        command->triangle.cv = cv;
+        command->triangle.w0 = w0;
+        command->triangle.w1 = w1;
+        command->triangle.w2 = w2;
+        return;
+    }
 
-                uint16_t u = (uint16_t)((BCP*au/w0 + CAP*bu/w1 + ABP*cu/w2) / w);
-                uint16_t v = (uint16_t)((BCP*av/w0 + CAP*bv/w1 + ABP*cv/w2) / w);
+    // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=the%20triangle%27s%20vertices
+    // Compute triangle bounding box clipped to the screen. Each
+    // pixel in this box may be inside or outside of the triangle
+    int32_t min_x = max((int32_t)floorf(min3(ax, bx, cx)), 0);
+    int32_t min_y = max((int32_t)floorf(min3(ay, by, cy)), 0);
+    int32_t max_x = min((int32_t)ceilf(max3(ax, bx, cx)), SCREEN_WIDTH_MINUS_1);
+    int32_t max_y = min((int32_t)ceilf(max3(ay, by, cy)), SCREEN_HEIGHT_MINUS_1);
+
+    if(min_x > max_x || min_y > max_y){
+        return;
+    }
 
-                // // https://computergraphics.stackexchange.com/questions/4079/perspective-correct-texture-mapping
-                // float tau = au / w0;
-                // float tav = av / w0;
-                // float tinvw0 = 1.0f / w0;
+    // Snap vertices to 28.4 fixed-point
+    int64_t fax = (int64_t)floorf(ax * ENGINE_RASTER_SUBPIXEL_ONE + 0.5f);
+    int64_t fay = (int64_t)floorf(ay * ENGINE_RASTER_SUBPIXEL_ONE + 0.5f);
+    int64_t fbx = (int64_t)floorf(bx * ENGINE_RASTER_SUBPIXEL_ONE + 0.5f);
+    int64_t fby = (int64_t)floorf(by * ENGINE_RASTER_SUBPIXEL_ONE + 0.5f);
+    int64_t fcx = (int64_t)floorf(cx * ENGINE_RASTER_SUBPIXEL_ONE + 0.5f);
+    int64_t fcy = (int64_t)floorf(cy * ENGINE_RASTER_SUBPIXEL_ONE + 0.5f);
+
+    // Everything is relative to the center of the top-left bounding box pixel
+    int64_t origin_fx = (int64_t)min_x * ENGINE_RASTER_SUBPIXEL_ONE + ENGINE_RASTER_SUBPIXEL_ONE / 2;
+    int64_t origin_fy = (int64_t)min_y * ENGINE_RASTER_SUBPIXEL_ONE + ENGINE_RASTER_SUBPIXEL_ONE / 2;
+
+    engine_raster_edge_t edges[3];
+    engine_raster_edge_setup(&edges[0], fbx, fby, fcx, fcy, origin_fx, origin_fy);     // BC
+    engine_raster_edge_setup(&edges[1], fcx, fcy, fax, fay, origin_fx, origin_fy);     // CA
+    engine_raster_edge_setup(&edges[2], fax, fay, fbx, fby, origin_fx, origin_fy);     // AB
+
+    // Barycentric coordinates at the origin and how they change per pixel.
+    // These are only used for interpolating attributes, coverage is decided
+    // by the fixed-point edges above
+    float origin_x = min_x + 0.5f;
+    float origin_y = min_y + 0.5f;
+
+    float l_origin[3] = {edge_function(bx, by, cx, cy, origin_x, origin_y) / ABC,
+                         edge_function(cx, cy, ax, ay, origin_x, origin_y) / ABC,
+                         edge_function(ax, ay, bx, by, origin_x, origin_y) / ABC};
+    float l_step_x[3] = {(by - cy) / ABC, (cy - ay) / ABC, (ay - by) / ABC};
+    float l_step_y[3] = {(cx - bx) / ABC, (ax - cx) / ABC, (bx - ax) / ABC};
+
+    // https://web.archive.org/web/20240416044207/https://www.scratchapixel.com/lessons/3d-basic-rendering/rasterization-practical-implementation/perspective-correct-interpolation-vertex-attributes.html
+    // Depth, 1/w, u/w and v/w all vary linearly in screen space
+    float inv_w0 = 1.0f / w0;
+    float inv_w1 = 1.0f / w1;
+    float inv_w2 = 1.0f / w2;
+
+    engine_raster_plane_t depth_plane;
+    engine_raster_plane_t inv_w_plane;
+    engine_raster_plane_t u_plane;
+    engine_raster_plane_t v_plane;
+    engine_raster_plane_setup(&depth_plane, (float)depth_az, (float)depth_bz, (float)depth_cz, l_origin, l_step_x, l_step_y);
+    engine_raster_plane_setup(&inv_w_plane, inv_w0, inv_w1, inv_w2, l_origin, l_step_x, l_step_y);
+    engine_raster_plane_setup(&u_plane, au*inv_w0, bu*inv_w1, cu*inv_w2, l_origin, l_step_x, l_step_y);
+    engine_raster_plane_setup(&v_plane, av*inv_w0, bv*inv_w1, cv*inv_w2, l_origin, l_step_x, l_step_y);
+
+    const int32_t block_last = ENGINE_RASTER_BLOCK_SIZE - 1;
+
+    // Walk the bounding box in blocks aligned to the screen
+    for(int32_t block_y=min_y & ~block_last; block_y<=max_y; block_y+=ENGINE_RASTER_BLOCK_SIZE){
+        for(int32_t block_x=min_x & ~block_last; block_x<=max_x; block_x+=ENGINE_RASTER_BLOCK_SIZE){
+            int64_t block_edges[3];
+            bool rejected = false;
+            uint8_t inside_count = 0;
+
+            // Edge functions are linear so if all four corners of the block
+            // are outside one edge, the whole block is, and if all corners
+            // are inside every edge, every pixel in the block is covered
+            for(uint8_t e=0; e<3; e++){
+                engine_raster_edge_t *edge = &edges[e];
+                int64_t top_left = edge->origin + edge->step_x * (block_x - min_x) + edge->step_y * (block_y - min_y);
+                int64_t top_right = top_left + edge->step_x * block_last;
+                int64_t bottom_left = top_left + edge->step_y * block_last;
+                int64_t bottom_right = top_right + edge->step_y * block_last;
+
+                if(top_left < 0 && top_right < 0 && bottom_left < 0 && bottom_right < 0){
+                    rejected = true;
+                    break;
+                }
 
-                // float tbu = bu / w1;
-                // float tbv = bv / w1;
-                // float tinvw1 = 1.0f / w1;
+                if(top_left >= 0 && top_right >= 0 && bottom_left >= 0 && bottom_right >= 0){
+                    inside_count++;
+                }
 
-                // float tcu = cu / w2;
-                // float tcv = cv / w2;
-                // float tinvw2 = 1.0f / w2;
+                block_edges[e] = top_left;
+            }
 
-                // // float invw = 1.0f / w;
+            if(rejected){
+                continue;
+            }
 
+            // Only the part of the block inside the bounding box
+            int32_t x_start = max(block_x, min_x);
+            int32_t x_end = min(block_x + block_last, max_x);
+            int32_t y_start = max(block_y, min_y);
+            int32_t y_end = min(block_y + block_last, max_y);
 
-                // uint16_t invw = (uint16_t)((tinvw0*BCP + tinvw1*CAP + tinvw2*ABP));
-                // uint16_t u = (uint16_t)((tau*BCP + tbu*CAP + tcu*ABP)/(1.0f/invw));
-                // uint16_t v = (uint16_t)((tav*BCP + tbv*CAP + tcv*ABP)/(1.0f/invw));
+            for(int32_t y=y_start; y<=y_end; y++){
+                if(inside_count == 3){
+                    engine_raster_depth_span(texture, x_start, x_end, y, min_x, min_y, &depth_plane, &inv_w_plane, &u_plane, &v_plane, alpha, shader);
+                    continue;
+                }
 
-                // uint16_t u = (uint16_t)((au*BCP + bu*CAP + cu*ABP));
-                // uint16_t v = (uint16_t)((av*BCP + bv*CAP + cv*ABP));
+                // Partially covered block, find the covered run in this
+                // row. Triangles are convex so the run has no gaps
+                int64_t e0 = block_edges[0] + edges[0].step_x * (x_start - block_x) + edges[0].step_y * (y - block_y);
+                int64_t e1 = block_edges[1] + edges[1].step_x * (x_start - block_x) + edges[1].step_y * (y - block_y);
+                int64_t e2 = block_edges[2] + edges[2].step_x * (x_start - block_x) + edges[2].step_y * (y - block_y);
 
-                // Get the pixel from the texture
-                uint32_t index = v * texture->width + u;
-                float texture_pixel_alpha = 0.0f;
+                int32_t span_start = -1;
+                int32_t span_end = -1;
 
-                uint16_t texture_pixel_color = texture->get_pixel(texture, index, &texture_pixel_alpha);
+                for(int32_t x=x_start; x<=x_end; x++){
+                    // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=if%20((w0%20%7C%20w1%20%7C%20w2)%20%3E%3D%200)
+                    if((e0 | e1 | e2) >= 0){
+                        if(span_start == -1){
+                            span_start = x;
+                        }
+                        span_end = x;
+                    }else if(span_start != -1){
+                        break;
+                    }
 
-                // Mix
-                alpha = alpha * texture_pixel_alpha;
+                    e0 += edges[0].step_x;
+                    e1 += edges[1].step_x;
+                    e2 += edges[2].step_x;
+                }
 
-                engine_draw_pixel_no_check(texture_pixel_color, px, py, alpha, shader);
+                if(span_start != -1){
+                    engine_raster_depth_span(texture, span_start, span_end, y, min_x, min_y, &depth_plane, &inv_w_plane, &u_plane, &v_plane, alpha, shader);
+                }
             }
-
-            // One step to the right
-            BCP += dy_bc;
-            CAP += dy_ca;
-            ABP += dy_ab;
         }
-
-        // One row step
-        BCP_ROW += dx_bc;
-        CAP_ROW += dx_ca;
-        ABP_ROW += dx_ab;
     }
 }
@@ -23,6 +23,10 @@ void ENGINE_FAST_FUNCTION(engine_draw_pixel)(uint16_t color, int32_t x, int32_t
 
 void ENGINE_FAST_FUNCTION(engine_draw_pixel_no_check)(uint16_t color, int32_t x, int32_t y, float alpha, engine_shader_t *shader);
 
+// Fills pixels `x_start` to `x_end` (exclusive) on row `y`. Clips
+// once per span rather than per pixel like `engine_draw_pixel`
+void ENGINE_FAST_FUNCTION(engine_draw_hspan)(uint16_t color, int32_t x_start, int32_t x_end, int32_t y, float alpha, engine_shader_t *shader);
+
 void engine_draw_line(uint16_t color, float x_start, float y_start, float x_end, float y_end, float alpha, engine_shader_t *shader);
 
 void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, engine_shader_t *shader);
@@ -0,0 +1,422 @@
+#include "draw/engine_draw_commands.h"
+#include "draw/engine_display_draw.h"
+#include "display/engine_display.h"
+#include "display/engine_display_common.h"
+#include "debug/debug_print.h"
+#include "py/runtime.h"
+#include <string.h>
+
+#if defined(__EMSCRIPTEN__)
+    // No threads, the "render core" runs each job right away
+#elif defined(__unix__)
+    #include <pthread.h>
+#elif defined(__arm__)
+    #include "pico/multicore.h"
+    #include "hardware/sync.h"
+#endif
+
+
+volatile bool engine_draw_commands_capturing = false;
+
+static bool enabled = false;
+static uint8_t immediate_depth = 0;
+
+// Commands are recorded into one buffer while
+// the render core draws the other one
+static engine_draw_command_t *command_buffers[2] = {NULL, NULL};
+static uint16_t command_buffer_count = 0;
+static uint8_t recording_buffer_index = 0;
+static uint16_t recorded_count = 0;
+
+// The render core was handed the end of the last frame and
+// it still needs to be sent (before touching the next frame)
+static bool frame_pending_send = false;
+
+// The active screen buffer was already cleared for the frame
+// being recorded (part of it was handed off already)
+static bool frame_prepared = false;
+
+// What the render core was last asked to draw
+static engine_draw_command_t *job_commands = NULL;
+static uint16_t job_count = 0;
+static bool job_clear = false;
+
+
+// Only ever used by the render core, the builtin shaders
+// get their program copied into this before drawing
+static engine_shader_t program_shader;
+
+
+static void engine_draw_commands_execute(engine_draw_command_t *command){
+    engine_shader_t *shader = command->shader;
+
+    if(command->program_len > 0){
+        program_shader.execute = shader->execute;
+        program_shader.execute_fixed = shader->execute_fixed;
+        program_shader.program_len = command->program_len;
+        memcpy(program_shader.program, command->program, command->program_len);
+        shader = &program_shader;
+    }
+
+    switch(command->type){
+        case ENGINE_DRAW_COMMAND_PIXEL:
+            engine_draw_pixel(command->pixel.color, command->pixel.x, command->pixel.y, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_LINE:
+            engine_draw_line(command->line.color, command->line.x_start, command->line.y_start, command->line.x_end, command->line.y_end, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_BLIT:
+            engine_draw_blit(command->blit.texture, command->blit.offset, command->blit.center_x, command->blit.center_y, command->blit.window_width, command->blit.window_height, command->blit.pixels_stride, command->blit.x_scale, command->blit.y_scale, command->blit.rotation_radians, command->blit.transparent_color, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_BLIT_DEPTH:
+            engine_draw_blit_depth(command->blit.texture, command->blit.offset, command->blit.center_x, command->blit.center_y, command->blit.window_width, command->blit.window_height, command->blit.pixels_stride, command->blit.x_scale, command->blit.y_scale, command->blit.rotation_radians, command->blit.transparent_color, command->alpha, command->blit.depth, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_RECT:
+            engine_draw_rect(command->rect.color, command->rect.center_x, command->rect.center_y, command->rect.width, command->rect.height, command->rect.x_scale, command->rect.y_scale, command->rect.rotation_radians, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_OUTLINE_CIRCLE:
+            engine_draw_outline_circle(command->circle.color, command->circle.center_x, command->circle.center_y, command->circle.radius, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_FILLED_CIRCLE:
+            engine_draw_filled_circle(command->circle.color, command->circle.center_x, command->circle.center_y, command->circle.radius, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_TEXT:
+            engine_draw_text(command->text.font, command->text.text, command->text.center_x, command->text.center_y, command->text.text_box_width, command->text.text_box_height, command->text.letter_spacing, command->text.line_spacing, command->text.x_scale, command->text.y_scale, command->text.rotation_radians, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_FILLED_TRIANGLE:
+            engine_draw_filled_triangle(command->triangle.color, command->triangle.ax, command->triangle.ay, command->triangle.bx, command->triangle.by, command->triangle.cx, command->triangle.cy, command->alpha, shader);
+        break;
+        case ENGINE_DRAW_COMMAND_FILLED_TRIANGLE_DEPTH:
+            engine_draw_filled_triangle_depth(command->triangle.texture, command->triangle.color,
+                                              command->triangle.ax, command->triangle.ay, command->triangle.depth_az, command->triangle.au, command->triangle.av,
+                                              command->triangle.bx, command->triangle.by, command->triangle.depth_bz, command->triangle.bu, command->triangle.bv,
+                                              command->triangle.cx, command->triangle.cy, command->triangle.depth_cz, command->triangle.cu, command->triangle.cv,
+                                              command->triangle.w0, command->triangle.w1, command->triangle.w2,
+                                              command->alpha, shader);
+        break;
+    }
+}
+
+
+// Runs on the render core
+static void engine_draw_commands_run_job(){
+    if(job_clear){
+        engine_display_clear();
+        engine_display_clear_depth_buffer();
+    }
+
+    for(uint16_t icx=0; icx<job_count; icx++){
+        engine_draw_commands_execute(&job_commands[icx]);
+    }
+}
+
+
+#if defined(__EMSCRIPTEN__)
+    bool engine_draw_commands_on_render_thread = false;
+
+    static void engine_draw_commands_render_core_start(){
+
+    }
+
+    static void engine_draw_commands_render_core_run(){
+        engine_draw_commands_on_render_thread = true;
+        engine_draw_commands_run_job();
+        engine_draw_commands_on_render_thread = false;
+    }
+
+    static void engine_draw_commands_render_core_wait(){
+
+    }
+#elif defined(__unix__)
+    __thread bool engine_draw_commands_on_render_thread = false;
+
+    static pthread_t render_thread;
+    static bool render_thread_started = false;
+    static pthread_mutex_t render_mutex = PTHREAD_MUTEX_INITIALIZER;
+    static pthread_cond_t render_condition = PTHREAD_COND_INITIALIZER;
+    static bool job_busy = false;
+
+    static void *engine_draw_commands_render_thread(void *arg){
+        engine_draw_commands_on_render_thread = true;
+
+        pthread_mutex_lock(&render_mutex);
+        while(true){
+            while(job_busy == false){
+                pthread_cond_wait(&render_condition, &render_mutex);
+            }
+            pthread_mutex_unlock(&render_mutex);
+
+            engine_draw_commands_run_job();
+
+            pthread_mutex_lock(&render_mutex);
+            job_busy = false;
+            pthread_cond_broadcast(&render_condition);
+        }
+
+        return NULL;
+    }
+
+    static void engine_draw_commands_render_core_start(){
+        if(render_thread_started){
+            return;
+        }
+
+        if(pthread_create(&render_thread, NULL, engine_draw_commands_render_thread, NULL) != 0){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDrawCommands: ERROR: Could not start render thread"));
+        }
+
+        render_thread_started = true;
+    }
+
+    static void engine_draw_commands_render_core_run(){
+        pthread_mutex_lock(&render_mutex);
+        job_busy = true;
+        pthread_cond_broadcast(&render_condition);
+        pthread_mutex_unlock(&render_mutex);
+    }
+
+    static void engine_draw_commands_render_core_wait(){
+        pthread_mutex_lock(&render_mutex);
+        while(job_busy){
+            pthread_cond_wait(&render_condition, &render_mutex);
+        }
+        pthread_mutex_unlock(&render_mutex);
+    }
+#elif defined(__arm__)
+    // Draw functions put a few row buffers on the stack,
+    // the default core 1 stack is a bit small for that
+    static uint32_t render_core_stack[1024];
+    static bool render_core_started = false;
+    static volatile bool job_busy = false;
+
+    // Kept in RAM so that this core can wait here while flash
+    // is erased/programmed (see `__wrap_flash_range_erase`)
+    static void __not_in_flash_func(engine_draw_commands_render_core_entry)(){
+        // Lets anything using the SDK's lockout pause this core too
+        multicore_lockout_victim_init();
+
+        while(true){
+            while(job_busy == false){
+                __wfe();
+            }
+            __dmb();
+
+            engine_draw_commands_run_job();
+
+            __dmb();
+            job_busy = false;
+            __sev();
+        }
+    }
+
+    static void engine_draw_commands_render_core_start(){
+        if(render_core_started){
+            return;
+        }
+
+        // MicroPython's `_thread` also runs on core 1 (and sets it up
+        // as a lockout victim), resetting the core would kill it
+        if(multicore_lockout_victim_is_initialized(1)){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDrawCommands: ERROR: Core 1 is already in use (by a `_thread`?), cannot start the render core on it"));
+        }
+
+        multicore_reset_core1();
+        multicore_launch_core1_with_stack(engine_draw_commands_render_core_entry, render_core_stack, sizeof(render_core_stack));
+        render_core_started = true;
+    }
+
+    static void engine_draw_commands_render_core_run(){
+        __dmb();
+        job_busy = true;
+        __sev();
+    }
+
+    static void engine_draw_commands_render_core_wait(){
+        while(job_busy){
+            __wfe();
+        }
+        __dmb();
+    }
+
+    // Every flash erase/program in the firmware goes through these
+    // (`--wrap` in `micropython.cmake`), the resource manager's and
+    // MicroPython's filesystem writes alike. The render core runs draw
+    // code from flash so it has to be done with its job first. After
+    // that it waits in RAM and can't be handed another job until the
+    // write is done since core 0 is the one doing the write
+    void __real_flash_range_erase(uint32_t flash_offs, size_t count);
+    void __real_flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+    void __wrap_flash_range_erase(uint32_t flash_offs, size_t count){
+        engine_draw_commands_render_core_wait();
+        __real_flash_range_erase(flash_offs, count);
+    }
+
+    void __wrap_flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count){
+        engine_draw_commands_render_core_wait();
+        __real_flash_range_program(flash_offs, data, count);
+    }
+#endif
+
+
+// Render core must be idle. Sends the last frame if that did not
+// happen yet and gives the render core what was recorded so far
+static void engine_draw_commands_hand_off(){
+    if(frame_pending_send){
+        engine_display_send();
+        frame_pending_send = false;
+    }
+
+    job_commands = command_buffers[recording_buffer_index];
+    job_count = recorded_count;
+    job_clear = !frame_prepared;
+    frame_prepared = true;
+
+    recording_buffer_index = 1 - recording_buffer_index;
+    recorded_count = 0;
+
+    engine_draw_commands_render_core_run();
+}
+
+
+engine_draw_command_t *engine_draw_commands_push(uint8_t type, float alpha, engine_shader_t *shader){
+    if(shader->program_len > ENGINE_DRAW_COMMAND_PROGRAM_MAX){
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDrawCommands: ERROR: Shader program is %d bytes, only programs up to %d bytes can be recorded"), shader->program_len, ENGINE_DRAW_COMMAND_PROGRAM_MAX);
+    }
+
+    // Out of room, start drawing this frame early
+    if(recorded_count >= command_buffer_count){
+        engine_draw_commands_render_core_wait();
+        engine_draw_commands_hand_off();
+    }
+
+    engine_draw_command_t *command = &command_buffers[recording_buffer_index][recorded_count];
+    recorded_count++;
+
+    command->type = type;
+    command->alpha = alpha;
+    command->shader = shader;
+    command->program_len = shader->program_len;
+    memcpy(command->program, shader->program, shader->program_len);
+
+    return command;
+}
+
+
+void engine_draw_commands_enable(uint16_t command_count){
+    if(command_count == 0){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDrawCommands: ERROR: Command buffers need room for at least one command"));
+    }
+
+    engine_draw_commands_disable();
+
+    ENGINE_INFO_PRINTF("EngineDrawCommands: Enabling render pipeline with %d commands per buffer", command_count);
+
+    command_buffers[0] = m_tracked_calloc(command_count, sizeof(engine_draw_command_t));
+    command_buffers[1] = m_tracked_calloc(command_count, sizeof(engine_draw_command_t));
+    command_buffer_count = command_count;
+    recording_buffer_index = 0;
+    recorded_count = 0;
+
+    // Active screen buffer is already cleared at the end of a tick
+    frame_pending_send = false;
+    frame_prepared = true;
+
+    engine_draw_commands_render_core_start();
+
+    immediate_depth = 0;
+    enabled = true;
+    engine_draw_commands_capturing = true;
+}
+
+
+void engine_draw_commands_disable(){
+    if(enabled == false){
+        return;
+    }
+
+    ENGINE_INFO_PRINTF("EngineDrawCommands: Disabling render pipeline");
+
+    engine_draw_commands_render_core_wait();
+
+    // Leave the active screen buffer the way a tick without the
+    // pipeline expects it: everything drawn so far this frame is
+    // in it or, if nothing was drawn yet, it is cleared
+    if(recorded_count > 0){
+        engine_draw_commands_hand_off();
+        engine_draw_commands_render_core_wait();
+    }else if(frame_pending_send){
+        engine_display_send();
+        engine_display_clear();
+        engine_display_clear_depth_buffer();
+        frame_pending_send = false;
+    }
+
+    enabled = false;
+    engine_draw_commands_capturing = false;
+    immediate_depth = 0;
+
+    m_tracked_free(command_buffers[0]);
+    m_tracked_free(command_buffers[1]);
+    command_buffers[0] = NULL;
+    command_buffers[1] = NULL;
+    command_buffer_count = 0;
+    recorded_count = 0;
+}
+
+
+bool engine_draw_commands_is_enabled(){
+    return enabled;
+}
+
+
+void engine_draw_commands_submit(){
+    engine_draw_commands_render_core_wait();
+    engine_draw_commands_hand_off();
+
+    frame_pending_send = true;
+    frame_prepared = false;
+}
+
+
+void engine_draw_commands_begin_immediate(){
+    if(enabled == false){
+        return;
+    }
+
+    immediate_depth++;
+
+    if(immediate_depth == 1){
+        engine_draw_commands_render_core_wait();
+        engine_draw_commands_hand_off();
+        engine_draw_commands_render_core_wait();
+        engine_draw_commands_capturing = false;
+    }
+}
+
+
+void engine_draw_commands_end_immediate(){
+    if(enabled == false || immediate_depth == 0){
+        return;
+    }
+
+    immediate_depth--;
+
+    if(immediate_depth == 0){
+        engine_draw_commands_capturing = true;
+    }
+}
+
+
+void engine_draw_commands_halt(){
+    engine_draw_commands_capturing = false;
+    enabled = false;
+
+    #if defined(__arm__)
+        if(render_core_started){
+            multicore_reset_core1();
+            render_core_started = false;
+            job_busy = false;
+        }
+    #endif
+}
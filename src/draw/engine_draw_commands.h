@@ -0,0 +1,162 @@
+#ifndef ENGINE_DRAW_COMMANDS_H
+#define ENGINE_DRAW_COMMANDS_H
+
+#include "py/obj.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include "draw/engine_shader.h"
+#include "resources/engine_texture_resource.h"
+#include "resources/engine_font_resource.h"
+
+#if defined(__arm__)
+    #include "pico.h"
+#endif
+
+// Render pipeline: instead of drawing straight into the screen buffer,
+// the draw functions in `engine_display_draw.c` record what they were
+// asked to draw (with the already resolved/transformed positions) into
+// a command buffer while Python runs frame N+1. The recorded commands
+// of frame N are rasterized on another core (core 1 on RP2040/RP2350,
+// a pthread on unix) at the same time. Nothing is recorded unless the
+// pipeline is enabled through `engine.enable_render_pipeline()`
+
+// Default number of commands in each of the two command buffers.
+// A filled buffer is handed to the render core mid-frame so this
+// only limits how much work can be queued at once
+#define ENGINE_DRAW_COMMANDS_DEFAULT_COUNT 128
+
+// Shader programs up to this length are copied into the command
+// since the builtin blend shader is modified for every draw. Recording
+// a draw with a longer program raises an error
+#define ENGINE_DRAW_COMMAND_PROGRAM_MAX 8
+
+enum engine_draw_command_types{
+    ENGINE_DRAW_COMMAND_PIXEL,
+    ENGINE_DRAW_COMMAND_LINE,
+    ENGINE_DRAW_COMMAND_BLIT,
+    ENGINE_DRAW_COMMAND_BLIT_DEPTH,
+    ENGINE_DRAW_COMMAND_RECT,
+    ENGINE_DRAW_COMMAND_OUTLINE_CIRCLE,
+    ENGINE_DRAW_COMMAND_FILLED_CIRCLE,
+    ENGINE_DRAW_COMMAND_TEXT,
+    ENGINE_DRAW_COMMAND_FILLED_TRIANGLE,
+    ENGINE_DRAW_COMMAND_FILLED_TRIANGLE_DEPTH,
+};
+
+typedef struct{
+    uint8_t type;                                       // One of `engine_draw_command_types`
+    uint8_t program_len;                                // Length of the copy of the shader program below
+    uint8_t program[ENGINE_DRAW_COMMAND_PROGRAM_MAX];   // Copy of the shader program at the time the command was recorded
+    engine_shader_t *shader;                            // Shader the `execute` functions are taken from
+    float alpha;
+    union{
+        struct{
+            uint16_t color;
+            int32_t x;
+            int32_t y;
+        }pixel;
+        struct{
+            uint16_t color;
+            float x_start, y_start;
+            float x_end, y_end;
+        }line;
+        struct{
+            texture_resource_class_obj_t *texture;
+            uint32_t offset;
+            float center_x, center_y;
+            int32_t window_width, window_height;
+            uint32_t pixels_stride;
+            float x_scale, y_scale;
+            float rotation_radians;
+            uint16_t transparent_color;
+            uint16_t depth;
+        }blit;
+        struct{
+            uint16_t color;
+            float center_x, center_y;
+            int32_t width, height;
+            float x_scale, y_scale;
+            float rotation_radians;
+        }rect;
+        struct{
+            uint16_t color;
+            float center_x, center_y;
+            float radius;
+        }circle;
+        struct{
+            font_resource_class_obj_t *font;
+            mp_obj_t text;
+            float center_x, center_y;
+            float text_box_width, text_box_height;
+            float letter_spacing, line_spacing;
+            float x_scale, y_scale;
+            float rotation_radians;
+        }text;
+        struct{
+            texture_resource_class_obj_t *texture;
+            uint16_t color;
+            uint16_t depth_az, depth_bz, depth_cz;
+            float ax, ay, au, av;
+            float bx, by, bu, bv;
+            float cx, cy, cu, cv;
+            float w0, w1, w2;
+        }triangle;
+    };
+}engine_draw_command_t;
+
+
+// True while draws from this core/thread should be recorded
+// instead of drawn (see `engine_draw_commands_recording`)
+extern volatile bool engine_draw_commands_capturing;
+
+#if defined(__EMSCRIPTEN__)
+    extern bool engine_draw_commands_on_render_thread;
+#elif defined(__unix__)
+    extern __thread bool engine_draw_commands_on_render_thread;
+#endif
+
+// Checked at the top of every draw function. The render core
+// calls the same draw functions and always draws for real
+static inline bool engine_draw_commands_recording(){
+    if(engine_draw_commands_capturing == false){
+        return false;
+    }
+
+    #if defined(__arm__)
+        return get_core_num() == 0;
+    #else
+        return engine_draw_commands_on_render_thread == false;
+    #endif
+}
+
+// Returns the next command slot with `type`, `alpha` and the shader
+// filled in. Hands the filled buffer to the render core first if
+// there is no room left. Raises if the shader program is longer
+// than `ENGINE_DRAW_COMMAND_PROGRAM_MAX`
+engine_draw_command_t *engine_draw_commands_push(uint8_t type, float alpha, engine_shader_t *shader);
+
+// Allocates the command buffers and starts the render core
+void engine_draw_commands_enable(uint16_t command_count);
+
+// Draws anything still queued, sends the last frame and frees the
+// command buffers. Drawing is done directly again after this
+void engine_draw_commands_disable();
+
+bool engine_draw_commands_is_enabled();
+
+// Called at the end of a tick in place of send/clear: waits for the
+// previous frame to finish rasterizing, sends it, and hands the
+// commands recorded this tick to the render core
+void engine_draw_commands_submit();
+
+// Everything drawn between these calls is drawn directly on the
+// calling core (after everything recorded before it). For code that
+// reads/writes the screen or depth buffers outside of draw functions
+void engine_draw_commands_begin_immediate();
+void engine_draw_commands_end_immediate();
+
+// Stops recording without waiting on the render core. Only for
+// the fault handler where the render core may be the one that died
+void engine_draw_commands_halt();
+
+#endif  // ENGINE_DRAW_COMMANDS_H
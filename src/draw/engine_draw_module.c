@@ -1,5 +1,6 @@
 #include "py/obj.h"
 #include "py/runtime.h"
+#include "py/binary.h"
 #include "display/engine_display_common.h"
 #include "resources/engine_texture_resource.h"
 #include "resources/engine_font_resource.h"
@@ -8,6 +9,7 @@
 #include "debug/debug_print.h"
 #include "engine_main.h"
 #include "engine_display_draw.h"
+#include "draw/engine_draw_commands.h"
 #include "math/engine_math.h"
 #include "math/vector2.h"
 #include "display/engine_display.h"
@@ -58,6 +60,20 @@ static mp_obj_t engine_draw_set_background(mp_obj_t background){
 MP_DEFINE_CONST_FUN_OBJ_1(engine_draw_set_background_obj, engine_draw_set_background);
 
 
+/*  --- doc ---
+    NAME: set_damage_tracking
+    ID: set_damage_tracking
+    DESC: Enables or disables only clearing and sending the parts of the screen that were drawn to (off by default). When enabled, each frame only clears what was drawn into the screen buffer last time it was used and only sends bands of rows that differ from what is already on the screen, so mostly static scenes (menus, turn-based games) use much less time and bandwidth per frame. Writes to the framebuffers that do not go through nodes or `engine_draw` functions are not tracked
+    PARAM: [type=bool]   [name=enabled]  [value=True or False]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_set_damage_tracking(mp_obj_t enabled){
+    engine_display_set_damage_tracking(mp_obj_is_true(enabled));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_draw_set_damage_tracking_obj, engine_draw_set_damage_tracking);
+
+
 static mp_obj_t engine_draw_module_init(){
     engine_main_raise_if_not_initialized();
     return mp_const_none;
@@ -119,7 +135,12 @@ MP_DEFINE_CONST_FUN_OBJ_0(engine_draw_front_fb_obj, engine_draw_front_fb);
 */
 static mp_obj_t engine_draw_module_clear(mp_obj_t arg) {
     uint16_t color = engine_color_class_color_value(arg);
+
+    // Writes the screen buffer directly, needs everything
+    // recorded before it to be drawn first
+    engine_draw_commands_begin_immediate();
     engine_display_clear_screen_buffer(color);
+    engine_draw_commands_end_immediate();
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(engine_draw_module_clear_obj, engine_draw_module_clear);
@@ -202,25 +223,10 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_line_obj, 6, 6, engine_dr
     PARAM: [type=float]                      [name=opacity]     [value=0.0 ~ 1.0]
     RETURN: None
 */
-static mp_obj_t engine_draw_module_rect(size_t n_args, const mp_obj_t *args) {    
-    uint16_t color    = engine_color_class_color_value(args[0]);
-    float top_left_x  = mp_obj_get_float(args[1]);
-    float top_left_y  = mp_obj_get_float(args[2]);
-    float width       = mp_obj_get_float(args[3]);
-    float height      = mp_obj_get_float(args[4]);
-    bool outline      = mp_obj_get_int(args[5]);
-    float opacity     = mp_obj_get_float(args[6]);
-    
+static void engine_draw_module_draw_rect(uint16_t color, float top_left_x, float top_left_y, float width, float height, bool outline, float opacity, engine_shader_t *shader){
     float center_x = top_left_x + width * 0.5f;
     float center_y = top_left_y + height * 0.5f;
 
-    engine_shader_t *shader = NULL;
-    if(opacity < 1.0f){
-        shader = engine_get_builtin_shader(OPACITY_SHADER);
-    }else{
-        shader = engine_get_builtin_shader(EMPTY_SHADER);
-    }
-    
     if(outline){
         // Calculate the coordinates of the 4 corners of the rectangle, not rotated
         // NOTE: positive y is down
@@ -243,6 +249,26 @@ static mp_obj_t engine_draw_module_rect(size_t n_args, const mp_obj_t *args) {
     }else{
         engine_draw_rect(color, center_x, center_y, (int32_t)width, (int32_t)height, 1.0f, 1.0f, 0.0f, opacity, shader);
     }
+}
+
+
+static mp_obj_t engine_draw_module_rect(size_t n_args, const mp_obj_t *args) {    
+    uint16_t color    = engine_color_class_color_value(args[0]);
+    float top_left_x  = mp_obj_get_float(args[1]);
+    float top_left_y  = mp_obj_get_float(args[2]);
+    float width       = mp_obj_get_float(args[3]);
+    float height      = mp_obj_get_float(args[4]);
+    bool outline      = mp_obj_get_int(args[5]);
+    float opacity     = mp_obj_get_float(args[6]);
+
+    engine_shader_t *shader = NULL;
+    if(opacity < 1.0f){
+        shader = engine_get_builtin_shader(OPACITY_SHADER);
+    }else{
+        shader = engine_get_builtin_shader(EMPTY_SHADER);
+    }
+
+    engine_draw_module_draw_rect(color, top_left_x, top_left_y, width, height, outline, opacity, shader);
 
     return mp_const_none;
 }
@@ -287,6 +313,267 @@ static mp_obj_t engine_draw_module_circle(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_circle_obj, 6, 6, engine_draw_module_circle);
 
 
+// Reads the coordinate at `index` out of a packed buffer
+typedef float (*engine_draw_batch_reader_t)(const void *data, size_t index);
+
+static float engine_draw_batch_read_int8(const void *data, size_t index){
+    return ((const int8_t*)data)[index];
+}
+
+static float engine_draw_batch_read_uint8(const void *data, size_t index){
+    return ((const uint8_t*)data)[index];
+}
+
+static float engine_draw_batch_read_int16(const void *data, size_t index){
+    return ((const int16_t*)data)[index];
+}
+
+static float engine_draw_batch_read_uint16(const void *data, size_t index){
+    return ((const uint16_t*)data)[index];
+}
+
+static float engine_draw_batch_read_int32(const void *data, size_t index){
+    return ((const int32_t*)data)[index];
+}
+
+static float engine_draw_batch_read_float(const void *data, size_t index){
+    return ((const float*)data)[index];
+}
+
+
+// Picks the reader for the buffer's type once for the whole batch and
+// sets `count` to the number of items with `stride` coordinates each
+static engine_draw_batch_reader_t engine_draw_batch_get_reader(mp_obj_t coordinates, mp_buffer_info_t *buffer, size_t stride, size_t *count){
+    mp_get_buffer_raise(coordinates, buffer, MP_BUFFER_READ);
+
+    engine_draw_batch_reader_t reader = NULL;
+    size_t coordinate_size = 0;
+
+    switch(buffer->typecode){
+        case 'b':
+            reader = engine_draw_batch_read_int8;
+            coordinate_size = 1;
+        break;
+        case 'B':
+        case BYTEARRAY_TYPECODE:
+            reader = engine_draw_batch_read_uint8;
+            coordinate_size = 1;
+        break;
+        case 'h':
+            reader = engine_draw_batch_read_int16;
+            coordinate_size = 2;
+        break;
+        case 'H':
+            reader = engine_draw_batch_read_uint16;
+            coordinate_size = 2;
+        break;
+        case 'i':
+            reader = engine_draw_batch_read_int32;
+            coordinate_size = 4;
+        break;
+        case 'f':
+            reader = engine_draw_batch_read_float;
+            coordinate_size = 4;
+        break;
+        default:
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDraw: ERROR: Batch coordinates must be a bytearray or an array of type 'b', 'B', 'h', 'H', 'i' or 'f'"));
+    }
+
+    *count = (buffer->len / coordinate_size) / stride;
+    return reader;
+}
+
+
+// `colors` is either one color for every item or a buffer of RGB565
+// colors with one per item. Returns NULL and sets `single_color` for
+// the first case
+static const uint16_t *engine_draw_batch_get_colors(mp_obj_t colors, uint16_t *single_color, size_t count){
+    if(engine_color_is_instance(colors) || mp_obj_is_int(colors)){
+        *single_color = engine_color_class_color_value(colors);
+        return NULL;
+    }
+
+    mp_buffer_info_t buffer;
+    mp_get_buffer_raise(colors, &buffer, MP_BUFFER_READ);
+
+    if(buffer.typecode != 'H' && buffer.typecode != 'h'){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDraw: ERROR: Batch colors must be a Color, an int or an array of type 'H'"));
+    }
+
+    if(buffer.len / 2 < count){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("EngineDraw: ERROR: Batch has fewer colors than items"));
+    }
+
+    return buffer.buf;
+}
+
+
+static engine_shader_t *engine_draw_batch_get_shader(float opacity){
+    if(opacity < 1.0f){
+        return engine_get_builtin_shader(OPACITY_SHADER);
+    }else{
+        return engine_get_builtin_shader(EMPTY_SHADER);
+    }
+}
+
+
+/*  --- doc ---
+    NAME: pixels
+    ID: engine_draw_module_pixels
+    DESC: Same as {ref_link:engine_draw_module_pixel} but draws every pixel in `coordinates` in one call. `coordinates` is a bytearray or an `array.array` of type 'b', 'B', 'h', 'H', 'i' or 'f' packed as x0, y0, x1, y1, ... All parameters are required and keywords are not allowed.
+    PARAM: [type=uint16 | {ref_link:Color} | array]  [name=colors]       [value=one color for all pixels or an `array.array('H')` with one RGB565 color per pixel]
+    PARAM: [type=buffer]                             [name=coordinates]  [value=packed x, y pairs]
+    PARAM: [type=float]                              [name=opacity]      [value=0.0 ~ 1.0]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_module_pixels(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t coordinates;
+    size_t count = 0;
+    engine_draw_batch_reader_t read = engine_draw_batch_get_reader(args[1], &coordinates, 2, &count);
+
+    uint16_t color = 0;
+    const uint16_t *colors = engine_draw_batch_get_colors(args[0], &color, count);
+
+    float opacity = mp_obj_get_float(args[2]);
+    engine_shader_t *shader = engine_draw_batch_get_shader(opacity);
+
+    for(size_t inx=0; inx<count; inx++){
+        if(colors != NULL){
+            color = colors[inx];
+        }
+
+        float x = read(coordinates.buf, inx*2);
+        float y = read(coordinates.buf, inx*2 + 1);
+
+        engine_draw_pixel(color, (int32_t)x, (int32_t)y, opacity, shader);
+    }
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_pixels_obj, 3, 3, engine_draw_module_pixels);
+
+
+/*  --- doc ---
+    NAME: lines
+    ID: engine_draw_module_lines
+    DESC: Same as {ref_link:engine_draw_module_line} but draws every line in `coordinates` in one call. `coordinates` is packed as start_x0, start_y0, end_x0, end_y0, ... (see {ref_link:engine_draw_module_pixels} for the buffer types). All parameters are required and keywords are not allowed.
+    PARAM: [type=uint16 | {ref_link:Color} | array]  [name=colors]       [value=one color for all lines or an `array.array('H')` with one RGB565 color per line]
+    PARAM: [type=buffer]                             [name=coordinates]  [value=packed start and end points]
+    PARAM: [type=float]                              [name=opacity]      [value=0.0 ~ 1.0]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_module_lines(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t coordinates;
+    size_t count = 0;
+    engine_draw_batch_reader_t read = engine_draw_batch_get_reader(args[1], &coordinates, 4, &count);
+
+    uint16_t color = 0;
+    const uint16_t *colors = engine_draw_batch_get_colors(args[0], &color, count);
+
+    float opacity = mp_obj_get_float(args[2]);
+    engine_shader_t *shader = engine_draw_batch_get_shader(opacity);
+
+    for(size_t inx=0; inx<count; inx++){
+        if(colors != NULL){
+            color = colors[inx];
+        }
+
+        float start_x = read(coordinates.buf, inx*4);
+        float start_y = read(coordinates.buf, inx*4 + 1);
+        float end_x   = read(coordinates.buf, inx*4 + 2);
+        float end_y   = read(coordinates.buf, inx*4 + 3);
+
+        engine_draw_line(color, start_x, start_y, end_x, end_y, opacity, shader);
+    }
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_lines_obj, 3, 3, engine_draw_module_lines);
+
+
+/*  --- doc ---
+    NAME: rects
+    ID: engine_draw_module_rects
+    DESC: Same as {ref_link:engine_draw_module_rect} but draws every rectangle in `coordinates` in one call. `coordinates` is packed as top_left_x0, top_left_y0, width0, height0, ... (see {ref_link:engine_draw_module_pixels} for the buffer types). All parameters are required and keywords are not allowed.
+    PARAM: [type=uint16 | {ref_link:Color} | array]  [name=colors]       [value=one color for all rectangles or an `array.array('H')` with one RGB565 color per rectangle]
+    PARAM: [type=buffer]                             [name=coordinates]  [value=packed top left corners and sizes]
+    PARAM: [type=boolean]                            [name=outline]      [value=any]
+    PARAM: [type=float]                              [name=opacity]      [value=0.0 ~ 1.0]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_module_rects(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t coordinates;
+    size_t count = 0;
+    engine_draw_batch_reader_t read = engine_draw_batch_get_reader(args[1], &coordinates, 4, &count);
+
+    uint16_t color = 0;
+    const uint16_t *colors = engine_draw_batch_get_colors(args[0], &color, count);
+
+    bool outline = mp_obj_get_int(args[2]);
+    float opacity = mp_obj_get_float(args[3]);
+    engine_shader_t *shader = engine_draw_batch_get_shader(opacity);
+
+    for(size_t inx=0; inx<count; inx++){
+        if(colors != NULL){
+            color = colors[inx];
+        }
+
+        float top_left_x = read(coordinates.buf, inx*4);
+        float top_left_y = read(coordinates.buf, inx*4 + 1);
+        float width      = read(coordinates.buf, inx*4 + 2);
+        float height     = read(coordinates.buf, inx*4 + 3);
+
+        engine_draw_module_draw_rect(color, top_left_x, top_left_y, width, height, outline, opacity, shader);
+    }
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_rects_obj, 4, 4, engine_draw_module_rects);
+
+
+/*  --- doc ---
+    NAME: circles
+    ID: engine_draw_module_circles
+    DESC: Same as {ref_link:engine_draw_module_circle} but draws every circle in `coordinates` in one call. `coordinates` is packed as center_x0, center_y0, radius0, ... (see {ref_link:engine_draw_module_pixels} for the buffer types). All parameters are required and keywords are not allowed.
+    PARAM: [type=uint16 | {ref_link:Color} | array]  [name=colors]       [value=one color for all circles or an `array.array('H')` with one RGB565 color per circle]
+    PARAM: [type=buffer]                             [name=coordinates]  [value=packed centers and radii]
+    PARAM: [type=boolean]                            [name=outline]      [value=any]
+    PARAM: [type=float]                              [name=opacity]      [value=0.0 ~ 1.0]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_module_circles(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t coordinates;
+    size_t count = 0;
+    engine_draw_batch_reader_t read = engine_draw_batch_get_reader(args[1], &coordinates, 3, &count);
+
+    uint16_t color = 0;
+    const uint16_t *colors = engine_draw_batch_get_colors(args[0], &color, count);
+
+    bool outline = mp_obj_get_int(args[2]);
+    float opacity = mp_obj_get_float(args[3]);
+    engine_shader_t *shader = engine_draw_batch_get_shader(opacity);
+
+    for(size_t inx=0; inx<count; inx++){
+        if(colors != NULL){
+            color = colors[inx];
+        }
+
+        float center_x = read(coordinates.buf, inx*3);
+        float center_y = read(coordinates.buf, inx*3 + 1);
+        float radius   = read(coordinates.buf, inx*3 + 2);
+
+        if(outline){
+            engine_draw_outline_circle(color, center_x, center_y, radius, opacity, shader);
+        }else{
+            engine_draw_filled_circle(color, center_x, center_y, radius, opacity, shader);
+        }
+    }
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_circles_obj, 4, 4, engine_draw_module_circles);
+
+
 /*  --- doc ---
     NAME: text
     ID: engine_draw_module_text
@@ -315,14 +602,7 @@ static mp_obj_t engine_draw_module_text(size_t n_args, const mp_obj_t *args) {
 
     if(blend_color != mp_const_none){
         shader = engine_get_builtin_shader(BLEND_OPACITY_SHADER);
-
-        float t = 1.0f;
-
-        uint16_t color = engine_color_class_color_value(blend_color);
-        shader->program[1] = (color >> 8) & 0b11111111;
-        shader->program[2] = (color >> 0) & 0b11111111;
-
-        memcpy(shader->program+3, &t, sizeof(float));
+        engine_shader_set_rgb_interpolate(shader, engine_color_class_color_value(blend_color), 1.0f);
     }else if(opacity < 1.0f){
         shader = engine_get_builtin_shader(OPACITY_SHADER);   
     }else{
@@ -385,6 +665,42 @@ static mp_obj_t engine_draw_module_blit(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_blit_obj, 5, 5, engine_draw_module_blit);
 
 
+/*  --- doc ---
+    NAME: blits
+    ID: engine_draw_module_blits
+    DESC: Same as {ref_link:engine_draw_module_blit} but draws `texture` at every top left corner in `coordinates` in one call. `coordinates` is packed as top_left_x0, top_left_y0, ... (see {ref_link:engine_draw_module_pixels} for the buffer types). All parameters are required and keywords are not allowed.
+    PARAM: [type={ref_link:TextureResource}]          [name=texture]            [value={ref_link:TextureResource}]
+    PARAM: [type=buffer]                              [name=coordinates]        [value=packed top left corners]
+    PARAM: [type=uint16 | {ref_link:Color} | `None`]  [name=transparent_color]  [value=positive unsigned RGB565 16-bit int | {ref_link:Color} | `None`]
+    PARAM: [type=float]                               [name=opacity]            [value=any]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_module_blits(size_t n_args, const mp_obj_t *args) {
+    texture_resource_class_obj_t *texture = args[0];
+
+    mp_buffer_info_t coordinates;
+    size_t count = 0;
+    engine_draw_batch_reader_t read = engine_draw_batch_get_reader(args[1], &coordinates, 2, &count);
+
+    uint16_t transparent_color = engine_color_class_color_value(args[2]);
+    float opacity = mp_obj_get_float(args[3]);
+    engine_shader_t *shader = engine_draw_batch_get_shader(opacity);
+
+    float width = texture->width;
+    float height = texture->height;
+
+    for(size_t inx=0; inx<count; inx++){
+        float center_x = read(coordinates.buf, inx*2) + width * 0.5f;
+        float center_y = read(coordinates.buf, inx*2 + 1) + height * 0.5f;
+
+        engine_draw_blit(texture, 0, center_x, center_y, (int32_t)width, (int32_t)height, (int32_t)width, 1.0f, 1.0f, 0.0f, transparent_color, opacity, shader);
+    }
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_blits_obj, 4, 4, engine_draw_module_blits);
+
+
 /*  --- doc ---
     NAME: update
     ID: engine_draw_module_update
@@ -392,7 +708,11 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_module_blit_obj, 5, 5, engine_dr
     RETURN: None
 */
 static mp_obj_t engine_draw_module_update() {
-    engine_display_send();
+    if(engine_draw_commands_is_enabled()){
+        engine_draw_commands_submit();
+    }else{
+        engine_display_send();
+    }
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_0(engine_draw_module_update_obj, engine_draw_module_update);
@@ -430,6 +750,7 @@ color_class_obj_t violet        = {{&const_color_class_type}, .value = 0x915C};
     DESC: Module for drawing to the framebuffer
     ATTR: [type=function]           [name={ref_link:set_background_color}]      [value=function]
     ATTR: [type=function]           [name={ref_link:set_background}]            [value=function]
+    ATTR: [type=function]           [name={ref_link:set_damage_tracking}]       [value=function]
     ATTR: [type=function]           [name={ref_link:back_fb_data}]              [value=getter/setter function]
     ATTR: [type=function]           [name={ref_link:front_fb_data}]             [value=getter/setter function]
     ATTR: [type=function]           [name={ref_link:back_fb}]                   [value=getter/setter function]
@@ -466,6 +787,11 @@ color_class_obj_t violet        = {{&const_color_class_type}, .value = 0x915C};
     ATTR: [type=function]           [name={ref_link:engine_draw_module_circle}] [value=function]
     ATTR: [type=function]           [name={ref_link:engine_draw_module_text}]   [value=function]
     ATTR: [type=function]           [name={ref_link:engine_draw_module_blit}]   [value=function]
+    ATTR: [type=function]           [name={ref_link:engine_draw_module_pixels}]  [value=function]
+    ATTR: [type=function]           [name={ref_link:engine_draw_module_lines}]   [value=function]
+    ATTR: [type=function]           [name={ref_link:engine_draw_module_rects}]   [value=function]
+    ATTR: [type=function]           [name={ref_link:engine_draw_module_circles}] [value=function]
+    ATTR: [type=function]           [name={ref_link:engine_draw_module_blits}]   [value=function]
     ATTR: [type=function]           [name={ref_link:engine_draw_module_update}] [value=function]
 */
 static const mp_rom_map_elem_t engine_draw_globals_table[] = {
@@ -473,6 +799,7 @@ static const mp_rom_map_elem_t engine_draw_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___init__), MP_ROM_PTR(&engine_draw_module_init_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_background_color), MP_ROM_PTR(&engine_draw_set_background_color_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_background), MP_ROM_PTR(&engine_draw_set_background_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_damage_tracking), MP_ROM_PTR(&engine_draw_set_damage_tracking_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_Color), MP_ROM_PTR(&color_class_type) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_black), MP_ROM_PTR(&black) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_navy), MP_ROM_PTR(&navy) },
@@ -510,6 +837,11 @@ static const mp_rom_map_elem_t engine_draw_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_circle), MP_ROM_PTR(&engine_draw_module_circle_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_text), MP_ROM_PTR(&engine_draw_module_text_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_blit), MP_ROM_PTR(&engine_draw_module_blit_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_pixels), MP_ROM_PTR(&engine_draw_module_pixels_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_lines), MP_ROM_PTR(&engine_draw_module_lines_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_rects), MP_ROM_PTR(&engine_draw_module_rects_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_circles), MP_ROM_PTR(&engine_draw_module_circles_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_blits), MP_ROM_PTR(&engine_draw_module_blits_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_update), MP_ROM_PTR(&engine_draw_module_update_obj) },
 };
 static MP_DEFINE_CONST_DICT (mp_module_engine_draw_globals, engine_draw_globals_table);
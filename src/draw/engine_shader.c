@@ -18,6 +18,17 @@ uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_alpha)(uint16_t bg, uint16_t f
 }
 
 
+// Integer opacity versions of the above
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_empty_fixed)(uint16_t bg, uint16_t fg, uint8_t opacity, engine_shader_t *shader){
+    return fg;
+}
+
+
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_alpha_fixed)(uint16_t bg, uint16_t fg, uint8_t opacity, engine_shader_t *shader){
+    return engine_color_alpha_blend_fixed(bg, fg, opacity);
+}
+
+
 // Slow function for when a node has a custom shader (TODO: not implemented yet)
 uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_custom)(uint16_t bg, uint16_t fg, float opacity, engine_shader_t *shader){
     uint8_t index = 0;
@@ -53,11 +64,17 @@ uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_custom)(uint16_t bg, uint16_t
 }
 
 
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_custom_fixed)(uint16_t bg, uint16_t fg, uint8_t opacity, engine_shader_t *shader){
+    return engine_pixel_shader_custom(bg, fg, opacity * (1.0f / ENGINE_ALPHA_FIXED_ONE), shader);
+}
+
+
 // Fast shader that can be passed from node draw callback to drawing functions to quickly paste pixels to buffer
 engine_shader_t empty_shader = {
     .program = {},
     .program_len = 0,
     .execute = engine_pixel_shader_empty,
+    .execute_fixed = engine_pixel_shader_empty_fixed,
 };
 
 
@@ -66,6 +83,7 @@ engine_shader_t opacity_shader = {
     .program = {},
     .program_len = 0,
     .execute = engine_pixel_shader_alpha,
+    .execute_fixed = engine_pixel_shader_alpha_fixed,
 };
 
 
@@ -73,6 +91,7 @@ engine_shader_t blend_opacity_shader = {
     .program = {SHADER_RGB_INTERPOLATE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, SHADER_OPACITY_BLEND},
     .program_len = 8,
     .execute = engine_pixel_shader_custom,
+    .execute_fixed = engine_pixel_shader_custom_fixed,
 };
 
 engine_shader_t *builtin_shaders[3] = {
@@ -83,4 +102,13 @@ engine_shader_t *builtin_shaders[3] = {
 
 engine_shader_t *engine_get_builtin_shader(enum engine_builtin_shader_types type){
     return builtin_shaders[type];
+}
+
+
+void engine_shader_set_rgb_interpolate(engine_shader_t *shader, uint16_t color, float t){
+    t = engine_color_blend_amount_to_fixed(t) * (1.0f / ENGINE_COLOR_BLEND_FIXED_ONE);
+
+    shader->program[1] = (color >> 8) & 0b11111111;
+    shader->program[2] = (color >> 0) & 0b11111111;
+    memcpy(shader->program+3, &t, sizeof(float));
 }
\ No newline at end of file
@@ -19,10 +19,23 @@ typedef struct engine_shader_t{
     uint8_t program[UINT8_MAX];                                                                      // Shader program consisting of op codes from `engine_shader_op_codes` (256 max codes allowed)
     uint8_t program_len;                                                                             // Length of `program` in bytes
     uint16_t (*execute)(uint16_t bg, uint16_t fg, float opacity, struct engine_shader_t *shader);    // Function to execute the bytes/op codes in `program` (sometimes switched out for speed if some effects are not used)
+    uint16_t (*execute_fixed)(uint16_t bg, uint16_t fg, uint8_t opacity, struct engine_shader_t *shader); // Same as `execute` but with 0 ~ 32 integer opacity (`ENGINE_ALPHA_FIXED_ONE`) so blending stays in integer math
 }engine_shader_t;
 
 
+// Builtin `execute` functions. Exposed so that span based drawing
+// functions can recognize them and use specialized loops instead
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_empty)(uint16_t bg, uint16_t fg, float opacity, engine_shader_t *shader);
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_alpha)(uint16_t bg, uint16_t fg, float opacity, engine_shader_t *shader);
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_empty_fixed)(uint16_t bg, uint16_t fg, uint8_t opacity, engine_shader_t *shader);
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_alpha_fixed)(uint16_t bg, uint16_t fg, uint8_t opacity, engine_shader_t *shader);
+
 engine_shader_t *engine_get_builtin_shader(enum engine_builtin_shader_types type);
 
+// Sets the color and amount of the `SHADER_RGB_INTERPOLATE` op at the start of
+// `shader`'s program. `t` is rounded to the 1/256 steps `engine_color_blend`
+// works in so that the stored amount is exactly the one that gets blended
+void engine_shader_set_rgb_interpolate(engine_shader_t *shader, uint16_t color, float t);
+
 
 #endif  // ENGINE_SHADER_H
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "link/engine_link_module.h"
 
 #include "draw/engine_display_draw.h"
+#include "draw/engine_draw_commands.h"
 
 #include "animation/engine_animation_module.h"
 
@@ -143,6 +144,43 @@ static mp_obj_t engine_disable_fps_limit(){
 MP_DEFINE_CONST_FUN_OBJ_0(engine_disable_fps_limit_obj, engine_disable_fps_limit);
 
 
+/* --- doc ---
+   NAME: enable_render_pipeline
+   ID: enable_render_pipeline
+   DESC: Draws on a second core (second thread on unix) while the next tick runs. Draws done by nodes and {ref_link:engine_draw} functions are recorded into command buffers and rasterized one frame later, so Python and drawing happen at the same time instead of one after the other. Adds one frame of latency. The screen buffer is always cleared before each frame is drawn and the framebuffers should not be written to directly while this is enabled. A full command buffer gets handed to the other core early, so `command_count` only limits how much is queued at once (each command is about 100 bytes and there are two buffers). On the device the second core is core 1, so this raises if a `_thread` was started
+   PARAM: [type=int (optional)] [name=command_count] [value=1 ~ 65535 (default: 128)]
+   RETURN: None
+*/
+static mp_obj_t engine_enable_render_pipeline(size_t n_args, const mp_obj_t *args){
+    mp_int_t command_count = ENGINE_DRAW_COMMANDS_DEFAULT_COUNT;
+
+    if(n_args == 1){
+        command_count = mp_obj_get_int(args[0]);
+    }
+
+    if(command_count < 1 || command_count > UINT16_MAX){
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("Engine: ERROR: Render pipeline command count must be between 1 and %d"), UINT16_MAX);
+    }
+
+    engine_draw_commands_enable((uint16_t)command_count);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_enable_render_pipeline_obj, 0, 1, engine_enable_render_pipeline);
+
+
+/* --- doc ---
+   NAME: disable_render_pipeline
+   ID: disable_render_pipeline
+   DESC: Finishes drawing anything that was recorded and goes back to drawing directly on the core running Python (default)
+   RETURN: None
+*/
+static mp_obj_t engine_disable_render_pipeline(){
+    engine_draw_commands_disable();
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_disable_render_pipeline_obj, engine_disable_render_pipeline);
+
+
 /* --- doc ---
    NAME: get_running_fps
    ID: get_running_fps
@@ -297,12 +335,18 @@ TRACE_DECL(bool engine_tick, (),
 
         engine_gui_tick();
 
-        // After every game cycle send the current active screen buffer to the display
-        engine_display_send();
-        engine_display_clear();
+        if(engine_draw_commands_is_enabled()){
+            // Sends the last frame once the render core is done with
+            // it and starts rasterizing this one while the next tick runs
+            engine_draw_commands_submit();
+        }else{
+            // After every game cycle send the current active screen buffer to the display
+            engine_display_send();
+            engine_display_clear();
 
-        // Clear the depth buffer, if needed
-        engine_display_clear_depth_buffer();
+            // Clear the depth buffer, if needed
+            engine_display_clear_depth_buffer();
+        }
 
         ticked = true;
     }
@@ -497,6 +541,8 @@ MP_DEFINE_CONST_FUN_OBJ_0(engine_system_files_digest_obj, engine_system_files_di
    DESC: Main component for controlling vital engine features
    ATTR: [type=function] [name={ref_link:fps_limit}]                        [value=getter/setter function]
    ATTR: [type=function] [name={ref_link:disable_fps_limit}]                [value=function (fps limit is disabled by default, use {ref_link:fps_limit} to enable it)]
+   ATTR: [type=function] [name={ref_link:enable_render_pipeline}]           [value=function]
+   ATTR: [type=function] [name={ref_link:disable_render_pipeline}]          [value=function]
    ATTR: [type=function] [name={ref_link:get_running_fps}]                  [value=function]
    ATTR: [type=function] [name={ref_link:engine_time_to_next_tick}]         [value=function]
    ATTR: [type=function] [name={ref_link:engine_tick}]                      [value=function]
@@ -514,6 +560,8 @@ static const mp_rom_map_elem_t engine_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___init__), (mp_obj_t)&engine_module_init_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_fps_limit), (mp_obj_t)&engine_fps_limit_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_disable_fps_limit), (mp_obj_t)&engine_disable_fps_limit_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_enable_render_pipeline), (mp_obj_t)&engine_enable_render_pipeline_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_disable_render_pipeline), (mp_obj_t)&engine_disable_render_pipeline_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_running_fps), (mp_obj_t)&engine_get_running_fps_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_time_to_next_tick), (mp_obj_t)&engine_time_to_next_tick_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_tick), (mp_obj_t)&engine_mp_tick_obj },
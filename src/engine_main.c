@@ -18,6 +18,7 @@
 #include "time/engine_rtc.h"
 #include "display/engine_display.h"
 #include "display/engine_display_common.h"
+#include "draw/engine_draw_commands.h"
 #include "physics/engine_physics.h"
 #include "animation/engine_animation_module.h"
 #include "engine_gui.h"
@@ -176,7 +177,9 @@ TRACE_DECL(void engine_main_reset, (),
 
     // Probably should reset the processor clock speed to base 150MHz (depending on platform): TODO - engine_set_freq(150 * 1000 * 1000);
 
+    engine_draw_commands_disable();     // Finish anything the render core was drawing and go back to drawing directly
     engine_display_reset_fills();       // Always reset screen background fills to no texture and black color
+    engine_display_set_damage_tracking(false);  // Always go back to clearing and sending whole frames
     engine_link_module_reset();         // Reset callbacks to None and stop link if started
     engine_io_reset();                  // Reset certain flags like if the indicator is overriden by the game and is not showing battery level
     engine_audio_reset();               // Reset game volume and stop all channels from playing audio
@@ -12,6 +12,7 @@
 #include "nodes/2D/text_2d_node.h"
 #include "nodes/2D/gui_button_2d_node.h"
 #include "nodes/2D/gui_bitmap_button_2d_node.h"
+#include "nodes/2D/tile_map_2d_node.h"
 #include "nodes/2D/physics_rectangle_2d_node.h"
 #include "nodes/2D/physics_circle_2d_node.h"
 #include "nodes/node_types.h"
@@ -22,22 +23,110 @@
 
 #include "fault/engine_trace_portable.h"
 
-uint16_t engine_object_layer_count = 128;
-linked_list engine_object_layers[128];
+#define ENGINE_OBJECT_LAYER_COUNT 128
+#define ENGINE_OBJECT_LAYER_INITIAL_CAPACITY 8
+
+// Each layer is a dense array of the nodes in it, in the order they
+// were added. Removed nodes leave a hole so that the draw order and
+// any pass in progress are not disturbed, holes are compacted at the
+// start of the next pass
+typedef struct{
+    engine_node_base_t *node_base;  // NULL if the node was removed
+    mp_obj_t tick_cb;               // Copy of the node's `tick_cb`, MP_OBJ_NULL until resolved from the node's struct
+    uint8_t type;                   // Copy of `node_base->type`
+}engine_object_layer_entry_t;
+
+typedef struct{
+    engine_object_layer_entry_t *entries;
+    uint16_t count;                 // Entries in use, including holes
+    uint16_t capacity;
+    uint16_t node_count;            // Entries that still have a node
+}engine_object_layer_t;
+
+uint16_t engine_object_layer_count = ENGINE_OBJECT_LAYER_COUNT;
+engine_object_layer_t engine_object_layers[ENGINE_OBJECT_LAYER_COUNT];
+
+// One bit per layer, set while the layer has nodes so
+// that the passes only visit layers that are in use
+static uint32_t engine_object_layers_occupied[ENGINE_OBJECT_LAYER_COUNT/32];
+
+// Entries can't be moved while a pass is walking them
+static bool engine_object_layers_walking = false;
+
+
+// Returns the index of the next layer after `after` that has nodes, -1 if none
+static int16_t engine_object_layers_next_occupied(int16_t after){
+    uint16_t ilx = after + 1;
+
+    while(ilx < ENGINE_OBJECT_LAYER_COUNT){
+        uint32_t occupied = engine_object_layers_occupied[ilx >> 5] >> (ilx & 31);
+
+        if(occupied != 0){
+            return ilx + __builtin_ctz(occupied);
+        }
+
+        // Nothing left in this word, go to the start of the next one
+        ilx = (ilx | 31) + 1;
+    }
+
+    return -1;
+}
+
+
+// Removes the holes left by removed nodes, keeps the order of the rest
+static void engine_object_layers_compact(engine_object_layer_t *layer){
+    uint16_t kept = 0;
+
+    for(uint16_t inx=0; inx<layer->count; inx++){
+        if(layer->entries[inx].node_base == NULL){
+            continue;
+        }
+
+        layer->entries[kept] = layer->entries[inx];
+        layer->entries[kept].node_base->object_index = kept;
+        kept++;
+    }
+
+    layer->count = kept;
+}
+
+
+static void engine_object_layers_compact_all(){
+    for(int16_t ilx=engine_object_layers_next_occupied(-1); ilx!=-1; ilx=engine_object_layers_next_occupied(ilx)){
+        engine_object_layer_t *layer = &engine_object_layers[ilx];
+
+        if(layer->count != layer->node_count){
+            engine_object_layers_compact(layer);
+        }
+    }
+}
 
 
 TRACE_DECL(void engine_objects_clear_all, (),
     ENGINE_INFO_PRINTF("Untracking all nodes...");
     for(uint8_t inx=0; inx<engine_object_layer_count; inx++){
+        engine_object_layer_t *layer = &engine_object_layers[inx];
+
+        // Deleting a node removes it from the layer and
+        // `count` goes to zero once the last one is gone
+        for(uint16_t enx=0; enx<layer->count; enx++){
+            engine_node_base_t *node_base = layer->entries[enx].node_base;
 
-        while(engine_object_layers[inx].start != NULL){
-            engine_node_base_t *node_base = engine_object_layers[inx].start->object;
+            if(node_base == NULL){
+                continue;
+            }
 
             // m_del_obj does not call finalizer, call it ourselves then delete the mp object
             mp_obj_t final = mp_load_attr(node_base, MP_QSTR___del__);
             mp_call_function_0(final);
             m_del_obj(mp_obj_get_type(node_base), node_base);
         }
+
+        free(layer->entries);
+        layer->entries = NULL;
+        layer->count = 0;
+        layer->capacity = 0;
+        layer->node_count = 0;
     }
 )
 
@@ -59,311 +148,313 @@ TRACE_DECL(void engine_objects_clear_deletable, (),
 TRACE_DECL(uint16_t engine_get_total_object_count, (),
     uint16_t count = 0;
     for(uint8_t ilx=0; ilx<engine_object_layer_count; ilx++){
-        count += engine_object_layers[ilx].count;
+        count += engine_object_layers[ilx].node_count;
     }
 
     return count;
 )
 
 
-// Add an object to the pool of all nodes in 'engine_object_layers' at some layer
-TRACE_DECL(linked_list_node *engine_add_object_to_layer, (void *obj, uint8_t layer_index),
+// Add a node to the end of one of the layers in 'engine_object_layers'
+TRACE_DECL(void engine_add_object_to_layer, (engine_node_base_t *node_base, uint8_t layer_index),
     if(layer_index >= engine_object_layer_count){
         ENGINE_ERROR_PRINTF("Tried to add object to layer %d but the max layer index is %d. Resize the number of available draw layers at the cost of memory", layer_index, engine_object_layer_count-1);
         mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Tried to add object to layer index that is out of bounds! Resize the object layer count!"));
     }
 
-    return linked_list_add_obj(&engine_object_layers[layer_index], obj);
+    engine_object_layer_t *layer = &engine_object_layers[layer_index];
+
+    // Reuse the room taken by holes before growing
+    if(layer->count == layer->capacity && layer->count != layer->node_count && engine_object_layers_walking == false){
+        engine_object_layers_compact(layer);
+    }
+
+    if(layer->count == layer->capacity){
+        if(layer->capacity == UINT16_MAX){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Tried to add too many nodes to one layer!"));
+        }
+
+        uint32_t capacity = (layer->capacity == 0) ? ENGINE_OBJECT_LAYER_INITIAL_CAPACITY : (uint32_t)layer->capacity * 2;
+        if(capacity > UINT16_MAX){
+            capacity = UINT16_MAX;
+        }
+
+        engine_object_layer_entry_t *entries = realloc(layer->entries, capacity * sizeof(engine_object_layer_entry_t));
+        if(entries == NULL){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Ran out of memory adding node to layer!"));
+        }
+
+        layer->entries = entries;
+        layer->capacity = capacity;
+    }
+
+    engine_object_layer_entry_t *entry = &layer->entries[layer->count];
+    entry->node_base = node_base;
+    entry->tick_cb = MP_OBJ_NULL;
+    entry->type = node_base->type;
+
+    node_base->object_index = layer->count;
+    layer->count++;
+    layer->node_count++;
+
+    engine_object_layers_occupied[layer_index >> 5] |= (1u << (layer_index & 31));
 )
 
 
-TRACE_DECL(void engine_remove_object_from_layer, (linked_list_node *object_list_node, uint8_t layer_index),
-    linked_list_del_list_node(&engine_object_layers[layer_index], object_list_node);
+TRACE_DECL(void engine_remove_object_from_layer, (engine_node_base_t *node_base),
+    // Could be finalizing a node that failed to be added to a layer
+    if(node_base->layer >= engine_object_layer_count){
+        return;
+    }
+
+    engine_object_layer_t *layer = &engine_object_layers[node_base->layer];
+
+    if(node_base->object_index >= layer->count || layer->entries[node_base->object_index].node_base != node_base){
+        return;
+    }
+
+    layer->entries[node_base->object_index].node_base = NULL;
+    layer->node_count--;
+
+    // Nothing left, no holes to keep track of either
+    if(layer->node_count == 0){
+        layer->count = 0;
+        engine_object_layers_occupied[node_base->layer >> 5] &= ~(1u << (node_base->layer & 31));
+    }
 )
 
 
-// Go through all nodes and call their tick callbacks depending on the
-// node type. For example, some nodes will only have a 'tick()'
-// dt_s - delta time in seconds
-TRACE_DECL(void engine_invoke_all_node_tick_callbacks, (float dt_s),
-    linked_list_node *current_linked_list_node = NULL;
+void engine_object_layers_invalidate_tick_cb(engine_node_base_t *node_base){
+    // Same checks as `engine_remove_object_from_layer`, `tick` can be
+    // assigned before the node is in a layer or after it left one
+    if(node_base->layer >= engine_object_layer_count){
+        return;
+    }
 
-    for(uint16_t ilx=0; ilx<engine_object_layer_count; ilx++){
-        ENGINE_INFO_PRINTF("Starting ticking nodes in layer %d/%d", ilx, engine_object_layer_count-1);
+    engine_object_layer_t *layer = &engine_object_layers[node_base->layer];
 
-        current_linked_list_node = engine_object_layers[ilx].start;
+    if(node_base->object_index >= layer->count || layer->entries[node_base->object_index].node_base != node_base){
+        return;
+    }
 
-        while(current_linked_list_node != NULL){
-            // Get the base node that every node is stored under
-            engine_node_base_t *node_base = current_linked_list_node->object;
+    layer->entries[node_base->object_index].tick_cb = MP_OBJ_NULL;
+}
+
+
+// Reads `tick_cb` out of the node type specific struct. Only done the
+// first time a node is ticked and after `tick` is assigned again, the
+// copy in the layer entry is used otherwise
+static mp_obj_t engine_object_layers_resolve_tick_cb(engine_node_base_t *node_base){
+    switch(node_base->type){
+        case NODE_TYPE_EMPTY:
+            return ((engine_empty_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_CAMERA:
+            return ((engine_camera_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_VOXELSPACE:
+            return ((engine_voxelspace_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_VOXELSPACE_SPRITE:
+            return ((engine_voxelspace_sprite_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_MESH_3D:
+            return ((engine_mesh_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_RECTANGLE_2D:
+            return ((engine_rectangle_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_LINE_2D:
+            return ((engine_line_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_CIRCLE_2D:
+            return ((engine_circle_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_SPRITE_2D:
+            return ((engine_sprite_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_TEXT_2D:
+            return ((engine_text_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_GUI_BUTTON_2D:
+            return ((engine_gui_button_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_GUI_BITMAP_BUTTON_2D:
+            return ((engine_gui_bitmap_button_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_TILE_MAP_2D:
+            return ((engine_tile_map_2d_node_class_obj_t*)node_base->node)->tick_cb;
+        case NODE_TYPE_PHYSICS_RECTANGLE_2D:
+        case NODE_TYPE_PHYSICS_CIRCLE_2D:
+            return ((engine_physics_node_base_t*)node_base->node)->tick_cb;
+        default:
+            ENGINE_ERROR_PRINTF("This node type doesn't do anything? %d", node_base->type);
+            return mp_const_none;
+    }
+}
 
-            mp_obj_t exec[3];
 
-            switch(node_base->type){
-                case NODE_TYPE_EMPTY:
-                {
-                    engine_empty_node_class_obj_t *empty_node = node_base->node;
-                    if(empty_node->tick_cb != mp_const_none){
-                        exec[0] = empty_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_CAMERA:
-                {
-                    engine_camera_node_class_obj_t *camera_node = node_base->node;
-                    if(camera_node->tick_cb != mp_const_none){
-                        exec[0] = camera_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_VOXELSPACE:
-                {
-                    engine_voxelspace_node_class_obj_t *voxelspace_node= node_base->node;
-                    if(voxelspace_node->tick_cb != mp_const_none){
-                        exec[0] = voxelspace_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_VOXELSPACE_SPRITE:
-                {
-                    engine_voxelspace_sprite_node_class_obj_t *voxelspace_sprite_node= node_base->node;
-                    if(voxelspace_sprite_node->tick_cb != mp_const_none){
-                        exec[0] = voxelspace_sprite_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_MESH_3D:
-                {
-                    engine_mesh_node_class_obj_t *mesh_node = node_base->node;
-                    if(mesh_node->tick_cb != mp_const_none){
-                        exec[0] = mesh_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_RECTANGLE_2D:
-                {
-                    engine_rectangle_2d_node_class_obj_t *rectangle_2d_node = node_base->node;
-                    if(rectangle_2d_node->tick_cb != mp_const_none){
-                        exec[0] = rectangle_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_LINE_2D:
-                {
-                    engine_line_2d_node_class_obj_t *line_2d_node = node_base->node;
-                    if(line_2d_node->tick_cb != mp_const_none){
-                        exec[0] = line_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_CIRCLE_2D:
-                {
-                    engine_circle_2d_node_class_obj_t *circle_2d_node = node_base->node;
-                    if(circle_2d_node->tick_cb != mp_const_none){
-                        exec[0] = circle_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_SPRITE_2D:
-                {
-                    engine_sprite_2d_node_class_obj_t *sprite_2d_node = node_base->node;
-                    if(sprite_2d_node->tick_cb != mp_const_none){
-                        exec[0] = sprite_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_TEXT_2D:
-                {
-                    engine_text_2d_node_class_obj_t *text_2d_node = node_base->node;
-                    if(text_2d_node->tick_cb != mp_const_none){
-                        exec[0] = text_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_GUI_BUTTON_2D:
-                {
-                    engine_gui_button_2d_node_class_obj_t *button_2d_node = node_base->node;
-                    exec[1] = node_base->attr_accessor;
+// Buttons have focus/press callbacks on top of `tick`
+static void engine_object_layers_tick_gui_button(engine_node_base_t *node_base){
+    engine_gui_button_2d_node_class_obj_t *button_2d_node = node_base->node;
+    mp_obj_t exec[2];
+    exec[1] = node_base->attr_accessor;
 
-                    if(button_2d_node->tick_cb != mp_const_none){
-                        exec[0] = button_2d_node->tick_cb;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
+    if(button_2d_node->on_focused_cb != mp_const_none && button_2d_node->focused == true){
+        exec[0] = button_2d_node->on_focused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(button_2d_node->on_focused_cb != mp_const_none && button_2d_node->focused == true){
-                        exec[0] = button_2d_node->on_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(button_2d_node->on_just_focused_cb != mp_const_none && button_2d_node->last_focused == false && button_2d_node->focused == true){
+        exec[0] = button_2d_node->on_just_focused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(button_2d_node->on_just_focused_cb != mp_const_none && button_2d_node->last_focused == false && button_2d_node->focused == true){
-                        exec[0] = button_2d_node->on_just_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(button_2d_node->on_just_unfocused_cb != mp_const_none && button_2d_node->last_focused == true && button_2d_node->focused == false){
+        exec[0] = button_2d_node->on_just_unfocused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(button_2d_node->on_just_unfocused_cb != mp_const_none && button_2d_node->last_focused == true && button_2d_node->focused == false){
-                        exec[0] = button_2d_node->on_just_unfocused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(button_2d_node->on_pressed_cb != mp_const_none && button_2d_node->pressed == true){
+        exec[0] = button_2d_node->on_pressed_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(button_2d_node->on_pressed_cb != mp_const_none && button_2d_node->pressed == true){
-                        exec[0] = button_2d_node->on_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(button_2d_node->on_just_pressed_cb != mp_const_none && button_2d_node->last_pressed == false && button_2d_node->pressed == true){
+        exec[0] = button_2d_node->on_just_pressed_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(button_2d_node->on_just_pressed_cb != mp_const_none && button_2d_node->last_pressed == false && button_2d_node->pressed == true){
-                        exec[0] = button_2d_node->on_just_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(button_2d_node->on_just_released_cb != mp_const_none && button_2d_node->last_pressed == true && button_2d_node->pressed == false){
+        exec[0] = button_2d_node->on_just_released_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(button_2d_node->on_just_released_cb != mp_const_none && button_2d_node->last_pressed == true && button_2d_node->pressed == false){
-                        exec[0] = button_2d_node->on_just_released_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    // Save the state for tracking for callbacks
+    button_2d_node->last_pressed = button_2d_node->pressed;
+    button_2d_node->last_focused = button_2d_node->focused;
 
-                    // Save the state for tracking for callbacks
-                    button_2d_node->last_pressed = button_2d_node->pressed;
-                    button_2d_node->last_focused = button_2d_node->focused;
+    // After drawing everything, set pressed back to false.
+    // After this function is done looping through all the
+    // node callbacks, the gui tick is done again and it
+    // may be found that the button is still pressed but
+    // set to false anyways
+    button_2d_node->pressed = false;
+}
 
-                    // After drawing everything, set pressed back to false.
-                    // After this function is done looping through all the
-                    // node callbacks, the gui tick is done again and it
-                    // may be found that the button is still pressed but
-                    // set to false anyways
-                    button_2d_node->pressed = false;
-                }
-                break;
-                case NODE_TYPE_GUI_BITMAP_BUTTON_2D:
-                {
-                    engine_gui_bitmap_button_2d_node_class_obj_t *bitmap_button_2d_node = node_base->node;
-                    exec[1] = node_base->attr_accessor;
 
-                    if(bitmap_button_2d_node->tick_cb != mp_const_none){
-                        exec[0] = bitmap_button_2d_node->tick_cb;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
+static void engine_object_layers_tick_gui_bitmap_button(engine_node_base_t *node_base){
+    engine_gui_bitmap_button_2d_node_class_obj_t *bitmap_button_2d_node = node_base->node;
+    mp_obj_t exec[2];
+    exec[1] = node_base->attr_accessor;
 
-                    if(bitmap_button_2d_node->on_focused_cb != mp_const_none && bitmap_button_2d_node->focused == true){
-                        exec[0] = bitmap_button_2d_node->on_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(bitmap_button_2d_node->on_focused_cb != mp_const_none && bitmap_button_2d_node->focused == true){
+        exec[0] = bitmap_button_2d_node->on_focused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(bitmap_button_2d_node->on_just_focused_cb != mp_const_none && bitmap_button_2d_node->last_focused == false && bitmap_button_2d_node->focused == true){
-                        exec[0] = bitmap_button_2d_node->on_just_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(bitmap_button_2d_node->on_just_focused_cb != mp_const_none && bitmap_button_2d_node->last_focused == false && bitmap_button_2d_node->focused == true){
+        exec[0] = bitmap_button_2d_node->on_just_focused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(bitmap_button_2d_node->on_just_unfocused_cb != mp_const_none && bitmap_button_2d_node->last_focused == true && bitmap_button_2d_node->focused == false){
-                        exec[0] = bitmap_button_2d_node->on_just_unfocused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(bitmap_button_2d_node->on_just_unfocused_cb != mp_const_none && bitmap_button_2d_node->last_focused == true && bitmap_button_2d_node->focused == false){
+        exec[0] = bitmap_button_2d_node->on_just_unfocused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(bitmap_button_2d_node->on_pressed_cb != mp_const_none && bitmap_button_2d_node->pressed == true){
-                        exec[0] = bitmap_button_2d_node->on_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(bitmap_button_2d_node->on_pressed_cb != mp_const_none && bitmap_button_2d_node->pressed == true){
+        exec[0] = bitmap_button_2d_node->on_pressed_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(bitmap_button_2d_node->on_just_pressed_cb != mp_const_none && bitmap_button_2d_node->last_pressed == false && bitmap_button_2d_node->pressed == true){
-                        exec[0] = bitmap_button_2d_node->on_just_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(bitmap_button_2d_node->on_just_pressed_cb != mp_const_none && bitmap_button_2d_node->last_pressed == false && bitmap_button_2d_node->pressed == true){
+        exec[0] = bitmap_button_2d_node->on_just_pressed_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    if(bitmap_button_2d_node->on_just_released_cb != mp_const_none && bitmap_button_2d_node->last_pressed == true && bitmap_button_2d_node->pressed == false){
-                        exec[0] = bitmap_button_2d_node->on_just_released_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
+    if(bitmap_button_2d_node->on_just_released_cb != mp_const_none && bitmap_button_2d_node->last_pressed == true && bitmap_button_2d_node->pressed == false){
+        exec[0] = bitmap_button_2d_node->on_just_released_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
 
-                    // Save the state for tracking for callbacks
-                    bitmap_button_2d_node->last_pressed = bitmap_button_2d_node->pressed;
-                    bitmap_button_2d_node->last_focused = bitmap_button_2d_node->focused;
+    // Save the state for tracking for callbacks
+    bitmap_button_2d_node->last_pressed = bitmap_button_2d_node->pressed;
+    bitmap_button_2d_node->last_focused = bitmap_button_2d_node->focused;
 
-                    // After drawing everything, set pressed back to false.
-                    // After this function is done looping through all the
-                    // node callbacks, the gui tick is done again and it
-                    // may be found that the button is still pressed but
-                    // set to false anyways
-                    bitmap_button_2d_node->pressed = false;
-                }
-                break;
-                case NODE_TYPE_PHYSICS_RECTANGLE_2D:
-                {
-                    engine_physics_node_base_t *physics_node_base = node_base->node;
-                    if(physics_node_base->tick_cb != mp_const_none){
-                        exec[0] = physics_node_base->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_PHYSICS_CIRCLE_2D:
-                {
-                    engine_physics_node_base_t *physics_node_base = node_base->node;
-                    if(physics_node_base->tick_cb != mp_const_none){
-                        exec[0] = physics_node_base->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                default:
-                    ENGINE_ERROR_PRINTF("This node type doesn't do anything? %d", node_base->type);
-                break;
+    // After drawing everything, set pressed back to false.
+    // After this function is done looping through all the
+    // node callbacks, the gui tick is done again and it
+    // may be found that the button is still pressed but
+    // set to false anyways
+    bitmap_button_2d_node->pressed = false;
+}
+
+
+// Go through all nodes and call their tick callbacks depending on the
+// node type. For example, some nodes will only have a 'tick()'
+// dt_s - delta time in seconds
+TRACE_DECL(void engine_invoke_all_node_tick_callbacks, (float dt_s),
+    engine_object_layers_compact_all();
+    engine_object_layers_walking = true;
+
+    // Every callback gets the same `dt`, only box it once
+    mp_obj_t dt_obj = mp_obj_new_float(dt_s);
+    mp_obj_t exec[3];
+
+    for(int16_t ilx=engine_object_layers_next_occupied(-1); ilx!=-1; ilx=engine_object_layers_next_occupied(ilx)){
+        ENGINE_INFO_PRINTF("Starting ticking nodes in layer %d/%d", ilx, engine_object_layer_count-1);
+
+        engine_object_layer_t *layer = &engine_object_layers[ilx];
+
+        // Callbacks can add and remove nodes, `entries` may be
+        // reallocated and `count` may change after each of them
+        for(uint16_t enx=0; enx<layer->count; enx++){
+            engine_object_layer_entry_t *entry = &layer->entries[enx];
+            engine_node_base_t *node_base = entry->node_base;
+
+            if(node_base == NULL){
+                continue;
+            }
+
+            if(entry->tick_cb == MP_OBJ_NULL){
+                entry->tick_cb = engine_object_layers_resolve_tick_cb(node_base);
+            }
+
+            uint8_t type = entry->type;
+
+            if(entry->tick_cb != mp_const_none){
+                exec[0] = entry->tick_cb;
+                exec[1] = node_base->attr_accessor;
+                exec[2] = dt_obj;
+                mp_call_method_n_kw(1, 0, exec);
             }
 
-            current_linked_list_node = current_linked_list_node->next;
+            if(type == NODE_TYPE_GUI_BUTTON_2D){
+                engine_object_layers_tick_gui_button(node_base);
+            }else if(type == NODE_TYPE_GUI_BITMAP_BUTTON_2D){
+                engine_object_layers_tick_gui_bitmap_button(node_base);
+            }
         }
     }
 
+    engine_object_layers_walking = false;
+
     ENGINE_INFO_PRINTF("##### GAME TICKS COMPLETE #####\n");
 )
 
 
 TRACE_DECL(void engine_invoke_all_node_draw_callbacks, (),
-    linked_list_node *current_linked_list_node = NULL;
+    // Anything could have moved during the tick, absolute positions
+    // are resolved once for the whole draw pass after this
+    node_base_invalidate_transforms();
+    engine_camera_reset_cull_counters();
+
+    engine_object_layers_compact_all();
+    engine_object_layers_walking = true;
 
-    for(uint16_t ilx=0; ilx<engine_object_layer_count; ilx++){
+    for(int16_t ilx=engine_object_layers_next_occupied(-1); ilx!=-1; ilx=engine_object_layers_next_occupied(ilx)){
         ENGINE_INFO_PRINTF("Starting drawing nodes in layer %d/%d", ilx, engine_object_layer_count-1);
 
-        current_linked_list_node = engine_object_layers[ilx].start;
+        engine_object_layer_t *layer = &engine_object_layers[ilx];
 
-        while(current_linked_list_node != NULL){
+        for(uint16_t enx=0; enx<layer->count; enx++){
             // Get the base node that every node is stored under
-            engine_node_base_t *node_base = current_linked_list_node->object;
+            engine_node_base_t *node_base = layer->entries[enx].node_base;
 
-            switch(node_base->type){
+            if(node_base == NULL){
+                continue;
+            }
+
+            switch(layer->entries[enx].type){
                 case NODE_TYPE_EMPTY:
                 {
                     // Nothing but don't want to get to default case and error
@@ -391,27 +482,36 @@ TRACE_DECL(void engine_invoke_all_node_draw_callbacks, (),
                 break;
                 case NODE_TYPE_RECTANGLE_2D:
                 {
-                    engine_camera_draw_for_each(rectangle_2d_node_class_draw, node_base);
+                    engine_camera_draw_for_each_culled(rectangle_2d_node_class_draw, rectangle_2d_node_class_get_screen_radius, node_base);
                 }
                 break;
                 case NODE_TYPE_LINE_2D:
                 {
-                    engine_camera_draw_for_each(line_2d_node_class_draw, node_base);
+                    engine_camera_draw_for_each_culled(line_2d_node_class_draw, line_2d_node_class_get_screen_radius, node_base);
                 }
                 break;
                 case NODE_TYPE_CIRCLE_2D:
                 {
-                    engine_camera_draw_for_each(circle_2d_node_class_draw, node_base);
+                    engine_camera_draw_for_each_culled(circle_2d_node_class_draw, circle_2d_node_class_get_screen_radius, node_base);
                 }
                 break;
                 case NODE_TYPE_SPRITE_2D:
                 {
-                    engine_camera_draw_for_each(sprite_2d_node_class_draw, node_base);
+                    // Animations advance when drawn, keep them going off-screen too
+                    if(engine_camera_draw_for_each_culled(sprite_2d_node_class_draw, sprite_2d_node_class_get_screen_radius, node_base) == 0){
+                        sprite_2d_node_class_animate(node_base);
+                    }
                 }
                 break;
                 case NODE_TYPE_TEXT_2D:
                 {
-                    engine_camera_draw_for_each(text_2d_node_class_draw, node_base);
+                    engine_camera_draw_for_each_culled(text_2d_node_class_draw, text_2d_node_class_get_screen_radius, node_base);
+                }
+                break;
+                case NODE_TYPE_TILE_MAP_2D:
+                {
+                    // Only draws the tiles that are on screen itself
+                    engine_camera_draw_for_each(tile_map_2d_node_class_draw, node_base);
                 }
                 break;
                 case NODE_TYPE_GUI_BUTTON_2D:
@@ -439,10 +539,10 @@ TRACE_DECL(void engine_invoke_all_node_draw_callbacks, (),
                     ENGINE_ERROR_PRINTF("This node type doesn't do anything? %d", node_base->type);
                 break;
             }
-
-            current_linked_list_node = current_linked_list_node->next;
         }
     }
 
+    engine_object_layers_walking = false;
+
     ENGINE_INFO_PRINTF("##### GAME DRAWING COMPLETE #####\n");
 )
@@ -2,12 +2,17 @@
 #define ENGINE_OBJECT_LAYERS_H
 
 #include "utility/linked_list.h"
+#include "nodes/node_base.h"
 
 void engine_objects_clear_all();
 void engine_objects_clear_deletable();
 uint16_t engine_get_total_object_count();
-linked_list_node *engine_add_object_to_layer(void *obj, uint8_t layer_index);
-void engine_remove_object_from_layer(linked_list_node *object_list_node, uint8_t layer_index);
+void engine_add_object_to_layer(engine_node_base_t *node_base, uint8_t layer_index);
+void engine_remove_object_from_layer(engine_node_base_t *node_base);
+
+// The layers keep a copy of each node's tick callback, call
+// this after it changes so that it is read again next tick
+void engine_object_layers_invalidate_tick_cb(engine_node_base_t *node_base);
 
 void engine_invoke_all_node_tick_callbacks(float dt);
 void engine_invoke_all_node_draw_callbacks();
@@ -3,7 +3,9 @@
 #include "debug/debug_print.h"
 #include "draw/engine_display_draw.h"
 #include "draw/engine_shader.h"
+#include "draw/engine_draw_commands.h"
 #include "display/engine_display.h"
+#include "display/engine_display_common.h"
 #include "math/engine_math.h"
 #include "resources/engine_font_resource.h"
 
@@ -22,6 +24,10 @@ void engine_fault_report(uint32_t lr, uint32_t pc){
     // https://wbk.one/%2Farticle%2F6%2Fdebugging-arm-without-a-debugger-3-printing-stack-trace#:~:text=pc%20(program%20counter)
     ENGINE_PRINTF("HARD_FAULT ERROR: LR=%ld, PC=%ld\n", lr, pc);
 
+    // Draw directly (the render core may be what faulted) and
+    // send the whole fault screen no matter what the game set
+    engine_draw_commands_halt();
+    engine_display_set_damage_tracking(false);
     engine_draw_fill_color(0b0000000000011111, active_screen_buffer);
 
     char message[128] = { 0 };
@@ -24,6 +24,13 @@
 #define min3(a,b,c)         min(min(a, b), c)
 #define max3(a,b,c)         max(max(a, b), c)
 
+// 16.16 fixed-point helpers for rasterizer inner loops. Shifting
+// right floors negative values too (arithmetic shift on our targets)
+#define ENGINE_FIXED_SHIFT          16
+#define ENGINE_FIXED_ONE            (1 << ENGINE_FIXED_SHIFT)
+#define ENGINE_FLOAT_TO_FIXED(v)    ((int32_t)((v) * (float)ENGINE_FIXED_ONE))
+#define ENGINE_FIXED_TO_INT(v)      ((v) >> ENGINE_FIXED_SHIFT)
+
 uint32_t engine_math_rand_int(uint32_t max);
 
 float engine_math_dot_product(float x0, float y0, float x1, float y1);
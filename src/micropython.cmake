@@ -16,6 +16,7 @@ target_sources(usermod_engine INTERFACE
     ${ENGINE_MOD_DIR}/draw/engine_draw_module.c
     ${ENGINE_MOD_DIR}/draw/engine_color.c
     ${ENGINE_MOD_DIR}/draw/engine_shader.c
+    ${ENGINE_MOD_DIR}/draw/engine_draw_commands.c
     ${ENGINE_MOD_DIR}/math/engine_math_module.c
     ${ENGINE_MOD_DIR}/nodes/engine_nodes_module.c
     ${ENGINE_MOD_DIR}/io/engine_io_module.c
@@ -37,6 +38,7 @@ target_sources(usermod_engine INTERFACE
     ${ENGINE_MOD_DIR}/nodes/2D/text_2d_node.c
     ${ENGINE_MOD_DIR}/nodes/2D/gui_button_2d_node.c
     ${ENGINE_MOD_DIR}/nodes/2D/gui_bitmap_button_2d_node.c
+    ${ENGINE_MOD_DIR}/nodes/2D/tile_map_2d_node.c
     ${ENGINE_MOD_DIR}/math/vector3.c
     ${ENGINE_MOD_DIR}/math/matrix4x4.c
     ${ENGINE_MOD_DIR}/math/vector2.c
@@ -92,6 +94,14 @@ target_include_directories(usermod_engine INTERFACE
 
 # target_link_libraries(usermod_engine INTERFACE -llfs2)
 
+# Route every flash erase/program (MicroPython's filesystem included)
+# through `engine_draw_commands.c` so the render core is never running
+# from flash while it is written
+target_link_options(usermod_engine INTERFACE
+    -Wl,--wrap=flash_range_erase
+    -Wl,--wrap=flash_range_program
+)
+
 
 # Link our INTERFACE library to the usermod target.
 target_link_libraries(usermod INTERFACE usermod_engine)
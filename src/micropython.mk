@@ -12,6 +12,7 @@ SRC_USERMOD += $(ENGINE_MOD_DIR)/math/engine_math.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/draw/engine_draw_module.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/draw/engine_color.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/draw/engine_shader.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/draw/engine_draw_commands.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/math/engine_math_module.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/nodes/engine_nodes_module.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/io/engine_io_buttons.c
@@ -33,6 +34,7 @@ SRC_USERMOD += $(ENGINE_MOD_DIR)/nodes/2D/physics_circle_2d_node.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/nodes/2D/text_2d_node.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/nodes/2D/gui_button_2d_node.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/nodes/2D/gui_bitmap_button_2d_node.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/nodes/2D/tile_map_2d_node.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/math/vector3.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/math/matrix4x4.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/math/vector2.c
@@ -13,6 +13,12 @@
 #include "draw/engine_shader.h"
 
 
+float circle_2d_node_class_get_screen_radius(engine_node_base_t *circle_node_base, float camera_zoom){
+    engine_circle_2d_node_class_obj_t *circle_2d_node = circle_node_base->node;
+    return fabsf(mp_obj_get_float(circle_2d_node->radius) * mp_obj_get_float(circle_2d_node->scale) * camera_zoom);
+}
+
+
 void circle_2d_node_class_draw(mp_obj_t circle_node_base_obj, mp_obj_t camera_node){
     ENGINE_INFO_PRINTF("Circle2DNode: Drawing");
 
@@ -19,6 +19,7 @@ typedef struct{
 
 extern const mp_obj_type_t engine_circle_2d_node_class_type;
 void circle_2d_node_class_draw(mp_obj_t circle_node_base_obj, mp_obj_t camera_node);
+float circle_2d_node_class_get_screen_radius(engine_node_base_t *circle_node_base, float camera_zoom);
 
 
 #endif  // CIRCLE_2D_NODE_H
@@ -125,13 +125,7 @@ void gui_bitmap_button_2d_node_class_draw(mp_obj_t button_node_base_obj, mp_obj_
             text_shader = engine_get_builtin_shader(EMPTY_SHADER);
         }else{
             text_shader = engine_get_builtin_shader(BLEND_OPACITY_SHADER);
-
-            float t = 1.0f;
-
-            text_shader->program[1] = (text_color->value >> 8) & 0b11111111;
-            text_shader->program[2] = (text_color->value >> 0) & 0b11111111;
-
-            memcpy(text_shader->program+3, &t, sizeof(float));
+            engine_shader_set_rgb_interpolate(text_shader, text_color->value, 1.0f);
         }
 
         engine_draw_text(font, button->text,
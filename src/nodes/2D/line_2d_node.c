@@ -14,6 +14,23 @@
 #include "draw/engine_shader.h"
 
 
+// The line is drawn as a rectangle centered on its midpoint
+float line_2d_node_class_get_screen_radius(engine_node_base_t *line_node_base, float camera_zoom){
+    engine_line_2d_node_class_obj_t *line_2d = line_node_base->node;
+    vector2_class_obj_t *line_start = line_2d->start;
+    vector2_class_obj_t *line_end = line_2d->end;
+
+    float line_thickness = mp_obj_get_float(line_2d->thickness) * camera_zoom;
+    float line_length = engine_math_distance_between(line_start->x.value, line_start->y.value, line_end->x.value, line_end->y.value) * camera_zoom;
+
+    if(line_thickness < 1.0f){
+        line_thickness = 1.0f;
+    }
+
+    return engine_math_distance_between(0.0f, 0.0f, line_thickness, line_length) * 0.5f;
+}
+
+
 void line_2d_node_class_draw(mp_obj_t line_node_base_obj, mp_obj_t camera_node){
     ENGINE_INFO_PRINTF("Line2DNode: Drawing");
 
@@ -19,5 +19,6 @@ typedef struct{
 
 extern const mp_obj_type_t engine_line_2d_node_class_type;
 void line_2d_node_class_draw(mp_obj_t line_node_base_obj, mp_obj_t camera_node);
+float line_2d_node_class_get_screen_radius(engine_node_base_t *line_node_base, float camera_zoom);
 
 #endif  // LINE_2D_NODE_H
@@ -35,7 +35,7 @@ void physics_circle_2d_node_class_draw(mp_obj_t circle_node_base_obj, mp_obj_t c
     rectangle_class_obj_t *camera_viewport = camera->viewport;
     float camera_zoom = mp_obj_get_float(camera->zoom);
 
-    float circle_radius =  mp_obj_get_float(physics_circle_2d_node->radius);
+    float circle_radius = physics_circle_2d_node->radius;
     uint16_t color = 0xffff;
 
     if(physics_node_base->outline_color != mp_const_none){
@@ -106,7 +106,7 @@ void physics_circle_2d_calculate_inverse_mass(engine_node_base_t *node_base){
     engine_physics_node_base_t *physics_node_base = node_base->node;
     engine_physics_circle_2d_node_class_obj_t *physics_circle = physics_node_base->unique_data;
 
-    float radius = mp_obj_get_float(physics_circle->radius);
+    float radius = physics_circle->radius;
     float density = mp_obj_get_float(physics_node_base->density);
     float area = PI * radius*radius;
     physics_node_base->mass = density * area;
@@ -124,7 +124,7 @@ void physics_circle_2d_calculate_inverse_inertia(engine_node_base_t *node_base){
     engine_physics_node_base_t *physics_node_base = node_base->node;
     engine_physics_circle_2d_node_class_obj_t *physics_circle = physics_node_base->unique_data;
 
-    float radius = mp_obj_get_float(physics_circle->radius);
+    float radius = physics_circle->radius;
     float mass = physics_node_base->mass;
 
     // https://www.concepts-of-physics.com/mechanics/moment-of-inertia.php#:~:text=Moment%20of%20Inertia%20of%20Common%20Shapes
@@ -149,7 +149,7 @@ bool physics_circle_2d_load_attr(engine_node_base_t *self_node_base, qstr attrib
             return true;
         break;
         case MP_QSTR_radius:
-            destination[0] = self->radius;
+            destination[0] = mp_obj_new_float(self->radius);
             return true;
         break;
         default:
@@ -166,7 +166,7 @@ bool physics_circle_2d_store_attr(engine_node_base_t *self_node_base, qstr attri
 
     switch(attribute){
         case MP_QSTR_radius:
-            self->radius = destination[1];
+            self->radius = mp_obj_get_float(destination[1]);
 
             // As the radius changes so does the mass due to density
             physics_circle_2d_calculate_inverse_mass(self_node_base);
@@ -302,10 +302,10 @@ mp_obj_t physics_circle_2d_node_class_new(const mp_obj_type_t *type, size_t n_ar
     physics_node_base->angular_velocity = mp_obj_get_float(parsed_args[angular_velocity].u_obj);
     physics_node_base->rotation = mp_obj_get_float(parsed_args[rotation].u_obj);
     physics_node_base->density = parsed_args[density].u_obj;
-    physics_node_base->friction = parsed_args[friction].u_obj;
-    physics_node_base->bounciness = parsed_args[bounciness].u_obj;
-    physics_node_base->dynamic = parsed_args[dynamic].u_obj;
-    physics_node_base->solid = parsed_args[solid].u_obj;
+    physics_node_base->friction = mp_obj_get_float(parsed_args[friction].u_obj);
+    physics_node_base->bounciness = mp_obj_get_float(parsed_args[bounciness].u_obj);
+    physics_node_base->dynamic = mp_obj_get_int(parsed_args[dynamic].u_obj);
+    physics_node_base->solid = mp_obj_get_int(parsed_args[solid].u_obj);
     physics_node_base->gravity_scale = parsed_args[gravity_scale].u_obj;
     physics_node_base->outline = parsed_args[outline].u_obj;
     physics_node_base->outline_color = parsed_args[outline_color].u_obj;
@@ -327,7 +327,7 @@ mp_obj_t physics_circle_2d_node_class_new(const mp_obj_type_t *type, size_t n_ar
     physics_node_base->was_colliding = false;
     physics_node_base->colliding = false;
 
-    physics_circle_2d_node->radius = parsed_args[radius].u_obj;
+    physics_circle_2d_node->radius = mp_obj_get_float(parsed_args[radius].u_obj);
 
     physics_circle_2d_calculate_inverse_mass(node_base);
     physics_circle_2d_calculate_inverse_inertia(node_base);
@@ -8,7 +8,7 @@
 
 
 typedef struct{
-    mp_obj_t radius;                        // Radius of the collider
+    float radius;                           // Radius of the collider
 }engine_physics_circle_2d_node_class_obj_t;
 
 
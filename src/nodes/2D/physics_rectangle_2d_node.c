@@ -32,8 +32,8 @@ void physics_rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_o
     engine_node_base_t *camera_node_base = camera_node;
     engine_camera_node_class_obj_t *camera = camera_node_base->node;
 
-    float rectangle_width = mp_obj_get_float(physics_rectangle_2d_node->width);
-    float rectangle_height = mp_obj_get_float(physics_rectangle_2d_node->height);
+    float rectangle_width = physics_rectangle_2d_node->width;
+    float rectangle_height = physics_rectangle_2d_node->height;
     uint16_t color = 0xffff;
 
     if(physics_node_base->outline_color != mp_const_none){
@@ -114,8 +114,8 @@ void physics_rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_o
 void engine_physics_rectangle_2d_node_calculate(engine_physics_node_base_t *physics_node_base, float *vertices_x, float *vertices_y, float *normals_x, float *normals_y, float rotation){
     engine_physics_rectangle_2d_node_class_obj_t *self = physics_node_base->unique_data;
 
-    float half_width = mp_obj_get_float(self->width) * 0.5f;
-    float half_height = mp_obj_get_float(self->height) * 0.5f;
+    float half_width = self->width * 0.5f;
+    float half_height = self->height * 0.5f;
 
     float x_traversal_cos = cosf(rotation) * half_width;
     float x_traversal_sin = sinf(rotation) * half_width;
@@ -201,7 +201,7 @@ mp_obj_t physics_rectangle_2d_node_class_adjust_from_to(mp_obj_t self_in, mp_obj
     float length = engine_math_distance_between(from->x.value, from->y.value, to->x.value, to->y.value);
     float rotation = engine_math_angle_between(from->x.value, -from->y.value, to->x.value, -to->y.value) - HALF_PI;
 
-    node->height = mp_obj_new_float(length);
+    node->height = length;
     physics_node_base->rotation = rotation;
     position->x.value = mid_x;
     position->y.value = mid_y;
@@ -215,8 +215,8 @@ void physics_rectangle_2d_calculate_inverse_mass(engine_node_base_t *node_base){
     engine_physics_node_base_t *physics_node_base = node_base->node;
     engine_physics_rectangle_2d_node_class_obj_t *physics_rectangle = physics_node_base->unique_data;
 
-    float width = mp_obj_get_float(physics_rectangle->width);
-    float height = mp_obj_get_float(physics_rectangle->height);
+    float width = physics_rectangle->width;
+    float height = physics_rectangle->height;
     float density = mp_obj_get_float(physics_node_base->density);
     float area = width * height;
     physics_node_base->mass = density * area;
@@ -234,8 +234,8 @@ void physics_rectangle_2d_calculate_inverse_inertia(engine_node_base_t *node_bas
     engine_physics_node_base_t *physics_node_base = node_base->node;
     engine_physics_rectangle_2d_node_class_obj_t *physics_rectangle = physics_node_base->unique_data;
 
-    float width = mp_obj_get_float(physics_rectangle->width);
-    float height = mp_obj_get_float(physics_rectangle->height);
+    float width = physics_rectangle->width;
+    float height = physics_rectangle->height;
     float mass = physics_node_base->mass;
 
     // https://www.concepts-of-physics.com/mechanics/moment-of-inertia.php#:~:text=Moment%20of%20Inertia%20of%20Common%20Shapes
@@ -265,11 +265,11 @@ bool physics_rectangle_2d_load_attr(engine_node_base_t *self_node_base, qstr att
             return true;
         break;
         case MP_QSTR_width:
-            destination[0] = self->width;
+            destination[0] = mp_obj_new_float(self->width);
             return true;
         break;
         case MP_QSTR_height:
-            destination[0] = self->height;
+            destination[0] = mp_obj_new_float(self->height);
             return true;
         break;
         default:
@@ -286,7 +286,7 @@ bool physics_rectangle_2d_store_attr(engine_node_base_t *self_node_base, qstr at
 
     switch(attribute){
         case MP_QSTR_width:
-            self->width = destination[1];
+            self->width = mp_obj_get_float(destination[1]);
 
             // As the dimensions change so does the mass due to density
             physics_rectangle_2d_calculate_inverse_mass(self_node_base);
@@ -294,7 +294,7 @@ bool physics_rectangle_2d_store_attr(engine_node_base_t *self_node_base, qstr at
             return true;
         break;
         case MP_QSTR_height:
-            self->height = destination[1];
+            self->height = mp_obj_get_float(destination[1]);
 
             // As the dimensions change so does the mass due to density
             physics_rectangle_2d_calculate_inverse_mass(self_node_base);
@@ -439,10 +439,10 @@ mp_obj_t physics_rectangle_2d_node_class_new(const mp_obj_type_t *type, size_t n
     physics_node_base->angular_velocity = mp_obj_get_float(parsed_args[angular_velocity].u_obj);
     physics_node_base->rotation = mp_obj_get_float(parsed_args[rotation].u_obj);
     physics_node_base->density = parsed_args[density].u_obj;
-    physics_node_base->friction = parsed_args[friction].u_obj;
-    physics_node_base->bounciness = parsed_args[bounciness].u_obj;
-    physics_node_base->dynamic = parsed_args[dynamic].u_obj;
-    physics_node_base->solid = parsed_args[solid].u_obj;
+    physics_node_base->friction = mp_obj_get_float(parsed_args[friction].u_obj);
+    physics_node_base->bounciness = mp_obj_get_float(parsed_args[bounciness].u_obj);
+    physics_node_base->dynamic = mp_obj_get_int(parsed_args[dynamic].u_obj);
+    physics_node_base->solid = mp_obj_get_int(parsed_args[solid].u_obj);
     physics_node_base->gravity_scale = parsed_args[gravity_scale].u_obj;
     physics_node_base->outline = parsed_args[outline].u_obj;
     physics_node_base->outline_color = parsed_args[outline_color].u_obj;
@@ -464,8 +464,8 @@ mp_obj_t physics_rectangle_2d_node_class_new(const mp_obj_type_t *type, size_t n
     physics_node_base->on_collide_cb = mp_const_none;
     physics_node_base->on_separate_cb = mp_const_none;
 
-    physics_rectangle_2d_node->width = parsed_args[width].u_obj;
-    physics_rectangle_2d_node->height = parsed_args[height].u_obj;
+    physics_rectangle_2d_node->width = mp_obj_get_float(parsed_args[width].u_obj);
+    physics_rectangle_2d_node->height = mp_obj_get_float(parsed_args[height].u_obj);
 
     physics_rectangle_2d_calculate_inverse_mass(node_base);
     physics_rectangle_2d_calculate_inverse_inertia(node_base);
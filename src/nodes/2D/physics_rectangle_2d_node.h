@@ -9,8 +9,8 @@
 
 
 typedef struct{
-    mp_obj_t width;                 // Width of the collider
-    mp_obj_t height;                // Height of the collider
+    float width;                    // Width of the collider
+    float height;                   // Height of the collider
 }engine_physics_rectangle_2d_node_class_obj_t;
 
 
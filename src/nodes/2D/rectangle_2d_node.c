@@ -13,6 +13,24 @@
 #include "draw/engine_shader.h"
 
 
+// Half of the diagonal of the rectangle as drawn (see the
+// filled and outlined branches in the draw callback below)
+float rectangle_2d_node_class_get_screen_radius(engine_node_base_t *rectangle_node_base, float camera_zoom){
+    engine_rectangle_2d_node_class_obj_t *rectangle_2d_node = rectangle_node_base->node;
+
+    float rectangle_width = mp_obj_get_float(rectangle_2d_node->width) * camera_zoom;
+    float rectangle_height = mp_obj_get_float(rectangle_2d_node->height) * camera_zoom;
+
+    if(mp_obj_get_int(rectangle_2d_node->outline) == false){
+        vector2_class_obj_t *rectangle_scale = rectangle_2d_node->scale;
+        rectangle_width *= fabsf(rectangle_scale->x.value) * camera_zoom;
+        rectangle_height *= fabsf(rectangle_scale->y.value) * camera_zoom;
+    }
+
+    return engine_math_distance_between(0.0f, 0.0f, rectangle_width, rectangle_height) * 0.5f;
+}
+
+
 void rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_obj_t camera_node){
     ENGINE_INFO_PRINTF("Rectangle2DNode: Drawing");
 
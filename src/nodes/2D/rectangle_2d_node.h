@@ -19,6 +19,7 @@ typedef struct{
 
 extern const mp_obj_type_t engine_rectangle_2d_node_class_type;
 void rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_obj_t camera_node);
+float rectangle_2d_node_class_get_screen_radius(engine_node_base_t *rectangle_node_base, float camera_zoom);
 
 
 #endif  // RECTANGLE_2D_NODE_H
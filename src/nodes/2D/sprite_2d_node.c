@@ -35,6 +35,79 @@ void sprite_2d_node_clamp_current_y(engine_sprite_2d_node_class_obj_t *sprite){
 }
 
 
+void sprite_2d_node_class_animate(engine_node_base_t *sprite_node_base){
+    engine_sprite_2d_node_class_obj_t *sprite_2d_node = sprite_node_base->node;
+
+    bool sprite_playing = mp_obj_get_int(sprite_2d_node->playing);
+    bool sprite_looping = mp_obj_get_int(sprite_2d_node->loop);
+
+    uint16_t sprite_frame_count_x = mp_obj_get_int(sprite_2d_node->frame_count_x);
+    uint16_t sprite_frame_count_y = mp_obj_get_int(sprite_2d_node->frame_count_y);
+    uint16_t sprite_frame_current_x = mp_obj_get_int(sprite_2d_node->frame_current_x);
+    uint16_t sprite_frame_current_y = mp_obj_get_int(sprite_2d_node->frame_current_y);
+
+    if(sprite_playing == true){
+        float sprite_fps = mp_obj_get_float(mp_load_attr(sprite_node_base->attr_accessor, MP_QSTR_fps));
+        uint16_t sprite_period = (uint16_t)((1.0f/sprite_fps) * 1000.0f);
+
+        uint32_t current_ms_time = millis();
+        if(millis_diff(current_ms_time, sprite_2d_node->time_at_last_animation_update_ms) >= sprite_period){
+            sprite_frame_current_x++;
+
+            // If reach end of x-axis frames, go to the next line and restart x
+            if(sprite_frame_current_x >= sprite_frame_count_x){
+                sprite_frame_current_x = 0;
+                sprite_frame_current_y++;
+            }
+
+            bool increment_frame = true;
+
+            // If reach end of y-axis frames, restart at x=0 and y=0
+            if(sprite_frame_current_y >= sprite_frame_count_y){
+                sprite_frame_current_y = 0;
+
+                if(sprite_looping == false){
+                    mp_store_attr(sprite_node_base->attr_accessor, MP_QSTR_playing, mp_obj_new_bool(false));
+
+                    // Reached the end and looping is false, do not increment frame
+                    increment_frame = false;
+                }
+            }
+
+            // Update/store the current frame index only if looping
+            // so that we stay on the last from when loop ends
+            if(increment_frame){
+                mp_store_attr(sprite_node_base->attr_accessor, MP_QSTR_frame_current_x, mp_obj_new_int(sprite_frame_current_x));
+                mp_store_attr(sprite_node_base->attr_accessor, MP_QSTR_frame_current_y, mp_obj_new_int(sprite_frame_current_y));
+            }
+
+            sprite_2d_node->time_at_last_animation_update_ms = millis();
+        }
+    }
+}
+
+
+// Half of the diagonal of one scaled frame of the spritesheet
+float sprite_2d_node_class_get_screen_radius(engine_node_base_t *sprite_node_base, float camera_zoom){
+    engine_sprite_2d_node_class_obj_t *sprite_2d_node = sprite_node_base->node;
+
+    if(sprite_2d_node->texture_resource == mp_const_none){
+        return 0.0f;
+    }
+
+    texture_resource_class_obj_t *sprite_texture = sprite_2d_node->texture_resource;
+    vector2_class_obj_t *sprite_scale = sprite_2d_node->scale;
+
+    float sprite_frame_width = (float)(sprite_texture->width / mp_obj_get_int(sprite_2d_node->frame_count_x));
+    float sprite_frame_height = (float)(sprite_texture->height / mp_obj_get_int(sprite_2d_node->frame_count_y));
+
+    sprite_frame_width *= fabsf(sprite_scale->x.value) * camera_zoom;
+    sprite_frame_height *= fabsf(sprite_scale->y.value) * camera_zoom;
+
+    return engine_math_distance_between(0.0f, 0.0f, sprite_frame_width, sprite_frame_height) * 0.5f;
+}
+
+
 void sprite_2d_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t camera_node){
     ENGINE_INFO_PRINTF("Sprite2DNode: Drawing");
 
@@ -64,8 +137,6 @@ void sprite_2d_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t camera_no
     uint16_t sprite_frame_count_y = mp_obj_get_int(sprite_2d_node->frame_count_y);
     uint16_t sprite_frame_current_x = mp_obj_get_int(sprite_2d_node->frame_current_x);
     uint16_t sprite_frame_current_y = mp_obj_get_int(sprite_2d_node->frame_current_y);
-    bool sprite_playing = mp_obj_get_int(sprite_2d_node->playing);
-    bool sprite_looping = mp_obj_get_int(sprite_2d_node->loop);
 
     color_class_obj_t *transparent_color = sprite_2d_node->transparent_color;
     uint32_t spritesheet_width = sprite_texture->width;
@@ -129,44 +200,7 @@ void sprite_2d_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t camera_no
                      shader);
 
     // After drawing, go to the next frame if it is time to and the animation is playing
-    if(sprite_playing == true){
-        float sprite_fps = mp_obj_get_float(mp_load_attr(sprite_node_base->attr_accessor, MP_QSTR_fps));
-        uint16_t sprite_period = (uint16_t)((1.0f/sprite_fps) * 1000.0f);
-
-        uint32_t current_ms_time = millis();
-        if(millis_diff(current_ms_time, sprite_2d_node->time_at_last_animation_update_ms) >= sprite_period){
-            sprite_frame_current_x++;
-
-            // If reach end of x-axis frames, go to the next line and restart x
-            if(sprite_frame_current_x >= sprite_frame_count_x){
-                sprite_frame_current_x = 0;
-                sprite_frame_current_y++;
-            }
-
-            bool increment_frame = true;
-
-            // If reach end of y-axis frames, restart at x=0 and y=0
-            if(sprite_frame_current_y >= sprite_frame_count_y){
-                sprite_frame_current_y = 0;
-
-                if(sprite_looping == false){
-                    mp_store_attr(sprite_node_base->attr_accessor, MP_QSTR_playing, mp_obj_new_bool(false));
-
-                    // Reached the end and looping is false, do not increment frame
-                    increment_frame = false;
-                }
-            }
-
-            // Update/store the current frame index only if looping
-            // so that we stay on the last from when loop ends
-            if(increment_frame){
-                mp_store_attr(sprite_node_base->attr_accessor, MP_QSTR_frame_current_x, mp_obj_new_int(sprite_frame_current_x));
-                mp_store_attr(sprite_node_base->attr_accessor, MP_QSTR_frame_current_y, mp_obj_new_int(sprite_frame_current_y));
-            }
-
-            sprite_2d_node->time_at_last_animation_update_ms = millis();
-        }
-    }
+    sprite_2d_node_class_animate(sprite_node_base);
 }
 
 
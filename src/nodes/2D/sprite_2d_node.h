@@ -25,5 +25,9 @@ typedef struct{
 
 extern const mp_obj_type_t engine_sprite_2d_node_class_type;
 void sprite_2d_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t camera_node);
+float sprite_2d_node_class_get_screen_radius(engine_node_base_t *sprite_node_base, float camera_zoom);
+
+// Goes to the next frame if it is time to and the animation is playing
+void sprite_2d_node_class_animate(engine_node_base_t *sprite_node_base);
 
 #endif  // SPRITE_2D_NODE_H
\ No newline at end of file
@@ -20,6 +20,18 @@
 #include <string.h>
 
 
+// Half of the diagonal of the scaled text box
+float text_2d_node_class_get_screen_radius(engine_node_base_t *text_2d_node_base, float camera_zoom){
+    engine_text_2d_node_class_obj_t *text_2d_node = text_2d_node_base->node;
+    vector2_class_obj_t *text_scale = text_2d_node->scale;
+
+    float text_box_width = mp_obj_get_float(text_2d_node->width) * fabsf(text_scale->x.value) * camera_zoom;
+    float text_box_height = mp_obj_get_float(text_2d_node->height) * fabsf(text_scale->y.value) * camera_zoom;
+
+    return engine_math_distance_between(0.0f, 0.0f, text_box_width, text_box_height) * 0.5f;
+}
+
+
 void text_2d_node_class_draw(mp_obj_t text_2d_node_base_obj, mp_obj_t camera_node){
     ENGINE_INFO_PRINTF("Text2DNode: Drawing");
 
@@ -95,13 +107,7 @@ void text_2d_node_class_draw(mp_obj_t text_2d_node_base_obj, mp_obj_t camera_nod
 
     if(text_color != mp_const_none){
         text_shader = engine_get_builtin_shader(BLEND_OPACITY_SHADER);
-
-        float t = 1.0f;
-
-        text_shader->program[1] = (text_color->value >> 8) & 0b11111111;
-        text_shader->program[2] = (text_color->value >> 0) & 0b11111111;
-
-        memcpy(text_shader->program+3, &t, sizeof(float));
+        engine_shader_set_rgb_interpolate(text_shader, text_color->value, 1.0f);
     }else
     if(text_opacity < 1.0f || text_font->texture_resource->alpha_mask != 0){
         text_shader = engine_get_builtin_shader(OPACITY_SHADER);
@@ -22,6 +22,7 @@ typedef struct{
 
 extern const mp_obj_type_t engine_text_2d_node_class_type;
 void text_2d_node_class_draw(mp_obj_t text_2d_node_base_obj, mp_obj_t camera_node);
+float text_2d_node_class_get_screen_radius(engine_node_base_t *text_2d_node_base, float camera_zoom);
 mp_obj_t text_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
 #endif  // TEXT_2D_NODE_H
\ No newline at end of file
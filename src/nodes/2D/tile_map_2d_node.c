@@ -0,0 +1,835 @@
+#include "tile_map_2d_node.h"
+
+#include "nodes/node_types.h"
+#include "debug/debug_print.h"
+#include "engine_object_layers.h"
+#include "nodes/3D/camera_node.h"
+#include "math/vector2.h"
+#include "math/rectangle.h"
+#include "draw/engine_display_draw.h"
+#include "display/engine_display_common.h"
+#include "resources/engine_texture_resource.h"
+#include "math/engine_math.h"
+#include "draw/engine_color.h"
+#include "draw/engine_shader.h"
+#include "py/obj.h"
+#include "py/objarray.h"
+#include <float.h>
+
+
+// Everything about the map and atlas needed to draw or bake tiles,
+// resolved once per draw instead of per tile
+typedef struct{
+    texture_resource_class_obj_t *atlas;
+    mp_buffer_info_t tiles;
+    uint16_t columns;
+    uint16_t rows;
+    uint16_t tile_width;
+    uint16_t tile_height;
+    uint16_t atlas_columns;
+    uint32_t atlas_tile_count;
+}tile_map_2d_node_layout_t;
+
+
+// Gets the `tiles` buffer and the size of the map in tiles. Maps
+// without tiles (or with `columns` of 0) have 0 rows
+static void tile_map_2d_node_get_grid(engine_tile_map_2d_node_class_obj_t *tile_map, mp_buffer_info_t *tiles, uint16_t *columns, uint16_t *rows, mp_uint_t flags){
+    *columns = 0;
+    *rows = 0;
+
+    if(tile_map->tiles == mp_const_none){
+        return;
+    }
+
+    mp_get_buffer_raise(tile_map->tiles, tiles, flags);
+
+    switch(tiles->typecode){
+        case BYTEARRAY_TYPECODE:
+        case 'B':
+        case 'b':
+        case 'H':
+        case 'h':
+        break;
+        default:
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("TileMap2DNode: ERROR: Expected `tiles` to be a bytearray or an array of type 'B' or 'H'"));
+    }
+
+    mp_int_t column_count = mp_obj_get_int(tile_map->columns);
+    if(column_count <= 0){
+        return;
+    }
+
+    uint8_t tile_size = (tiles->typecode == 'H' || tiles->typecode == 'h') ? 2 : 1;
+
+    *columns = column_count;
+    *rows = (tiles->len / tile_size) / column_count;
+}
+
+
+static inline uint16_t tile_map_2d_node_read_tile(mp_buffer_info_t *tiles, uint32_t index){
+    if(tiles->typecode == 'H' || tiles->typecode == 'h'){
+        return ((uint16_t*)tiles->buf)[index];
+    }else{
+        return ((uint8_t*)tiles->buf)[index];
+    }
+}
+
+
+static inline void tile_map_2d_node_write_tile(mp_buffer_info_t *tiles, uint32_t index, uint16_t tile){
+    if(tiles->typecode == 'H' || tiles->typecode == 'h'){
+        ((uint16_t*)tiles->buf)[index] = tile;
+    }else{
+        ((uint8_t*)tiles->buf)[index] = tile;
+    }
+}
+
+
+// Returns `false` if there is nothing that could be drawn
+static bool tile_map_2d_node_get_layout(engine_tile_map_2d_node_class_obj_t *tile_map, tile_map_2d_node_layout_t *layout){
+    if(tile_map->texture_resource == mp_const_none){
+        return false;
+    }
+
+    tile_map_2d_node_get_grid(tile_map, &layout->tiles, &layout->columns, &layout->rows, MP_BUFFER_READ);
+
+    if(layout->columns == 0 || layout->rows == 0){
+        return false;
+    }
+
+    layout->atlas = tile_map->texture_resource;
+    layout->tile_width = mp_obj_get_int(tile_map->tile_width);
+    layout->tile_height = mp_obj_get_int(tile_map->tile_height);
+
+    if(layout->tile_width == 0 || layout->tile_height == 0){
+        return false;
+    }
+
+    layout->atlas_columns = layout->atlas->width / layout->tile_width;
+    layout->atlas_tile_count = layout->atlas_columns * (layout->atlas->height / layout->tile_height);
+
+    return layout->atlas_tile_count > 0;
+}
+
+
+// Offset of the top-left pixel of `tile` (1 is the first atlas tile) in the atlas
+static inline uint32_t tile_map_2d_node_atlas_offset(tile_map_2d_node_layout_t *layout, uint16_t tile){
+    uint32_t atlas_index = tile - 1;
+    uint32_t atlas_x = (atlas_index % layout->atlas_columns) * layout->tile_width;
+    uint32_t atlas_y = (atlas_index / layout->atlas_columns) * layout->tile_height;
+    return atlas_y * layout->atlas->pixel_stride + atlas_x;
+}
+
+
+// Drops all baked chunks, they are baked again as they come into view
+static void tile_map_2d_node_drop_chunks(engine_tile_map_2d_node_class_obj_t *tile_map){
+    tile_map->chunks = NULL;
+    tile_map->chunk_keys = NULL;
+    tile_map->chunk_columns = 0;
+    tile_map->chunk_rows = 0;
+}
+
+
+// Makes sure there's a chunk slot for every block of the map as it is laid out now
+static void tile_map_2d_node_ensure_chunks(engine_tile_map_2d_node_class_obj_t *tile_map, tile_map_2d_node_layout_t *layout){
+    uint16_t chunk_columns = (layout->columns + TILE_MAP_2D_NODE_CHUNK_TILES - 1) / TILE_MAP_2D_NODE_CHUNK_TILES;
+    uint16_t chunk_rows = (layout->rows + TILE_MAP_2D_NODE_CHUNK_TILES - 1) / TILE_MAP_2D_NODE_CHUNK_TILES;
+
+    if(tile_map->chunks != NULL && tile_map->chunk_columns == chunk_columns && tile_map->chunk_rows == chunk_rows){
+        return;
+    }
+
+    tile_map->chunks = m_new0(mp_obj_t, chunk_columns * chunk_rows);
+    tile_map->chunk_keys = m_new0(uint16_t, chunk_columns * chunk_rows);
+    tile_map->chunk_columns = chunk_columns;
+    tile_map->chunk_rows = chunk_rows;
+}
+
+
+// Fills `chunk` with `key_color` and draws the tiles of the chunk over it.
+// When `key_must_be_unused` is set, returns `false` as soon as a drawn
+// pixel is `key_color` since it would then be keyed out when blitted
+static bool tile_map_2d_node_bake_chunk_pixels(tile_map_2d_node_layout_t *layout, texture_resource_class_obj_t *chunk, uint16_t first_column, uint16_t first_row, uint16_t column_count, uint16_t row_count, uint16_t key_color, bool key_must_be_unused){
+    uint16_t *chunk_pixels = (uint16_t*)((mp_obj_array_t*)chunk->data)->items;
+    uint16_t chunk_stride = chunk->pixel_stride;
+
+    for(uint32_t ipx=0; ipx<chunk_stride*chunk->height; ipx++){
+        chunk_pixels[ipx] = key_color;
+    }
+
+    texture_resource_class_obj_t *atlas = layout->atlas;
+
+    for(uint16_t row=0; row<row_count; row++){
+        for(uint16_t column=0; column<column_count; column++){
+            uint16_t tile = tile_map_2d_node_read_tile(&layout->tiles, (first_row + row) * layout->columns + first_column + column);
+
+            if(tile == 0 || tile > layout->atlas_tile_count){
+                continue;
+            }
+
+            uint32_t atlas_offset = tile_map_2d_node_atlas_offset(layout, tile);
+            uint16_t *destination = chunk_pixels + (row * layout->tile_height) * chunk_stride + column * layout->tile_width;
+
+            for(uint16_t y=0; y<layout->tile_height; y++){
+                for(uint16_t x=0; x<layout->tile_width; x++){
+                    float alpha = 1.0f;
+                    uint16_t color = atlas->get_pixel(atlas, atlas_offset + y * atlas->pixel_stride + x, &alpha);
+
+                    if(alpha < 0.5f){
+                        continue;
+                    }
+
+                    if(key_must_be_unused && color == key_color){
+                        return false;
+                    }
+
+                    destination[y * chunk_stride + x] = color;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// Renders the tiles of one chunk into an RGB565 texture. Pixels without
+// a tile (or that are mostly transparent in the atlas) are set to the
+// chunk's key color (stored in `chunk_keys`). That is the transparent
+// color of the map, or if the map has none (everything in the atlas is
+// drawn), a color no tile pixel of the chunk uses. Bakes into `chunk_obj`
+// if it is a texture so that a chunk being drawn by the render core is
+// never freed, otherwise creates the texture. Returns `mp_const_none`
+// for chunks with no tiles
+static mp_obj_t tile_map_2d_node_bake_chunk(engine_tile_map_2d_node_class_obj_t *tile_map, tile_map_2d_node_layout_t *layout, uint16_t chunk_column, uint16_t chunk_row, mp_obj_t chunk_obj){
+    uint16_t first_column = chunk_column * TILE_MAP_2D_NODE_CHUNK_TILES;
+    uint16_t first_row = chunk_row * TILE_MAP_2D_NODE_CHUNK_TILES;
+    uint16_t column_count = MIN(TILE_MAP_2D_NODE_CHUNK_TILES, layout->columns - first_column);
+    uint16_t row_count = MIN(TILE_MAP_2D_NODE_CHUNK_TILES, layout->rows - first_row);
+
+    // Don't spend memory on chunks that would draw nothing
+    bool has_tiles = false;
+    for(uint16_t row=0; row<row_count && has_tiles == false; row++){
+        for(uint16_t column=0; column<column_count; column++){
+            uint16_t tile = tile_map_2d_node_read_tile(&layout->tiles, (first_row + row) * layout->columns + first_column + column);
+            if(tile != 0 && tile <= layout->atlas_tile_count){
+                has_tiles = true;
+                break;
+            }
+        }
+    }
+
+    if(has_tiles == false && (chunk_obj == MP_OBJ_NULL || chunk_obj == mp_const_none)){
+        return mp_const_none;
+    }
+
+    uint16_t chunk_width = column_count * layout->tile_width;
+    uint16_t chunk_height = row_count * layout->tile_height;
+    uint16_t transparent_color = ((color_class_obj_t*)tile_map->transparent_color)->value;
+
+    // The blit draws every pixel when given `ENGINE_NO_TRANSPARENCY_COLOR`,
+    // the empty pixels need a key that isn't used by the tiles instead
+    bool key_must_be_unused = (transparent_color == ENGINE_NO_TRANSPARENCY_COLOR);
+    uint16_t key_color = key_must_be_unused ? TILE_MAP_2D_NODE_CHUNK_KEY_COLOR : transparent_color;
+
+    if(chunk_obj == MP_OBJ_NULL || chunk_obj == mp_const_none){
+        chunk_obj = texture_resource_class_new(&texture_resource_class_type, 3, 0, (mp_obj_t[]){mp_obj_new_int(chunk_width), mp_obj_new_int(chunk_height), mp_obj_new_int(key_color)});
+    }
+
+    // Try the next color until one isn't in the chunk. A chunk has fewer
+    // pixels than there are colors so this ends, usually on the first try
+    for(uint32_t attempt=0; attempt<=UINT16_MAX; attempt++){
+        if(tile_map_2d_node_bake_chunk_pixels(layout, chunk_obj, first_column, first_row, column_count, row_count, key_color, key_must_be_unused)){
+            break;
+        }
+
+        key_color++;
+        if(key_color == ENGINE_NO_TRANSPARENCY_COLOR){
+            key_color++;
+        }
+    }
+
+    tile_map->chunk_keys[chunk_row * tile_map->chunk_columns + chunk_column] = key_color;
+
+    return chunk_obj;
+}
+
+
+void tile_map_2d_node_class_draw(mp_obj_t tile_map_node_base_obj, mp_obj_t camera_node){
+    ENGINE_INFO_PRINTF("TileMap2DNode: Drawing");
+
+    engine_node_base_t *tile_map_node_base = tile_map_node_base_obj;
+    engine_node_base_t *camera_node_base = camera_node;
+    engine_camera_node_class_obj_t *camera = camera_node_base->node;
+
+    engine_tile_map_2d_node_class_obj_t *tile_map_2d_node = tile_map_node_base->node;
+
+    // Avoid drawing or doing anything if opacity is zero
+    float tile_map_opacity = mp_obj_get_float(tile_map_2d_node->opacity);
+    if(engine_math_compare_floats(tile_map_opacity, 0.0f)){
+        return;
+    }
+
+    tile_map_2d_node_layout_t layout;
+    if(tile_map_2d_node_get_layout(tile_map_2d_node, &layout) == false){
+        return;
+    }
+
+    rectangle_class_obj_t *camera_viewport = camera->viewport;
+    float camera_zoom = mp_obj_get_float(camera->zoom);
+
+    float tile_map_resolved_hierarchy_x = 0.0f;
+    float tile_map_resolved_hierarchy_y = 0.0f;
+    float tile_map_resolved_hierarchy_rotation = 0.0f;
+    bool tile_map_is_child_of_camera = false;
+    node_base_get_child_absolute_xy(&tile_map_resolved_hierarchy_x, &tile_map_resolved_hierarchy_y, &tile_map_resolved_hierarchy_rotation, &tile_map_is_child_of_camera, tile_map_node_base);
+
+    // Screen position of the top-left of the map
+    float tile_map_rotated_x = tile_map_resolved_hierarchy_x;
+    float tile_map_rotated_y = tile_map_resolved_hierarchy_y;
+    float tile_map_rotation = tile_map_resolved_hierarchy_rotation;
+
+    if(tile_map_is_child_of_camera == false){
+        float camera_resolved_hierarchy_x = 0.0f;
+        float camera_resolved_hierarchy_y = 0.0f;
+        float camera_resolved_hierarchy_rotation = 0.0f;
+        node_base_get_child_absolute_xy(&camera_resolved_hierarchy_x, &camera_resolved_hierarchy_y, &camera_resolved_hierarchy_rotation, NULL, camera_node);
+        camera_resolved_hierarchy_rotation = -camera_resolved_hierarchy_rotation;
+
+        tile_map_rotated_x = (tile_map_rotated_x - camera_resolved_hierarchy_x) * camera_zoom;
+        tile_map_rotated_y = (tile_map_rotated_y - camera_resolved_hierarchy_y) * camera_zoom;
+
+        // Rotate map origin about the camera
+        engine_math_rotate_point(&tile_map_rotated_x, &tile_map_rotated_y, 0, 0, camera_resolved_hierarchy_rotation);
+
+        tile_map_rotation += camera_resolved_hierarchy_rotation;
+    }else{
+        camera_zoom = 1.0f;
+    }
+
+    tile_map_rotated_x += camera_viewport->width/2;
+    tile_map_rotated_y += camera_viewport->height/2;
+
+    // When not rotated or zoomed every tile lands on whole pixels
+    // and is drawn by the row copying blit. Snap the origin so that
+    // neighbouring tiles never overlap or leave a gap
+    bool axis_aligned = engine_math_compare_floats(tile_map_rotation, 0.0f) && engine_math_compare_floats(camera_zoom, 1.0f);
+    if(axis_aligned){
+        tile_map_rotated_x = floorf(tile_map_rotated_x);
+        tile_map_rotated_y = floorf(tile_map_rotated_y);
+        tile_map_rotation = 0.0f;
+        camera_zoom = 1.0f;
+    }
+
+    // Draw either single tiles or whole baked chunks
+    bool use_cache = mp_obj_is_true(tile_map_2d_node->cache);
+    uint32_t cell_width = layout.tile_width;
+    uint32_t cell_height = layout.tile_height;
+    int32_t cell_columns = layout.columns;
+    int32_t cell_rows = layout.rows;
+
+    if(use_cache){
+        tile_map_2d_node_ensure_chunks(tile_map_2d_node, &layout);
+        cell_width *= TILE_MAP_2D_NODE_CHUNK_TILES;
+        cell_height *= TILE_MAP_2D_NODE_CHUNK_TILES;
+        cell_columns = tile_map_2d_node->chunk_columns;
+        cell_rows = tile_map_2d_node->chunk_rows;
+    }
+
+    // Bring the screen corners into map space to find
+    // the range of cells that could be on screen
+    float map_min_x = FLT_MAX;
+    float map_min_y = FLT_MAX;
+    float map_max_x = -FLT_MAX;
+    float map_max_y = -FLT_MAX;
+    const float screen_corners[4][2] = {{0.0f, 0.0f}, {SCREEN_WIDTH, 0.0f}, {0.0f, SCREEN_HEIGHT}, {SCREEN_WIDTH, SCREEN_HEIGHT}};
+
+    for(uint8_t icx=0; icx<4; icx++){
+        float map_x = (screen_corners[icx][0] - tile_map_rotated_x) / camera_zoom;
+        float map_y = (screen_corners[icx][1] - tile_map_rotated_y) / camera_zoom;
+        engine_math_rotate_point(&map_x, &map_y, 0, 0, -tile_map_rotation);
+
+        map_min_x = fminf(map_min_x, map_x);
+        map_min_y = fminf(map_min_y, map_y);
+        map_max_x = fmaxf(map_max_x, map_x);
+        map_max_y = fmaxf(map_max_y, map_y);
+    }
+
+    int32_t first_column = MAX(0, (int32_t)floorf(map_min_x / cell_width));
+    int32_t first_row = MAX(0, (int32_t)floorf(map_min_y / cell_height));
+    int32_t last_column = MIN(cell_columns - 1, (int32_t)floorf(map_max_x / cell_width));
+    int32_t last_row = MIN(cell_rows - 1, (int32_t)floorf(map_max_y / cell_height));
+
+    if(first_column > last_column || first_row > last_row){
+        return;
+    }
+
+    // Decide which shader to use per-pixel (baked chunks never have alpha)
+    engine_shader_t *shader = NULL;
+    if(tile_map_opacity < 1.0f || (use_cache == false && layout.atlas->alpha_mask != 0)){
+        shader = engine_get_builtin_shader(OPACITY_SHADER);
+    }else{
+        shader = engine_get_builtin_shader(EMPTY_SHADER);
+    }
+
+    uint16_t transparent_color = ((color_class_obj_t*)tile_map_2d_node->transparent_color)->value;
+
+    for(int32_t row=first_row; row<=last_row; row++){
+        for(int32_t column=first_column; column<=last_column; column++){
+            texture_resource_class_obj_t *cell_texture = NULL;
+            uint32_t cell_offset = 0;
+            int32_t cell_window_width = 0;
+            int32_t cell_window_height = 0;
+            uint16_t cell_transparent_color = transparent_color;
+
+            if(use_cache){
+                uint32_t chunk_index = row * tile_map_2d_node->chunk_columns + column;
+
+                if(tile_map_2d_node->chunks[chunk_index] == MP_OBJ_NULL){
+                    tile_map_2d_node->chunks[chunk_index] = tile_map_2d_node_bake_chunk(tile_map_2d_node, &layout, column, row, MP_OBJ_NULL);
+                }
+
+                if(tile_map_2d_node->chunks[chunk_index] == mp_const_none){
+                    continue;
+                }
+
+                cell_texture = tile_map_2d_node->chunks[chunk_index];
+                cell_window_width = cell_texture->width;
+                cell_window_height = cell_texture->height;
+                cell_transparent_color = tile_map_2d_node->chunk_keys[chunk_index];
+            }else{
+                uint16_t tile = tile_map_2d_node_read_tile(&layout.tiles, row * layout.columns + column);
+
+                if(tile == 0 || tile > layout.atlas_tile_count){
+                    continue;
+                }
+
+                cell_texture = layout.atlas;
+                cell_offset = tile_map_2d_node_atlas_offset(&layout, tile);
+                cell_window_width = layout.tile_width;
+                cell_window_height = layout.tile_height;
+            }
+
+            float cell_center_x = column * cell_width + cell_window_width * 0.5f;
+            float cell_center_y = row * cell_height + cell_window_height * 0.5f;
+
+            if(axis_aligned == false){
+                cell_center_x *= camera_zoom;
+                cell_center_y *= camera_zoom;
+                engine_math_rotate_point(&cell_center_x, &cell_center_y, 0, 0, tile_map_rotation);
+            }
+
+            engine_draw_blit(cell_texture, cell_offset,
+                             tile_map_rotated_x + cell_center_x, tile_map_rotated_y + cell_center_y,
+                             cell_window_width, cell_window_height,
+                             cell_texture->pixel_stride,
+                             camera_zoom,
+                             camera_zoom,
+                            -tile_map_rotation,
+                             cell_transparent_color,
+                             tile_map_opacity,
+                             shader);
+        }
+    }
+}
+
+
+// Returns the index of the tile at `column`, `row` in `tiles`
+static uint32_t tile_map_2d_node_tile_index(mp_obj_t column_obj, mp_obj_t row_obj, uint16_t columns, uint16_t rows){
+    mp_int_t column = mp_obj_get_int(column_obj);
+    mp_int_t row = mp_obj_get_int(row_obj);
+
+    if(column < 0 || row < 0 || column >= columns || row >= rows){
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("TileMap2DNode: ERROR: Tile position is outside of the map"));
+    }
+
+    return row * columns + column;
+}
+
+
+/*  --- doc ---
+    NAME: set_tile
+    ID: tile_map_2d_node_set_tile
+    DESC: Sets the tile at a column and row of the map. Use this instead of changing `tiles` directly when `cache` is on so the baked chunk holding the tile is updated
+    PARAM: [type=int]   [name=column]   [value=0 ~ columns-1]
+    PARAM: [type=int]   [name=row]      [value=0 ~ rows-1]
+    PARAM: [type=int]   [name=tile]     [value=0 (empty) or 1 ~ number of tiles in the atlas]
+    RETURN: None
+*/
+static mp_obj_t tile_map_2d_node_class_set_tile(size_t n_args, const mp_obj_t *args){
+    engine_node_base_t *self_node_base = args[0];
+    engine_tile_map_2d_node_class_obj_t *self = self_node_base->node;
+
+    mp_buffer_info_t tiles;
+    uint16_t columns = 0;
+    uint16_t rows = 0;
+    tile_map_2d_node_get_grid(self, &tiles, &columns, &rows, MP_BUFFER_WRITE);
+
+    uint32_t tile_index = tile_map_2d_node_tile_index(args[1], args[2], columns, rows);
+    tile_map_2d_node_write_tile(&tiles, tile_index, mp_obj_get_int(args[3]));
+
+    if(self->chunks == NULL){
+        return mp_const_none;
+    }
+
+    // Update the chunk holding the tile. An existing chunk is re-baked in
+    // place since the render core may still be drawing it this frame
+    tile_map_2d_node_layout_t layout;
+    uint16_t chunk_column = (tile_index % columns) / TILE_MAP_2D_NODE_CHUNK_TILES;
+    uint16_t chunk_row = (tile_index / columns) / TILE_MAP_2D_NODE_CHUNK_TILES;
+    uint32_t chunk_index = chunk_row * self->chunk_columns + chunk_column;
+
+    if(tile_map_2d_node_get_layout(self, &layout) == false || chunk_index >= self->chunk_columns * self->chunk_rows){
+        tile_map_2d_node_drop_chunks(self);
+    }else if(self->chunks[chunk_index] == mp_const_none){
+        self->chunks[chunk_index] = MP_OBJ_NULL;
+    }else if(self->chunks[chunk_index] != MP_OBJ_NULL){
+        tile_map_2d_node_bake_chunk(self, &layout, chunk_column, chunk_row, self->chunks[chunk_index]);
+    }
+
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(tile_map_2d_node_class_set_tile_obj, 4, 4, tile_map_2d_node_class_set_tile);
+
+
+/*  --- doc ---
+    NAME: get_tile
+    ID: tile_map_2d_node_get_tile
+    DESC: Gets the tile at a column and row of the map
+    PARAM: [type=int]   [name=column]   [value=0 ~ columns-1]
+    PARAM: [type=int]   [name=row]      [value=0 ~ rows-1]
+    RETURN: int
+*/
+static mp_obj_t tile_map_2d_node_class_get_tile(mp_obj_t self_in, mp_obj_t column_obj, mp_obj_t row_obj){
+    engine_node_base_t *self_node_base = self_in;
+    engine_tile_map_2d_node_class_obj_t *self = self_node_base->node;
+
+    mp_buffer_info_t tiles;
+    uint16_t columns = 0;
+    uint16_t rows = 0;
+    tile_map_2d_node_get_grid(self, &tiles, &columns, &rows, MP_BUFFER_READ);
+
+    uint32_t tile_index = tile_map_2d_node_tile_index(column_obj, row_obj, columns, rows);
+    return mp_obj_new_int(tile_map_2d_node_read_tile(&tiles, tile_index));
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(tile_map_2d_node_class_get_tile_obj, tile_map_2d_node_class_get_tile);
+
+
+/*  --- doc ---
+    NAME: invalidate
+    ID: tile_map_2d_node_invalidate
+    DESC: Throws away all baked chunks so they are baked again as they come into view. Only needed after changing `tiles` or the atlas texture data directly while `cache` is on
+    RETURN: None
+*/
+static mp_obj_t tile_map_2d_node_class_invalidate(mp_obj_t self_in){
+    engine_node_base_t *self_node_base = self_in;
+    tile_map_2d_node_drop_chunks(self_node_base->node);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(tile_map_2d_node_class_invalidate_obj, tile_map_2d_node_class_invalidate);
+
+
+// Return `true` if handled loading the attr from internal structure, `false` otherwise
+bool tile_map_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
+    // Get the underlying structure
+    engine_tile_map_2d_node_class_obj_t *self = self_node_base->node;
+
+    switch(attribute){
+        case MP_QSTR_tick:
+            destination[0] = self->tick_cb;
+            destination[1] = self_node_base->attr_accessor;
+            return true;
+        break;
+        case MP_QSTR_set_tile:
+            destination[0] = MP_OBJ_FROM_PTR(&tile_map_2d_node_class_set_tile_obj);
+            destination[1] = self_node_base;
+            return true;
+        break;
+        case MP_QSTR_get_tile:
+            destination[0] = MP_OBJ_FROM_PTR(&tile_map_2d_node_class_get_tile_obj);
+            destination[1] = self_node_base;
+            return true;
+        break;
+        case MP_QSTR_invalidate:
+            destination[0] = MP_OBJ_FROM_PTR(&tile_map_2d_node_class_invalidate_obj);
+            destination[1] = self_node_base;
+            return true;
+        break;
+        case MP_QSTR_position:
+            destination[0] = self->position;
+            return true;
+        break;
+        case MP_QSTR_rotation:
+            destination[0] = self->rotation;
+            return true;
+        break;
+        case MP_QSTR_texture:
+            destination[0] = self->texture_resource;
+            return true;
+        break;
+        case MP_QSTR_tiles:
+            destination[0] = self->tiles;
+            return true;
+        break;
+        case MP_QSTR_columns:
+            destination[0] = self->columns;
+            return true;
+        break;
+        case MP_QSTR_rows:
+        {
+            mp_buffer_info_t tiles;
+            uint16_t columns = 0;
+            uint16_t rows = 0;
+            tile_map_2d_node_get_grid(self, &tiles, &columns, &rows, MP_BUFFER_READ);
+            destination[0] = mp_obj_new_int(rows);
+            return true;
+        }
+        break;
+        case MP_QSTR_tile_width:
+            destination[0] = self->tile_width;
+            return true;
+        break;
+        case MP_QSTR_tile_height:
+            destination[0] = self->tile_height;
+            return true;
+        break;
+        case MP_QSTR_transparent_color:
+            destination[0] = self->transparent_color;
+            return true;
+        break;
+        case MP_QSTR_opacity:
+            destination[0] = self->opacity;
+            return true;
+        break;
+        case MP_QSTR_cache:
+            destination[0] = self->cache;
+            return true;
+        break;
+        default:
+            return false; // Fail
+    }
+}
+
+
+// Return `true` if handled storing the attr from internal structure, `false` otherwise
+bool tile_map_2d_node_store_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
+    // Get the underlying structure
+    engine_tile_map_2d_node_class_obj_t *self = self_node_base->node;
+
+    // Anything that changes what a chunk looks like drops the baked chunks
+    switch(attribute){
+        case MP_QSTR_tick:
+            self->tick_cb = destination[1];
+            return true;
+        break;
+        case MP_QSTR_position:
+            self->position = destination[1];
+            return true;
+        break;
+        case MP_QSTR_rotation:
+            self->rotation = destination[1];
+            return true;
+        break;
+        case MP_QSTR_texture:
+            self->texture_resource = destination[1];
+            tile_map_2d_node_drop_chunks(self);
+            return true;
+        break;
+        case MP_QSTR_tiles:
+            self->tiles = destination[1];
+            tile_map_2d_node_drop_chunks(self);
+            return true;
+        break;
+        case MP_QSTR_columns:
+            self->columns = destination[1];
+            tile_map_2d_node_drop_chunks(self);
+            return true;
+        break;
+        case MP_QSTR_tile_width:
+            self->tile_width = destination[1];
+            tile_map_2d_node_drop_chunks(self);
+            return true;
+        break;
+        case MP_QSTR_tile_height:
+            self->tile_height = destination[1];
+            tile_map_2d_node_drop_chunks(self);
+            return true;
+        break;
+        case MP_QSTR_transparent_color:
+            self->transparent_color = engine_color_wrap(destination[1]);
+            tile_map_2d_node_drop_chunks(self);
+            return true;
+        break;
+        case MP_QSTR_opacity:
+            self->opacity = destination[1];
+            return true;
+        break;
+        case MP_QSTR_cache:
+            self->cache = destination[1];
+            tile_map_2d_node_drop_chunks(self);
+            return true;
+        break;
+        default:
+            return false; // Fail
+    }
+}
+
+
+static mp_attr_fun_t tile_map_2d_node_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t *destination){
+    ENGINE_INFO_PRINTF("Accessing TileMap2DNode attr");
+    node_base_attr_handler(self_in, attribute, destination,
+                          (attr_handler_func[]){node_base_load_attr, tile_map_2d_node_load_attr},
+                          (attr_handler_func[]){node_base_store_attr, tile_map_2d_node_store_attr}, 2);
+    return mp_const_none;
+}
+
+
+/*  --- doc ---
+    NAME: TileMap2DNode
+    ID: TileMap2DNode
+    DESC: Grid of tiles taken from one atlas texture. Only the tiles that are on screen are drawn. Tiles in the atlas are `tile_width` x `tile_height` and numbered starting at 1 from the top-left, going left to right and then top to bottom. A tile number of 0 in `tiles` leaves that cell empty. When `cache` is on, blocks of 4x4 tiles are pre-rendered into RGB565 textures (costing up to 2 bytes per map pixel) the first time they come into view and are then drawn with one blit each. The cache is meant for static background layers, use `set_tile(...)` or `invalidate()` after changing tiles
+    PARAM:  [type={ref_link:Vector2}]               [name=position]                                     [value={ref_link:Vector2} (top-left of the map)]
+    PARAM:  [type={ref_link:TextureResource}]       [name=texture]                                      [value={ref_link:TextureResource}]
+    PARAM:  [type=bytearray|array('B')|array('H')]  [name=tiles]                                        [value=one tile number per cell, row by row]
+    PARAM:  [type=int]                              [name=columns]                                      [value=any positive integer (map width in tiles)]
+    PARAM:  [type=int]                              [name=tile_width]                                   [value=any positive integer]
+    PARAM:  [type=int]                              [name=tile_height]                                  [value=any positive integer]
+    PARAM:  [type={ref_link:Color}|int (RGB565)]    [name=transparent_color]                            [value=color]
+    PARAM:  [type=float]                            [name=opacity]                                      [value=0 ~ 1.0]
+    PARAM:  [type=boolean]                          [name=cache]                                        [value=boolean]
+    PARAM:  [type=float]                            [name=rotation]                                     [value=any (radians)]
+    PARAM:  [type=int]                              [name=layer]                                        [value=0 ~ 127]
+    ATTR:   [type=function]                         [name={ref_link:add_child}]                         [value=function]
+    ATTR:   [type=function]                         [name={ref_link:get_child}]                         [value=function]
+    ATTR:   [type=function]                         [name={ref_link:get_child_count}]                   [value=function]
+    ATTR:   [type=function]                         [name={ref_link:node_base_mark_destroy}]            [value=function]
+    ATTR:   [type=function]                         [name={ref_link:node_base_mark_destroy_all}]        [value=function]
+    ATTR:   [type=function]                         [name={ref_link:node_base_mark_destroy_children}]   [value=function]
+    ATTR:   [type=function]                         [name={ref_link:remove_child}]                      [value=function]
+    ATTR:   [type=function]                         [name={ref_link:tick}]                              [value=function]
+    ATTR:   [type=function]                         [name={ref_link:tile_map_2d_node_set_tile}]         [value=function]
+    ATTR:   [type=function]                         [name={ref_link:tile_map_2d_node_get_tile}]         [value=function]
+    ATTR:   [type=function]                         [name={ref_link:tile_map_2d_node_invalidate}]       [value=function]
+    ATTR:   [type={ref_link:Vector2}]               [name=position]                                     [value={ref_link:Vector2}]
+    ATTR:   [type={ref_link:Vector2}]               [name=global_position]                              [value={ref_link:Vector2} (read-only)]
+    ATTR:   [type={ref_link:TextureResource}]       [name=texture]                                      [value={ref_link:TextureResource}]
+    ATTR:   [type=bytearray|array('B')|array('H')]  [name=tiles]                                        [value=one tile number per cell, row by row]
+    ATTR:   [type=int]                              [name=columns]                                      [value=any positive integer]
+    ATTR:   [type=int]                              [name=rows]                                         [value=int (read-only, length of `tiles` divided by `columns`)]
+    ATTR:   [type=int]                              [name=tile_width]                                   [value=any positive integer]
+    ATTR:   [type=int]                              [name=tile_height]                                  [value=any positive integer]
+    ATTR:   [type={ref_link:Color}|int (RGB565)]    [name=transparent_color]                            [value=color]
+    ATTR:   [type=float]                            [name=opacity]                                      [value=0 ~ 1.0]
+    ATTR:   [type=boolean]                          [name=cache]                                        [value=boolean]
+    ATTR:   [type=float]                            [name=rotation]                                     [value=any (radians)]
+    ATTR:   [type=int]                              [name=layer]                                        [value=0 ~ 127]
+    OVRR:   [type=function]                         [name={ref_link:tick}]                              [value=function]
+*/
+mp_obj_t tile_map_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args){
+    ENGINE_INFO_PRINTF("New TileMap2DNode");
+
+    mp_arg_t allowed_args[] = {
+        { MP_QSTR_child_class,          MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_position,             MP_ARG_OBJ, {.u_obj = vector2_class_new(&vector2_class_type, 0, 0, NULL)} },
+        { MP_QSTR_texture,              MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_tiles,                MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_columns,              MP_ARG_OBJ, {.u_obj = mp_obj_new_int(0)} },
+        { MP_QSTR_tile_width,           MP_ARG_OBJ, {.u_obj = mp_obj_new_int(8)} },
+        { MP_QSTR_tile_height,          MP_ARG_OBJ, {.u_obj = mp_obj_new_int(8)} },
+        { MP_QSTR_transparent_color,    MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(ENGINE_NO_TRANSPARENCY_COLOR)} },
+        { MP_QSTR_opacity,              MP_ARG_OBJ, {.u_obj = mp_obj_new_float(1.0f)} },
+        { MP_QSTR_cache,                MP_ARG_OBJ, {.u_obj = mp_obj_new_bool(false)} },
+        { MP_QSTR_rotation,             MP_ARG_OBJ, {.u_obj = mp_obj_new_float(0.0f)} },
+        { MP_QSTR_layer,                MP_ARG_INT, {.u_int = 0} }
+    };
+    mp_arg_val_t parsed_args[MP_ARRAY_SIZE(allowed_args)];
+    enum arg_ids {child_class, position, texture, tiles, columns, tile_width, tile_height, transparent_color, opacity, cache, rotation, layer};
+    bool inherited = false;
+
+    // If there is one positional argument and it isn't the first
+    // expected argument (as is expected when using positional
+    // arguments) then define which way to parse the arguments
+    if(n_args >= 1 && mp_obj_get_type(args[0]) != &vector2_class_type){
+        // Using positional arguments but the type of the first one isn't
+        // as expected. Must be the child class
+        mp_arg_parse_all_kw_array(n_args, n_kw, args, MP_ARRAY_SIZE(allowed_args), allowed_args, parsed_args);
+        inherited = true;
+    }else{
+        // Whether we're using positional arguments or not, prase them this
+        // way. It's a requirement that the child class be passed using position.
+        // Adjust what and where the arguments are parsed, since not inherited based
+        // on the first argument
+        mp_arg_parse_all_kw_array(n_args, n_kw, args, MP_ARRAY_SIZE(allowed_args)-1, allowed_args+1, parsed_args+1);
+        inherited = false;
+    }
+
+    // All nodes are a engine_node_base_t node. Specific node data is stored in engine_node_base_t->node
+    engine_node_base_t *node_base = mp_obj_malloc_with_finaliser(engine_node_base_t, &engine_tile_map_2d_node_class_type);
+    node_base_init(node_base, &engine_tile_map_2d_node_class_type, NODE_TYPE_TILE_MAP_2D, parsed_args[layer].u_int);
+    engine_tile_map_2d_node_class_obj_t *tile_map_2d_node = m_malloc(sizeof(engine_tile_map_2d_node_class_obj_t));
+    node_base->node = tile_map_2d_node;
+    node_base->attr_accessor = node_base;
+
+    tile_map_2d_node->tick_cb = mp_const_none;
+    tile_map_2d_node->position = parsed_args[position].u_obj;
+    tile_map_2d_node->texture_resource = parsed_args[texture].u_obj;
+    tile_map_2d_node->tiles = parsed_args[tiles].u_obj;
+    tile_map_2d_node->columns = parsed_args[columns].u_obj;
+    tile_map_2d_node->tile_width = parsed_args[tile_width].u_obj;
+    tile_map_2d_node->tile_height = parsed_args[tile_height].u_obj;
+    tile_map_2d_node->transparent_color = engine_color_wrap(parsed_args[transparent_color].u_obj);
+    tile_map_2d_node->opacity = parsed_args[opacity].u_obj;
+    tile_map_2d_node->cache = parsed_args[cache].u_obj;
+    tile_map_2d_node->rotation = parsed_args[rotation].u_obj;
+    tile_map_2d_node_drop_chunks(tile_map_2d_node);
+
+    if(inherited == true){  // Inherited (use existing object)
+        // Get the Python class instance
+        mp_obj_t node_instance = parsed_args[child_class].u_obj;
+
+        // Because the instance doesn't have a `node_base` yet, restore the
+        // instance type original attr function for now (otherwise get core abort)
+        node_base_set_attr_handler_default(node_instance);
+
+        // Look for function overrides otherwise use the defaults
+        mp_obj_t dest[2];
+        mp_load_method_maybe(node_instance, MP_QSTR_tick, dest);
+        if(dest[0] == MP_OBJ_NULL && dest[1] == MP_OBJ_NULL){   // Did not find method (set to default)
+            tile_map_2d_node->tick_cb = mp_const_none;
+        }else{                                                  // Likely found method (could be attribute)
+            tile_map_2d_node->tick_cb = dest[0];
+        }
+
+        // Store one pointer on the instance. Need to be able to get the
+        // node base that contains a pointer to the engine specific data we
+        // care about
+        mp_store_attr(node_instance, MP_QSTR_node_base, node_base);
+
+        // Store default Python class instance attr function
+        // and override with custom intercept attr function
+        // so that certain callbacks/code can run (see py/objtype.c:mp_obj_instance_attr(...))
+        node_base_set_attr_handler(node_instance, tile_map_2d_node_class_attr);
+
+        // Need a way to access the object node instance instead of the native type for callbacks (tick, draw, collision)
+        node_base->attr_accessor = node_instance;
+    }
+
+    return MP_OBJ_FROM_PTR(node_base);
+}
+
+
+// Class attributes
+static const mp_rom_map_elem_t tile_map_2d_node_class_locals_dict_table[] = {
+
+};
+static MP_DEFINE_CONST_DICT(tile_map_2d_node_class_locals_dict, tile_map_2d_node_class_locals_dict_table);
+
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    engine_tile_map_2d_node_class_type,
+    MP_QSTR_TileMap2DNode,
+    MP_TYPE_FLAG_NONE,
+
+    make_new, tile_map_2d_node_class_new,
+    attr, tile_map_2d_node_class_attr,
+    locals_dict, &tile_map_2d_node_class_locals_dict
+);
@@ -0,0 +1,37 @@
+#ifndef TILE_MAP_2D_NODE_H
+#define TILE_MAP_2D_NODE_H
+
+#include "py/obj.h"
+#include "nodes/node_base.h"
+
+// Baked chunks (when `cache` is on) are this many tiles on each side
+#define TILE_MAP_2D_NODE_CHUNK_TILES 4
+
+// First color tried as the key for the empty pixels of a baked
+// chunk when the map has no `transparent_color` of its own
+#define TILE_MAP_2D_NODE_CHUNK_KEY_COLOR 0xF81F
+
+// A grid of tiles taken from one texture atlas
+typedef struct{
+    mp_obj_t position;              // Vector2: 2d xy position of the top-left of the map
+    mp_obj_t rotation;              // float: rotation of the map about its top-left
+    mp_obj_t texture_resource;      // TextureResource: atlas of `tile_width` x `tile_height` tiles, numbered left to right, top to bottom starting at 1
+    mp_obj_t tiles;                 // bytearray or array('B'/'H'): one atlas tile number per map cell, row by row (0 is an empty cell)
+    mp_obj_t columns;               // int: map width in tiles (the height is the length of `tiles` divided by this)
+    mp_obj_t tile_width;
+    mp_obj_t tile_height;
+    mp_obj_t transparent_color;     // Color: which exact color in the atlas to not render
+    mp_obj_t opacity;
+    mp_obj_t cache;                 // Bool: if true, blocks of tiles are pre-rendered into RGB565 textures and drawn from those
+    mp_obj_t tick_cb;
+
+    mp_obj_t *chunks;               // Baked chunk TextureResources, MP_OBJ_NULL if not baked yet. NULL if the layout changed
+    uint16_t *chunk_keys;           // Color of the pixels without a tile in each baked chunk, used as its transparent color
+    uint16_t chunk_columns;
+    uint16_t chunk_rows;
+}engine_tile_map_2d_node_class_obj_t;
+
+extern const mp_obj_type_t engine_tile_map_2d_node_class_type;
+void tile_map_2d_node_class_draw(mp_obj_t tile_map_node_base_obj, mp_obj_t camera_node);
+
+#endif  // TILE_MAP_2D_NODE_H
@@ -51,6 +51,7 @@ const vector3_class_obj_t world_north = {
 void camera_node_set_final_transformation(void *user_ptr){
     engine_camera_node_class_obj_t *camera = user_ptr;
     glm_mul(camera->m_rotation, camera->m_translation, camera->m_final_transformation);
+    camera->view_projection_dirty = true;
 }
 
 
@@ -83,6 +84,7 @@ void camera_node_set_perspective(engine_camera_node_class_obj_t *self){
 
 
     glm_perspective_rh_zo(f_fov_degrees * (PI / 180.0f), SCREEN_WIDTH/SCREEN_HEIGHT, 0.1f, f_view_distance, self->m_projection);
+    self->view_projection_dirty = true;
 
 
     // https://learnopengl.com/Getting-started/Coordinate-Systems#:~:text=A%20perspective%20projection%20matrix%20can%20be%20created%20in%20GLM%20as%20follows
@@ -111,6 +113,37 @@ void camera_node_set_perspective(engine_camera_node_class_obj_t *self){
 }
 
 
+// https://stackoverflow.com/a/39881407
+// https://stackoverflow.com/a/45647934
+// https://www.opengl-tutorial.org/beginners-tutorials/tutorial-3-matrices/#:~:text=%2C%20myRotationAxis%20)%3B-,Cumulating%20transformations,-So%20now%20we
+// https://www.reddit.com/r/opengl/comments/6cah2x/how_to_mvp_transformation_matrices_relate_to_each/
+void camera_node_update_view_projection(engine_camera_node_class_obj_t *camera){
+    if(camera->view_projection_dirty == false){
+        return;
+    }
+
+    mat4 m_cam_lookat = GLM_MAT4_ZERO_INIT;
+    glm_lookat_rh_zo((vec3){0, 0, -1}, (vec3){0, 0, 0}, (vec3){0, 1, 0}, m_cam_lookat);
+
+    mat4 m_cam_scale = GLM_MAT4_ZERO_INIT;
+    glm_scale_make(m_cam_scale, (vec3){-1.0f, -1.0f, -1.0f});
+
+    mat4 m_cam_rotation = GLM_MAT4_ZERO_INIT;
+    glm_mat4_mul(camera->m_rotation, m_cam_lookat, m_cam_rotation);
+
+    mat4 m_cam_translation = GLM_MAT4_ZERO_INIT;
+    glm_mat4_mul(camera->m_translation, m_cam_scale, m_cam_translation);
+
+    mat4 m_cam_view = GLM_MAT4_ZERO_INIT;
+    glm_mat4_mul(m_cam_translation, m_cam_rotation, m_cam_view);
+    glm_mat4_inv(m_cam_view, m_cam_view);
+
+    glm_mat4_mul(camera->m_projection, m_cam_view, camera->m_view_projection);
+
+    camera->view_projection_dirty = false;
+}
+
+
 // // https://forums.unrealengine.com/t/how-does-get-look-at-rotation-work-from-a-mathematical-point-of-view/732711/3
 // // https://gamedev.stackexchange.com/a/112572
 // static mp_obj_t camera_node_class_lookat(mp_obj_t self_in, mp_obj_t lookat_target_position_obj){
@@ -422,6 +455,7 @@ mp_obj_t camera_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t
     vector3_class_obj_t *r = (vector3_class_obj_t*)camera_node->rotation;
     glm_translate_make(camera_node->m_translation, (vec3){p->x.value, p->y.value, p->z.value});
     glm_euler((vec3){r->x.value, r->y.value, r->z.value}, camera_node->m_rotation);
+    camera_node->view_projection_dirty = true;
 
     p->on_changed = camera_node_set_translation;
     p->on_change_user_ptr = camera_node;
@@ -523,6 +557,101 @@ void engine_camera_draw_for_each(void (*draw_cb)(mp_obj_t, mp_obj_t), engine_nod
 }
 
 
+// Pixels of slack added to every node's bounds since draws
+// floor their positions and round their sizes
+#define ENGINE_CAMERA_CULL_MARGIN 2.0f
+
+static uint32_t engine_camera_drawn_count = 0;
+static uint32_t engine_camera_culled_count = 0;
+
+
+// Resolves the node's position on the screen the same way the 2D
+// draw callbacks do and checks its bounds against the screen. The
+// viewport size only positions the view, the 2D draws are clipped to
+// the screen
+static bool engine_camera_can_see(engine_node_base_t *camera_node_base, engine_node_base_t *node_base, float (*get_screen_radius)(engine_node_base_t*, float)){
+    engine_camera_node_class_obj_t *camera = camera_node_base->node;
+    rectangle_class_obj_t *camera_viewport = camera->viewport;
+    float camera_zoom = mp_obj_get_float(camera->zoom);
+
+    float x = 0.0f;
+    float y = 0.0f;
+    float rotation = 0.0f;
+    bool is_child_of_camera = false;
+    node_base_get_child_absolute_xy(&x, &y, &rotation, &is_child_of_camera, node_base);
+
+    if(is_child_of_camera == false){
+        float camera_x = 0.0f;
+        float camera_y = 0.0f;
+        float camera_rotation = 0.0f;
+        node_base_get_child_absolute_xy(&camera_x, &camera_y, &camera_rotation, NULL, camera_node_base);
+
+        x = (x - camera_x) * camera_zoom;
+        y = (y - camera_y) * camera_zoom;
+
+        if(engine_math_compare_floats(camera_rotation, 0.0f) == false){
+            engine_math_rotate_point(&x, &y, 0, 0, -camera_rotation);
+        }
+    }else{
+        camera_zoom = 1.0f;
+    }
+
+    x += camera_viewport->width/2;
+    y += camera_viewport->height/2;
+
+    float radius = get_screen_radius(node_base, camera_zoom) + ENGINE_CAMERA_CULL_MARGIN;
+
+    if(x + radius < 0.0f || x - radius > SCREEN_WIDTH || y + radius < 0.0f || y - radius > SCREEN_HEIGHT){
+        return false;
+    }
+
+    return true;
+}
+
+
+uint8_t engine_camera_draw_for_each_culled(void (*draw_cb)(mp_obj_t, mp_obj_t), float (*get_screen_radius)(engine_node_base_t*, float), engine_node_base_t *node_base){
+    linked_list *camera_list = engine_collections_get_camera_list();
+    linked_list_node *current_camera_list_node = camera_list->start;
+    if(current_camera_list_node == NULL){
+        ENGINE_WARNING_PRINTF("No cameras exist, not calling draw callbacks!");
+    }
+
+    uint8_t drawn_count = 0;
+
+    while(current_camera_list_node != NULL){
+        engine_node_base_t *camera_node_base = current_camera_list_node->object;
+
+        if(engine_camera_can_see(camera_node_base, node_base, get_screen_radius)){
+            draw_cb(node_base, camera_node_base);
+            engine_camera_drawn_count++;
+            drawn_count++;
+        }else{
+            engine_camera_culled_count++;
+        }
+
+        current_camera_list_node = current_camera_list_node->next;
+    }
+
+    return drawn_count;
+}
+
+
+void engine_camera_reset_cull_counters(){
+    engine_camera_drawn_count = 0;
+    engine_camera_culled_count = 0;
+}
+
+
+uint32_t engine_camera_get_drawn_count(){
+    return engine_camera_drawn_count;
+}
+
+
+uint32_t engine_camera_get_culled_count(){
+    return engine_camera_culled_count;
+}
+
+
 void engine_camera_transform_2d(mp_obj_t camera_node, float *px, float *py, float *rotation){
     engine_node_base_t *camera_node_base = camera_node;
     engine_camera_node_class_obj_t *camera = camera_node_base->node;
@@ -36,6 +36,11 @@ typedef struct{
     // These should not be affected by any type of global coordinates
     mat4 m_projection;
     vec4 v_viewport;
+
+    // Projection * view, rebuilt at most once per change to the
+    // camera's position, rotation or perspective instead of per mesh
+    mat4 m_view_projection;
+    bool view_projection_dirty;
 }engine_camera_node_class_obj_t;
 
 extern const mp_obj_type_t engine_camera_node_class_type;
@@ -46,6 +51,21 @@ void engine_camera_draw_for_each_obj(mp_obj_t dest[2]);
 
 void engine_camera_draw_for_each(void (*draw_cb)(mp_obj_t, mp_obj_t), engine_node_base_t *node_base);
 
+// Same as `engine_camera_draw_for_each` but skips cameras that the node
+// can't draw anything on the screen for. `get_screen_radius` returns
+// how far from its resolved position the node can draw at a camera
+// zoom. Returns how many cameras the node was drawn for
+uint8_t engine_camera_draw_for_each_culled(void (*draw_cb)(mp_obj_t, mp_obj_t), float (*get_screen_radius)(engine_node_base_t*, float), engine_node_base_t *node_base);
+
+// Draws done and skipped by `engine_camera_draw_for_each_culled`
+// since the counters were last reset (once per draw pass)
+void engine_camera_reset_cull_counters();
+uint32_t engine_camera_get_drawn_count();
+uint32_t engine_camera_get_culled_count();
+
+// Rebuild `m_view_projection` if the camera changed since it was last built
+void camera_node_update_view_projection(engine_camera_node_class_obj_t *camera);
+
 // Scale passed position and rotation due to camera zoom and rotation
 void engine_camera_transform_2d(mp_obj_t camera_node, float *px, float *py, float *rotation);
 
@@ -24,6 +24,7 @@ void mesh_node_set_final_transformation(void *user_ptr){
     engine_mesh_node_class_obj_t *mesh = user_ptr;
     glm_mul(mesh->m_translation, mesh->m_scale, mesh->m_final_transformation);
     glm_mul(mesh->m_rotation, mesh->m_final_transformation, mesh->m_final_transformation);
+    mesh->model_dirty = true;
 }
 
 
@@ -51,76 +52,39 @@ void mesh_node_set_scale(void *user_ptr){
 }
 
 
-void mesh_node_project_draw(texture_resource_class_obj_t *texture, vec3 v0, vec3 v1, vec3 v2, vec2 v0uv, vec2 v1uv, vec2 v2uv, mat4 mvp, vec4 v_viewport, uint16_t triangle_color, engine_shader_t *shader){
-    vec3 out_0 = GLM_VEC3_ZERO_INIT;
-    vec3 out_1 = GLM_VEC3_ZERO_INIT;
-    vec3 out_2 = GLM_VEC3_ZERO_INIT;
-    glm_project_zo(v0, mvp, v_viewport, out_0);
-    glm_project_zo(v1, mvp, v_viewport, out_1);
-    glm_project_zo(v2, mvp, v_viewport, out_2);
-
-    float w0 = mvp[0][3] * v0[0] + mvp[1][3] * v0[1] + mvp[2][3] * v0[2] + mvp[3][3];
-    float w1 = mvp[0][3] * v1[0] + mvp[1][3] * v1[1] + mvp[2][3] * v1[2] + mvp[3][3];
-    float w2 = mvp[0][3] * v2[0] + mvp[1][3] * v2[1] + mvp[2][3] * v2[2] + mvp[3][3];
-
-    // float w0 = mvp[0][2] * v0[0] + mvp[1][2] * v0[1] + mvp[2][2] * v0[2] + mvp[3][2];
-    // float w1 = mvp[0][2] * v1[0] + mvp[1][2] * v1[1] + mvp[2][2] * v1[2] + mvp[3][2];
-    // float w2 = mvp[0][2] * v2[0] + mvp[1][2] * v2[1] + mvp[2][2] * v2[2] + mvp[3][2];
-
-    // float w0 = 1.0f / glm_project_z_zo(v0, mvp) * out_0[2];
-    // float w1 = 1.0f / glm_project_z_zo(v1, mvp) * out_1[2];
-    // float w2 = 1.0f / glm_project_z_zo(v2, mvp) * out_2[2];
-
-    // Convert from 0.0 ~ 1.0 to 0 ~ UINT16_MAX
-    uint32_t z0 = (uint32_t)(out_0[2]*(float)UINT16_MAX);
-    uint32_t z1 = (uint32_t)(out_1[2]*(float)UINT16_MAX);
-    uint32_t z2 = (uint32_t)(out_2[2]*(float)UINT16_MAX);
-
-    // Check that the triangle vertices are in front of the camera (not behind)
-    // Doing float compares for each pixel cuts FPS by half, this maybe could be
-    // better: TODO
-    if(((z0 > 0 && z0 < UINT16_MAX)) &&
-        ((z1 > 0 && z1 < UINT16_MAX)) &&
-        ((z2 > 0 && z2 < UINT16_MAX))){
-
-        engine_draw_filled_triangle_depth(texture, triangle_color,
-                                          out_0[0], out_0[1], z0, v0uv[0], v0uv[1],
-                                          out_1[0], out_1[1], z1, v1uv[0], v1uv[1],
-                                          out_2[0], out_2[1], z2, v2uv[0], v2uv[1],
-                                          w0, w1, w2,
-                                          1.0f, shader);
-
-        // // Wireframe
-        // // Cast to int and see if any endpoints will be on screen
-        // int32_t x0 = (int32_t)out_0[0];
-        // int32_t y0 = (int32_t)out_0[1];
-
-        // int32_t x1 = (int32_t)out_1[0];
-        // int32_t y1 = (int32_t)out_1[1];
-
-        // int32_t x2 = (int32_t)out_2[0];
-        // int32_t y2 = (int32_t)out_2[1];
-
-        // bool endpoint_0_on_screen = engine_math_int32_between(x0, 0, SCREEN_WIDTH_MINUS_1) && engine_math_int32_between(y0, 0, SCREEN_HEIGHT_MINUS_1);
-        // bool endpoint_1_on_screen = engine_math_int32_between(x1, 0, SCREEN_WIDTH_MINUS_1) && engine_math_int32_between(y1, 0, SCREEN_HEIGHT_MINUS_1);
-        // bool endpoint_2_on_screen = engine_math_int32_between(x2, 0, SCREEN_WIDTH_MINUS_1) && engine_math_int32_between(y2, 0, SCREEN_HEIGHT_MINUS_1);
-
-        // // If either endpoint is on screen, draw the full line
-        // // This avoids drawing lines that are out of bounds on
-        // // the camera's view plane and increases performance a
-        // // ton
-        // if(endpoint_0_on_screen || endpoint_1_on_screen){
-        //     engine_draw_line(mesh_color->value, out_0[0], out_0[1], out_1[0], out_1[1], NULL, 1.0f, shader);
-        // }
-
-        // if(endpoint_1_on_screen || endpoint_2_on_screen){
-        //     engine_draw_line(mesh_color->value, out_1[0], out_1[1], out_2[0], out_2[1], NULL, 1.0f, shader);
-        // }
-
-        // if(endpoint_2_on_screen || endpoint_0_on_screen){
-        //     engine_draw_line(mesh_color->value, out_2[0], out_2[1], out_0[0], out_0[1], NULL, 1.0f, shader);
-        // }
-    }
+// Vertices are projected in chunks of this many into a scratch array before
+// any triangle setup happens. Must be a multiple of 3 (whole triangles)
+#define MESH_NODE_VERTEX_CACHE_SIZE 96
+
+typedef struct{
+    float x;            // Screen x
+    float y;            // Screen y
+    float w;            // Clip space w, used for perspective correct UVs
+    uint16_t z;         // Depth from 0 ~ UINT16_MAX
+    bool in_front;      // Is the vertex between the near and far planes
+}mesh_node_projected_vertex_t;
+
+static mesh_node_projected_vertex_t vertex_cache[MESH_NODE_VERTEX_CACHE_SIZE];
+
+
+// Same result as `glm_project_zo` but keeps the clip space
+// `w` around instead of computing it again separately
+void mesh_node_project_vertex(vec3 v, mat4 mvp, vec4 v_viewport, mesh_node_projected_vertex_t *out){
+    vec4 clip = {v[0], v[1], v[2], 1.0f};
+    glm_mat4_mulv(mvp, clip, clip);
+
+    float inverse_w = 1.0f / clip[3];
+
+    out->x = v_viewport[0] + v_viewport[2] * (clip[0] * inverse_w * 0.5f + 0.5f);
+    out->y = v_viewport[1] + v_viewport[3] * (clip[1] * inverse_w * 0.5f + 0.5f);
+    out->w = clip[3];
+
+    // Convert from 0.0 ~ 1.0 to 0 ~ UINT16_MAX and check that the
+    // vertex is in front of the camera (not behind). Doing float
+    // compares for each pixel cuts FPS by half so do it per vertex
+    float z = clip[2] * inverse_w * (float)UINT16_MAX;
+    out->in_front = (z >= 1.0f && z < (float)UINT16_MAX);
+    out->z = out->in_front ? (uint16_t)z : 0;
 }
 
 
@@ -180,6 +144,27 @@ uint16_t mesh_node_get_tri_color_uint16_bytearray(mp_obj_t triangle_color_data,
 }
 
 
+// Get the vertices of the triangle from a packed mesh (`vertex_data` is the mesh resource)
+void mesh_node_get_tri_verts_packed(mp_obj_t vertex_data, vec3 v0, vec3 v1, vec3 v2, uint16_t vertex_index){
+    float u, v;
+    mesh_resource_packed_get_vertex(vertex_data, vertex_index, v0, &u, &v);
+    mesh_resource_packed_get_vertex(vertex_data, vertex_index+1, v1, &u, &v);
+    mesh_resource_packed_get_vertex(vertex_data, vertex_index+2, v2, &u, &v);
+}
+
+
+// Get the color of the triangle from a packed mesh (`triangle_color_data` is the mesh resource)
+uint16_t mesh_node_get_tri_color_packed(mp_obj_t triangle_color_data, uint16_t vertex_index, uint16_t default_color){
+    mesh_resource_class_obj_t *mesh = triangle_color_data;
+
+    if(mesh->packed_colors == NULL){
+        return default_color;
+    }
+
+    return mesh->packed_colors[vertex_index/3];
+}
+
+
 uint16_t mesh_node_get_tri_color_default(mp_obj_t triangle_color_data, uint16_t vertex_index, uint16_t default_color){
     return default_color;
 }
@@ -221,6 +206,21 @@ void mesh_node_get_tri_vert_uvs_uint8_array(mp_obj_t uv_data, vec2 v0uv, vec2 v1
 }
 
 
+// Get the uvs of the triangle from a packed mesh (`uv_data` is the mesh resource)
+void mesh_node_get_tri_vert_uvs_packed(mp_obj_t uv_data, vec2 v0uv, vec2 v1uv, vec2 v2uv, uint16_t texture_width, uint16_t texture_height, uint16_t vertex_index){
+    vec3 position;
+
+    mesh_resource_packed_get_vertex(uv_data, vertex_index, position, &v0uv[0], &v0uv[1]);
+    mesh_resource_packed_get_vertex(uv_data, vertex_index+1, position, &v1uv[0], &v1uv[1]);
+    mesh_resource_packed_get_vertex(uv_data, vertex_index+2, position, &v2uv[0], &v2uv[1]);
+
+    // Get the uvs in terms of pixels, not percentage
+    v0uv[0] *= texture_width;   v0uv[1] *= texture_height;
+    v1uv[0] *= texture_width;   v1uv[1] *= texture_height;
+    v2uv[0] *= texture_width;   v2uv[1] *= texture_height;
+}
+
+
 void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node){
     engine_node_base_t *mesh_node_base = mesh_node_base_obj;
     engine_mesh_node_class_obj_t *mesh_node = mesh_node_base->node;
@@ -232,11 +232,24 @@ void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node){
     }
 
     uint32_t vertex_count = 0;
+    mp_obj_t vertex_data = mesh->vertices;
+    mp_obj_t uv_data = mesh->uvs;
+    mp_obj_t triangle_color_data = mesh->triangle_colors;
     void (*get_tri_verts_func)(mp_obj_t vertex_data, vec3 v0, vec3 v1, vec3 v2, uint16_t vertex_index) = NULL;
     uint16_t (*get_tri_colors_func)(mp_obj_t triangle_color_data, uint16_t vertex_index, uint16_t default_color) = NULL;
     void (*get_tri_vert_uvs_func)(mp_obj_t uv_data, vec2 v0uv, vec2 v1uv, vec2 v2uv, uint16_t texture_width, uint16_t texture_height, uint16_t vertex_index) = NULL;
 
-    if(mp_obj_is_type(mesh->vertices, &mp_type_list)){
+    if(mesh->packed_data != mp_const_none){
+        // Packed meshes are read in place, hand the
+        // resource itself to each of the getters
+        vertex_data = mesh;
+        uv_data = mesh;
+        triangle_color_data = mesh;
+        get_tri_verts_func = mesh_node_get_tri_verts_packed;
+        get_tri_vert_uvs_func = mesh_node_get_tri_vert_uvs_packed;
+        get_tri_colors_func = mesh_node_get_tri_color_packed;
+        vertex_count = mesh_resource_packed_get_draw_count(mesh);
+    }else if(mp_obj_is_type(mesh->vertices, &mp_type_list)){
         get_tri_verts_func = mesh_node_get_tri_verts_vec3_list;
         vertex_count = ((mp_obj_list_t*)mesh->vertices)->len;           // Each Vector3 element is a vertex
     }else if(mp_obj_is_type(mesh->vertices, &mp_type_bytearray)){
@@ -244,7 +257,9 @@ void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node){
         vertex_count = ((mp_obj_array_t*)mesh->vertices)->len/3;        // Every 3 bytes represents the xyz for a vertex (8-bit)
     }
 
-    if(mp_obj_is_type(mesh->triangle_colors, &mp_type_list)){
+    if(get_tri_colors_func != NULL){
+        // Already picked (packed)
+    }else if(mp_obj_is_type(mesh->triangle_colors, &mp_type_list)){
         if(((mp_obj_list_t*)mesh->triangle_colors)->len == 0){
             get_tri_colors_func = mesh_node_get_tri_color_default;
         }else{
@@ -259,7 +274,9 @@ void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node){
     }
 
 
-    if(mp_obj_is_type(mesh->uvs, &mp_type_list)){
+    if(get_tri_vert_uvs_func != NULL){
+        // Already picked (packed)
+    }else if(mp_obj_is_type(mesh->uvs, &mp_type_list)){
         get_tri_vert_uvs_func = mesh_node_get_tri_vert_uvs_list;
     }else if(mp_obj_is_type(mesh->uvs, &mp_type_bytearray)){
         get_tri_vert_uvs_func = mesh_node_get_tri_vert_uvs_uint8_array;
@@ -315,40 +332,20 @@ void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node){
     // glm_mat4_mul(camera->m_projection, m_final_view, mvp);
 
 
-    // https://stackoverflow.com/a/39881407
-    // https://stackoverflow.com/a/45647934
-    // https://www.opengl-tutorial.org/beginners-tutorials/tutorial-3-matrices/#:~:text=%2C%20myRotationAxis%20)%3B-,Cumulating%20transformations,-So%20now%20we
-    // https://www.reddit.com/r/opengl/comments/6cah2x/how_to_mvp_transformation_matrices_relate_to_each/
-    mat4 m_cam_lookat = GLM_MAT4_ZERO_INIT;
-    glm_lookat_rh_zo((vec3){0, 0, -1}, (vec3){0, 0, 0}, (vec3){0, 1, 0}, m_cam_lookat);
-
-    mat4 m_cam_scale = GLM_MAT4_ZERO_INIT;
-    glm_scale_make(m_cam_scale, (vec3){-1.0f, -1.0f, -1.0f});
-
-
-    mat4 m_cam_rotation = GLM_MAT4_ZERO_INIT;
-    glm_mat4_mul(camera->m_rotation, m_cam_lookat, m_cam_rotation);
-
-    mat4 m_cam_translation = GLM_MAT4_ZERO_INIT;
-    glm_mat4_mul(camera->m_translation, m_cam_scale, m_cam_translation);
+    // The camera only rebuilds its view and projection when it
+    // changed and the model matrix is only rebuilt when the mesh
+    // moved, leaving one multiply per mesh per camera here
+    camera_node_update_view_projection(camera);
 
-
-    mat4 m_cam_view = GLM_MAT4_ZERO_INIT;
-    glm_mat4_mul(m_cam_translation, m_cam_rotation, m_cam_view);
-    glm_mat4_inv(m_cam_view, m_cam_view);
-
-    mat4 m_model_view = GLM_MAT4_ZERO_INIT;
-    glm_mat4_mul(mesh_node->m_translation, mesh_node->m_rotation, m_model_view);
-
-
-    mat4 m_final_view = GLM_MAT4_ZERO_INIT;
-    glm_mat4_mul(m_cam_view, m_model_view, m_final_view);
+    if(mesh_node->model_dirty){
+        glm_mat4_mul(mesh_node->m_translation, mesh_node->m_rotation, mesh_node->m_model);
+        mesh_node->model_dirty = false;
+    }
 
     mat4 mvp = GLM_MAT4_ZERO_INIT;
-    glm_mat4_mul(camera->m_projection, m_final_view, mvp);
-    
+    glm_mat4_mul(camera->m_view_projection, mesh_node->m_model, mvp);
+
 
-    uint16_t vertex_index = 0;
     uint16_t triangle_color = mesh_color->value;
 
     vec3 v0 = GLM_VEC3_ZERO_INIT;
@@ -358,19 +355,43 @@ void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node){
     vec2 v0uv = GLM_VEC2_ZERO_INIT;
     vec2 v1uv = GLM_VEC2_ZERO_INIT;
     vec2 v2uv = GLM_VEC2_ZERO_INIT;
-    
-    // Loop through triangles and render them
-    while(vertex_index < vertex_count){
-        get_tri_vert_uvs_func(mesh->uvs, v0uv, v1uv, v2uv, mesh_texture->width, mesh_texture->height, vertex_index);
 
-        triangle_color = get_tri_colors_func(mesh->triangle_colors, vertex_index, mesh_color->value);
+    // Loop through chunks of triangles, project all of the chunk's vertices
+    // first and then set up and rasterize the triangles that use them
+    for(uint32_t chunk_start=0; chunk_start+2<vertex_count; chunk_start+=MESH_NODE_VERTEX_CACHE_SIZE){
+        uint32_t chunk_end = min(chunk_start + MESH_NODE_VERTEX_CACHE_SIZE, vertex_count - (vertex_count % 3));
+
+        for(uint32_t vertex_index=chunk_start; vertex_index<chunk_end; vertex_index+=3){
+            mesh_node_projected_vertex_t *projected = &vertex_cache[vertex_index - chunk_start];
+
+            get_tri_verts_func(vertex_data, v0, v1, v2, vertex_index);
 
-        get_tri_verts_func(mesh->vertices, v0, v1, v2, vertex_index);
+            mesh_node_project_vertex(v0, mvp, camera->v_viewport, &projected[0]);
+            mesh_node_project_vertex(v1, mvp, camera->v_viewport, &projected[1]);
+            mesh_node_project_vertex(v2, mvp, camera->v_viewport, &projected[2]);
+        }
+
+        for(uint32_t vertex_index=chunk_start; vertex_index<chunk_end; vertex_index+=3){
+            mesh_node_projected_vertex_t *p0 = &vertex_cache[vertex_index - chunk_start];
+            mesh_node_projected_vertex_t *p1 = p0 + 1;
+            mesh_node_projected_vertex_t *p2 = p0 + 2;
+
+            // Skip triangles with any vertex behind the camera or past the view distance
+            if(p0->in_front == false || p1->in_front == false || p2->in_front == false){
+                continue;
+            }
 
-        // Project and draw the triangle
-        mesh_node_project_draw(mesh_texture, v0, v1, v2, v0uv, v1uv, v2uv, mvp, camera->v_viewport, triangle_color, shader);
+            get_tri_vert_uvs_func(uv_data, v0uv, v1uv, v2uv, mesh_texture->width, mesh_texture->height, vertex_index);
 
-        vertex_index += 3;
+            triangle_color = get_tri_colors_func(triangle_color_data, vertex_index, mesh_color->value);
+
+            engine_draw_filled_triangle_depth(mesh_texture, triangle_color,
+                                              p0->x, p0->y, p0->z, v0uv[0], v0uv[1],
+                                              p1->x, p1->y, p1->z, v1uv[0], v1uv[1],
+                                              p2->x, p2->y, p2->z, v2uv[0], v2uv[1],
+                                              p0->w, p1->w, p2->w,
+                                              1.0f, shader);
+        }
     }
 }
 
@@ -597,6 +618,7 @@ mp_obj_t mesh_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_
     glm_translate_make(mesh_node->m_translation, (vec3){p->x.value, p->y.value, p->z.value});
     glm_euler((vec3){r->x.value, r->y.value, r->z.value}, mesh_node->m_rotation);
     glm_scale_make(mesh_node->m_scale, (vec3){s->x.value, s->y.value, s->z.value});
+    mesh_node->model_dirty = true;
 
     p->on_changed = mesh_node_set_translation;
     p->on_change_user_ptr = mesh_node;
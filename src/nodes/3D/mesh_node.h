@@ -28,6 +28,11 @@ typedef struct{
     mat4 m_rotation;
     mat4 m_scale;
     mat4 m_final_transformation;
+
+    // Model matrix used for drawing, only rebuilt
+    // after position, rotation or scale change
+    mat4 m_model;
+    bool model_dirty;
 }engine_mesh_node_class_obj_t;
 
 extern const mp_obj_type_t engine_mesh_node_class_type;
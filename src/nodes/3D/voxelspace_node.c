@@ -11,9 +11,11 @@
 #include "resources/engine_texture_resource.h"
 #include "draw/engine_display_draw.h"
 #include "draw/engine_shader.h"
+#include "draw/engine_draw_commands.h"
 #include "py/objarray.h"
 
 #include <string.h>
+#include <stdlib.h>
 
 
 int16_t height_buffer[SCREEN_WIDTH];
@@ -21,6 +23,210 @@ int16_t height_buffer[SCREEN_WIDTH];
 // Not sure if there is a correct way to calculate this, this seems to work well
 const float perspective_factor = 1.0f / SCREEN_HEIGHT_HALF;
 
+extern uint16_t *active_screen_buffer;
+
+
+// State shared by every depth slice drawn in `fast` mode
+typedef struct{
+    uint8_t *heights;                       // Heightmap converted to 0 ~ 255 grayscale, same indices as the heightmap
+    texture_resource_class_obj_t *texture;
+    uint16_t *texture_pixels;               // Set if the texture is RGB565 and can be read without the sampler
+    uint16_t *depth_buffer;
+    float map_x;
+    float map_z;
+    int32_t width;
+    int32_t height;
+    uint32_t width_mask;                    // `width - 1` if `width` is a power of two, otherwise 0
+    uint32_t height_mask;
+    uint32_t stride;
+    bool repeat;
+    bool flip;
+    bool column_open[SCREEN_WIDTH];         // False once nothing further away can show in the column
+    uint8_t open_column_count;
+    int32_t drawn_min_y;
+    int32_t drawn_max_y;
+}voxelspace_fast_t;
+
+
+// Grayscale of the RGB565 heightmap value as 0 ~ 255. Same weights
+// as the float conversion in the normal draw (scaled by 255 * 256)
+static inline uint8_t voxelspace_node_height_to_u8(uint16_t heightmap_value){
+    uint32_t r = (heightmap_value >> 0) & 0b00011111;
+    uint32_t g = (heightmap_value >> 5) & 0b00111111;
+    uint32_t b = (heightmap_value >> 11) & 0b00011111;
+    return min((448*r + 741*g + 152*b + 128) >> 8, 255);
+}
+
+
+// Converts the heightmap to 8-bit heights once instead of
+// sampling and converting it every column of every slice
+static void voxelspace_node_update_heights(engine_voxelspace_node_class_obj_t *voxelspace_node, texture_resource_class_obj_t *heightmap){
+    if(voxelspace_node->heights != NULL && voxelspace_node->heights_source == heightmap){
+        return;
+    }
+
+    uint32_t height_count = heightmap->pixel_stride * heightmap->height;
+    voxelspace_node->heights = m_new(uint8_t, height_count);
+    voxelspace_node->heights_source = heightmap;
+
+    for(uint32_t index=0; index<height_count; index++){
+        voxelspace_node->heights[index] = voxelspace_node_height_to_u8(heightmap->get_pixel(heightmap, index, NULL));
+    }
+}
+
+
+// Returns the number of fractional bits that values up to `magnitude`
+// can have and still fit in an int32_t, -1 if they can't fit at all
+static int8_t voxelspace_node_fixed_shift(float magnitude){
+    int8_t shift = 16;
+
+    while(shift >= 0 && magnitude * (float)(1 << shift) >= (float)(1 << 30)){
+        shift--;
+    }
+
+    return shift;
+}
+
+
+// `fmodf(fabsf(p), size)` is periodic away from zero: move a ray that
+// doesn't cross zero next to it, keeping what it samples the same, so
+// that it fits in fixed point no matter how far the camera has gone
+static void voxelspace_node_rebase_repeat(float *start, float *step, int32_t size){
+    float end = *start + *step * SCREEN_WIDTH;
+
+    if(*start <= 0.0f && end <= 0.0f){
+        *start = -*start;
+        *step = -*step;
+        end = -end;
+    }
+
+    if(*start >= 0.0f && end >= 0.0f){
+        *start -= floorf(fminf(*start, end) / size) * size;
+    }
+}
+
+
+static inline void voxelspace_node_fast_span(voxelspace_fast_t *fast, uint8_t column, int32_t row_start, int32_t row_count, uint16_t color, uint16_t depth){
+    uint16_t *depth_buffer = fast->depth_buffer;
+    uint32_t index = row_start * SCREEN_WIDTH + column;
+
+    for(int32_t row=0; row<row_count; row++){
+        if(depth < depth_buffer[index]){
+            depth_buffer[index] = depth;
+            active_screen_buffer[index] = color;
+        }
+        index += SCREEN_WIDTH;
+    }
+
+    fast->drawn_min_y = min(fast->drawn_min_y, row_start);
+    fast->drawn_max_y = max(fast->drawn_max_y, row_start + row_count - 1);
+}
+
+
+// Draws one depth slice across the screen with fixed point stepping. Each
+// column is sampled once and drawn as one vertical span straight into the
+// screen and depth buffers. Columns that are covered to the edge of the
+// screen are closed and never sampled again
+static void voxelspace_node_draw_slice_fast(voxelspace_fast_t *fast, float ray_x, float ray_y, float ray_dx, float ray_dy,
+                                            float height_base, float height_scale, float skew, float skew_dy,
+                                            int32_t thickness_pixels, uint16_t depth){
+    if(fast->repeat){
+        voxelspace_node_rebase_repeat(&ray_x, &ray_dx, fast->width);
+        voxelspace_node_rebase_repeat(&ray_y, &ray_dy, fast->height);
+    }else{
+        ray_x -= fast->map_x;
+        ray_y -= fast->map_z;
+    }
+
+    float ray_magnitude = fmaxf(fmaxf(fabsf(ray_x), fabsf(ray_x + ray_dx * SCREEN_WIDTH)), fmaxf(fabsf(ray_y), fabsf(ray_y + ray_dy * SCREEN_WIDTH)));
+    float height_magnitude = fabsf(height_base) + fabsf(height_scale) * 255.0f + fabsf(skew) + fabsf(skew_dy) * SCREEN_WIDTH;
+
+    int8_t ray_shift = voxelspace_node_fixed_shift(ray_magnitude);
+    int8_t height_shift = voxelspace_node_fixed_shift(height_magnitude);
+
+    // Only happens absurdly far from the terrain or camera
+    if(ray_shift < 0 || height_shift < 0){
+        return;
+    }
+
+    float ray_one = (float)(1 << ray_shift);
+    float height_one = (float)(1 << height_shift);
+
+    int32_t x_q = (int32_t)(ray_x * ray_one);
+    int32_t y_q = (int32_t)(ray_y * ray_one);
+    int32_t dx_q = (int32_t)(ray_dx * ray_one);
+    int32_t dy_q = (int32_t)(ray_dy * ray_one);
+    int32_t height_base_q = (int32_t)(height_base * height_one);
+    int32_t height_scale_q = (int32_t)(height_scale * height_one);
+    int32_t skew_q = (int32_t)(skew * height_one);
+    int32_t skew_dy_q = (int32_t)(skew_dy * height_one);
+
+    for(uint8_t i=0; i<SCREEN_WIDTH; i++, x_q+=dx_q, y_q+=dy_q, skew_q+=skew_dy_q){
+        if(fast->column_open[i] == false){
+            continue;
+        }
+
+        int32_t x = 0;
+        int32_t y = 0;
+
+        if(fast->repeat){
+            x = abs(x_q) >> ray_shift;
+            y = abs(y_q) >> ray_shift;
+            x = (fast->width_mask != 0) ? (x & fast->width_mask) : (x % fast->width);
+            y = (fast->height_mask != 0) ? (y & fast->height_mask) : (y % fast->height);
+        }else{
+            x = x_q >> ray_shift;
+            y = y_q >> ray_shift;
+
+            if(x < 0 || x >= fast->width || y < 0 || y >= fast->height){
+                continue;
+            }
+        }
+
+        uint32_t index = y * fast->stride + x;
+        int32_t height_on_screen = (height_base_q + fast->heights[index] * height_scale_q + skew_q) >> height_shift;
+        int16_t *column_height = &height_buffer[i];
+
+        int32_t row_start = 0;
+        int32_t row_count = 0;
+
+        if(fast->flip){
+            int32_t row_end = min(height_on_screen, SCREEN_HEIGHT-1);
+            row_count = min(row_end - max(*column_height, 0) + 1, thickness_pixels);
+            row_start = row_end - row_count + 1;
+
+            if(height_on_screen > *column_height){
+                *column_height = min(height_on_screen, SCREEN_HEIGHT);
+            }
+        }else{
+            row_start = max(height_on_screen, 0);
+            row_count = min(min(*column_height, SCREEN_HEIGHT) - row_start, thickness_pixels);
+
+            if(height_on_screen < *column_height){
+                *column_height = max(height_on_screen, 0);
+            }
+        }
+
+        if(row_count > 0){
+            uint16_t color = 0;
+
+            if(fast->texture_pixels != NULL){
+                color = fast->texture_pixels[index];
+            }else{
+                color = fast->texture->get_pixel(fast->texture, index, NULL);
+            }
+
+            voxelspace_node_fast_span(fast, i, row_start, row_count, color, depth);
+        }
+
+        // Anything further away in this column would be behind what's drawn
+        if((fast->flip && *column_height >= SCREEN_HEIGHT-1) || (fast->flip == false && *column_height <= 0)){
+            fast->column_open[i] = false;
+            fast->open_column_count--;
+        }
+    }
+}
+
 
 void voxelspace_node_class_draw(mp_obj_t voxelspace_node_base_obj, mp_obj_t camera_node){
     ENGINE_INFO_PRINTF("VoxelSpaceNode: Drawing");
@@ -43,13 +249,16 @@ void voxelspace_node_class_draw(mp_obj_t voxelspace_node_base_obj, mp_obj_t came
     float lod = mp_obj_get_float(voxelspace_node->lod);
     float curvature_angle = mp_obj_get_float(voxelspace_node->curvature);
     float thickness = mp_obj_get_float(voxelspace_node->thickness);
+    bool fast = mp_obj_is_true(voxelspace_node->fast);
 
     vector3_class_obj_t *camera_rotation = camera->rotation;
     vector3_class_obj_t *camera_position = camera->position;
     float camera_fov_half_rad = (mp_obj_get_float(camera->fov) * PI / 180.0f) * 0.5f;
     float camera_view_distance = mp_obj_get_float(camera->view_distance);
 
-    engine_shader_t *shader = engine_get_builtin_shader(EMPTY_SHADER);
+    // Depth is checked directly against the depth buffer below, so
+    // draw now instead of recording a command for every pixel
+    engine_draw_commands_begin_immediate();
 
     // memset(height_buffer, SCREEN_HEIGHT, SCREEN_WIDTH*2);
     for(uint16_t i=0; i<SCREEN_WIDTH; i++){
@@ -107,6 +316,38 @@ void voxelspace_node_class_draw(mp_obj_t voxelspace_node_base_obj, mp_obj_t came
     // want to render at
     float hypot = camera_view_distance / cosf(camera_fov_half_rad);
 
+    voxelspace_fast_t fast_state;
+
+    // Rows drawn to by the default path, damaged once at the end
+    int32_t drawn_min_y = SCREEN_HEIGHT;
+    int32_t drawn_max_y = -1;
+
+    if(fast){
+        voxelspace_node_update_heights(voxelspace_node, heightmap);
+
+        fast_state.heights = voxelspace_node->heights;
+        fast_state.texture = texture;
+        fast_state.texture_pixels = NULL;
+        fast_state.depth_buffer = engine_display_get_depth_buffer();
+        fast_state.map_x = voxelspace_position->x.value;
+        fast_state.map_z = voxelspace_position->z.value;
+        fast_state.width = heightmap->width;
+        fast_state.height = heightmap->height;
+        fast_state.width_mask = ((heightmap->width & (heightmap->width - 1)) == 0) ? heightmap->width - 1 : 0;
+        fast_state.height_mask = ((heightmap->height & (heightmap->height - 1)) == 0) ? heightmap->height - 1 : 0;
+        fast_state.stride = heightmap->pixel_stride;
+        fast_state.repeat = repeat;
+        fast_state.flip = flip;
+        fast_state.open_column_count = SCREEN_WIDTH;
+        fast_state.drawn_min_y = SCREEN_HEIGHT;
+        fast_state.drawn_max_y = -1;
+        memset(fast_state.column_open, true, SCREEN_WIDTH);
+
+        if(texture->get_pixel == texture_resource_get_16bit_rgb565){
+            fast_state.texture_pixels = (uint16_t*)((mp_obj_array_t*)texture->data)->items;
+        }
+    }
+
     while(z < hypot){
         float pleft_x = z * view_left_x;
         float pleft_y = z * view_left_y;
@@ -130,96 +371,128 @@ void voxelspace_node_class_draw(mp_obj_t voxelspace_node_base_obj, mp_obj_t came
         // and then scale to the max allowed in the depth buffer
         uint16_t depth = (uint16_t)((z / hypot) * UINT16_MAX);
 
-        for(uint8_t i=0; i<SCREEN_WIDTH; i++){
-            int32_t x = 0;
-            int32_t y = 0;
-
-            // Check if the terrain should render forever (repeat) or only in bounds
-            if(repeat == false){
-                x = (int32_t)pleft_x;
-                y = (int32_t)pleft_y;
-
-                // Only need to check bounds if repeat is not
-                // true, continue for-loop if out of bounds
-                if(x < voxelspace_position->x.value || x >= voxelspace_position->x.value + heightmap->width || y < voxelspace_position->z.value || y >= voxelspace_position->z.value+heightmap->height){
-                    pleft_x += dx;
-                    pleft_y += dy;
-                    continue;
-                }
-            }else{
-                x = (int32_t)fmodf(fabsf(pleft_x), heightmap->width);
-                y = (int32_t)fmodf(fabsf(pleft_y), heightmap->height);
-            }
+        if(fast){
+            // Reciprocal once per slice instead of a divide per column
+            float inverse_perspective = 1.0f / perspective;
 
-            // Now that we know we have a position to sample, sample it
-            uint32_t index = (uint32_t)((y-voxelspace_position->z.value) * heightmap->pixel_stride + (x-voxelspace_position->x.value));
-
-            // Get each RGB channel as a float
-            uint16_t heightmap_value = heightmap->get_pixel(heightmap, index, NULL);
-            float r = (heightmap_value >> 0) & 0b00011111;
-            float g = (heightmap_value >> 5) & 0b00111111;
-            float b = (heightmap_value >> 11) & 0b00011111;
-
-            // Change from RGB565 (already normalized to 0.0 ~ 1.0 for each channel) to grayscale 0.0 ~ 1.0: https://en.wikipedia.org/wiki/Grayscale#:~:text=Ylinear%2C-,which%20is%20given%20by,-%5B6%5D
-            // Divided each channel coefficient by their respective bit resolution to avoid 3 divides
-            float altitude = (0.006858f*r + 0.01135f*g + 0.00233f*b);   // <- Convert to grayscale 0.0 ~ 1.0
-            if(flip == false) altitude = -altitude;                     // <- flip so that the camera is look at base/water level by default
-            altitude *= voxelspace_scale->y.value;                      // Scale height from 0.0 ~ 1.0 to y-axis scale
-            altitude -= voxelspace_position->y.value;                   // Apply voxelspace node translation
-            altitude += camera_position->y.value;                       // Apply camera view translation
-
-            // Use camera_rotation for on x-axis for pitch (head going in up/down in 'yes' motion)
-            int16_t height_on_screen = (int16_t)(((SCREEN_HEIGHT_HALF + (altitude / perspective)) + view_angle) + curvature + skew_roll_offset);
-            skew_roll_offset += skew_roll_line_dy;
-
-            int16_t ipx = height_on_screen;
-
-            // Clip to screen bounds so we don't draw more than needed
-            if(height_on_screen >= SCREEN_HEIGHT){
-                ipx = SCREEN_HEIGHT;
-            }else if(height_on_screen < 0){
-                ipx = -1;
-            }
+            voxelspace_node_draw_slice_fast(&fast_state, pleft_x, pleft_y, dx, dy,
+                                            SCREEN_HEIGHT_HALF + view_angle + curvature + (camera_position->y.value - voxelspace_position->y.value) * inverse_perspective,
+                                            (flip ? 1.0f : -1.0f) * voxelspace_scale->y.value * (1.0f / 255.0f) * inverse_perspective,
+                                            skew_roll_offset, skew_roll_line_dy,
+                                            min((int32_t)ceilf(thickness * inverse_perspective), SCREEN_HEIGHT), depth);
 
-            if(flip){
-                float drawn_thickness = 0;
-                while(ipx >= height_buffer[i] && drawn_thickness < thickness){
-                    if(engine_display_store_check_depth(i, ipx, depth)){
-                        
-                        engine_draw_pixel(texture->get_pixel(texture, index, NULL), i, ipx, 1.0f, shader);
+            // Every column is covered, nothing further away can be seen
+            if(fast_state.open_column_count == 0){
+                break;
+            }
+        }else{
+            for(uint8_t i=0; i<SCREEN_WIDTH; i++){
+                int32_t x = 0;
+                int32_t y = 0;
+
+                // Check if the terrain should render forever (repeat) or only in bounds
+                if(repeat == false){
+                    x = (int32_t)pleft_x;
+                    y = (int32_t)pleft_y;
+
+                    // Only need to check bounds if repeat is not
+                    // true, continue for-loop if out of bounds
+                    if(x < voxelspace_position->x.value || x >= voxelspace_position->x.value + heightmap->width || y < voxelspace_position->z.value || y >= voxelspace_position->z.value+heightmap->height){
+                        pleft_x += dx;
+                        pleft_y += dy;
+                        continue;
                     }
-                    ipx--;
-                    drawn_thickness += perspective;
+                }else{
+                    x = (int32_t)fmodf(fabsf(pleft_x), heightmap->width);
+                    y = (int32_t)fmodf(fabsf(pleft_y), heightmap->height);
                 }
 
-                // Track the height in the buffer
-                if(height_on_screen > height_buffer[i]){
-                    height_buffer[i] = height_on_screen;
+                // Now that we know we have a position to sample, sample it
+                uint32_t index = (uint32_t)((y-voxelspace_position->z.value) * heightmap->pixel_stride + (x-voxelspace_position->x.value));
+
+                // Get each RGB channel as a float
+                uint16_t heightmap_value = heightmap->get_pixel(heightmap, index, NULL);
+                float r = (heightmap_value >> 0) & 0b00011111;
+                float g = (heightmap_value >> 5) & 0b00111111;
+                float b = (heightmap_value >> 11) & 0b00011111;
+
+                // Change from RGB565 (already normalized to 0.0 ~ 1.0 for each channel) to grayscale 0.0 ~ 1.0: https://en.wikipedia.org/wiki/Grayscale#:~:text=Ylinear%2C-,which%20is%20given%20by,-%5B6%5D
+                // Divided each channel coefficient by their respective bit resolution to avoid 3 divides
+                float altitude = (0.006858f*r + 0.01135f*g + 0.00233f*b);   // <- Convert to grayscale 0.0 ~ 1.0
+                if(flip == false) altitude = -altitude;                     // <- flip so that the camera is look at base/water level by default
+                altitude *= voxelspace_scale->y.value;                      // Scale height from 0.0 ~ 1.0 to y-axis scale
+                altitude -= voxelspace_position->y.value;                   // Apply voxelspace node translation
+                altitude += camera_position->y.value;                       // Apply camera view translation
+
+                // Use camera_rotation for on x-axis for pitch (head going in up/down in 'yes' motion)
+                int16_t height_on_screen = (int16_t)(((SCREEN_HEIGHT_HALF + (altitude / perspective)) + view_angle) + curvature + skew_roll_offset);
+                skew_roll_offset += skew_roll_line_dy;
+
+                int16_t ipx = height_on_screen;
+
+                // Clip to screen bounds so we don't draw more than needed
+                if(height_on_screen >= SCREEN_HEIGHT){
+                    ipx = SCREEN_HEIGHT;
+                }else if(height_on_screen < 0){
+                    ipx = -1;
                 }
-            }else{
-                float drawn_thickness = 0;
-                while(ipx < height_buffer[i] && drawn_thickness < thickness){
-                    if(engine_display_store_check_depth(i, ipx, depth)){
-                        engine_draw_pixel(texture->get_pixel(texture, index, NULL), i, ipx, 1.0f, shader);
+
+                if(flip){
+                    float drawn_thickness = 0;
+                    while(ipx >= height_buffer[i] && drawn_thickness < thickness){
+                        if(ipx >= 0 && ipx < SCREEN_HEIGHT && engine_display_store_check_depth(i, ipx, depth)){
+                            active_screen_buffer[ipx * SCREEN_WIDTH + i] = texture->get_pixel(texture, index, NULL);
+                            drawn_min_y = min(drawn_min_y, ipx);
+                            drawn_max_y = max(drawn_max_y, ipx);
+                        }
+                        ipx--;
+                        drawn_thickness += perspective;
                     }
-                    ipx++;
-                    drawn_thickness += perspective;
-                }
 
-                // Track the height in the buffer
-                if(height_on_screen < height_buffer[i]){
-                    height_buffer[i] = height_on_screen;
+                    // Track the height in the buffer
+                    if(height_on_screen > height_buffer[i]){
+                        height_buffer[i] = height_on_screen;
+                    }
+                }else{
+                    float drawn_thickness = 0;
+                    while(ipx < height_buffer[i] && drawn_thickness < thickness){
+                        if(ipx >= 0 && ipx < SCREEN_HEIGHT && engine_display_store_check_depth(i, ipx, depth)){
+                            active_screen_buffer[ipx * SCREEN_WIDTH + i] = texture->get_pixel(texture, index, NULL);
+                            drawn_min_y = min(drawn_min_y, ipx);
+                            drawn_max_y = max(drawn_max_y, ipx);
+                        }
+                        ipx++;
+                        drawn_thickness += perspective;
+                    }
+
+                    // Track the height in the buffer
+                    if(height_on_screen < height_buffer[i]){
+                        height_buffer[i] = height_on_screen;
+                    }
                 }
-            }
 
-            pleft_x += dx;
-            pleft_y += dy;
+                pleft_x += dx;
+                pleft_y += dy;
+            }
         }
 
         z += dz;
         dz += lod;
         curvature += curvature_dy;
     }
+
+    if(fast){
+        drawn_min_y = fast_state.drawn_min_y;
+        drawn_max_y = fast_state.drawn_max_y;
+    }
+
+    // Pixels are written straight to the screen buffer by
+    // both paths, damage every row that was drawn to at once
+    if(drawn_min_y <= drawn_max_y){
+        engine_display_damage_rect(0, drawn_min_y, SCREEN_WIDTH, drawn_max_y + 1);
+    }
+
+    engine_draw_commands_end_immediate();
 }
 
 
@@ -338,6 +611,10 @@ bool voxelspace_node_load_attr(engine_node_base_t *self_node_base, qstr attribut
             destination[0] = self->thickness;
             return true;
         break;
+        case MP_QSTR_fast:
+            destination[0] = self->fast;
+            return true;
+        break;
         case MP_QSTR_global_position:
             mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("ERROR: `global_position` is not supported on this node yet!"));
             return true;
@@ -368,6 +645,7 @@ bool voxelspace_node_store_attr(engine_node_base_t *self_node_base, qstr attribu
         break;
         case MP_QSTR_heightmap:
             self->heightmap_resource = destination[1];
+            self->heights = NULL;
             return true;
         break;
         case MP_QSTR_rotation:
@@ -398,6 +676,10 @@ bool voxelspace_node_store_attr(engine_node_base_t *self_node_base, qstr attribu
             self->thickness = destination[1];
             return true;
         break;
+        case MP_QSTR_fast:
+            self->fast = destination[1];
+            return true;
+        break;
         case MP_QSTR_global_position:
             mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("ERROR: `global_position` is not supported on this node yet!"));
             return true;
@@ -447,6 +729,7 @@ static mp_attr_fun_t voxelspace_node_class_attr(mp_obj_t self_in, qstr attribute
     ATTR:   [type=float]                      [name=lod]                                        [value=any (stand for Level Of Detail and affects the quality/number of samples as the view is rendered at further and further distances, default: 0.0085)]
     ATTR:   [type=float]                      [name=curvature]                                  [value=any (radians, defines how much the terrain curves as the render distance increases, default: 0.0)]
     ATTR:   [type=float]                      [name=thickness]                                  [value=any (defines how thick the terrain should look if you can see its sides, default: 128.0)]
+    ATTR:   [type=boolean]                    [name=fast]                                       [value=True or False (if True, draws with a fixed point renderer that stops working on columns of the screen once they are covered, default: False). The heightmap is converted to an 8-bit copy (width * height bytes) the first time it's drawn, set `heightmap` again after changing its pixels]
     ATTR:   [type=int]                        [name=layer]                                      [value=0 ~ 127]
     OVRR:   [type=function]                   [name={ref_link:tick}]                            [value=function]
 */
@@ -468,10 +751,11 @@ mp_obj_t voxelspace_node_class_new(const mp_obj_type_t *type, size_t n_args, siz
         { MP_QSTR_lod,          MP_ARG_OBJ, {.u_obj = mp_obj_new_float(0.0085f)} },
         { MP_QSTR_curvature,    MP_ARG_OBJ, {.u_obj = mp_obj_new_float(0.0f)} },
         { MP_QSTR_thickness,    MP_ARG_OBJ, {.u_obj = mp_obj_new_float(128.0f)} },
+        { MP_QSTR_fast,         MP_ARG_OBJ, {.u_obj = mp_obj_new_bool(false)} },
         { MP_QSTR_layer,        MP_ARG_INT, {.u_int = 0} }
     };
     mp_arg_val_t parsed_args[MP_ARRAY_SIZE(allowed_args)];
-    enum arg_ids {child_class, position, texture, heightmap, rotation, scale, repeat, flip, lod, curvature, thickness, layer};
+    enum arg_ids {child_class, position, texture, heightmap, rotation, scale, repeat, flip, lod, curvature, thickness, fast, layer};
     bool inherited = false;
 
     // If there is one positional argument and it isn't the first
@@ -509,6 +793,9 @@ mp_obj_t voxelspace_node_class_new(const mp_obj_type_t *type, size_t n_args, siz
     voxelspace_node->lod = parsed_args[lod].u_obj;
     voxelspace_node->curvature = parsed_args[curvature].u_obj;
     voxelspace_node->thickness = parsed_args[thickness].u_obj;
+    voxelspace_node->fast = parsed_args[fast].u_obj;
+    voxelspace_node->heights = NULL;
+    voxelspace_node->heights_source = mp_const_none;
 
     if(inherited == true){  // Inherited (use existing object)
         // Get the Python class instance
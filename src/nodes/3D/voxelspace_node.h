@@ -16,7 +16,11 @@ typedef struct{
     mp_obj_t lod;
     mp_obj_t curvature;
     mp_obj_t thickness;
+    mp_obj_t fast;                  // Bool: draw with the fixed point column renderer
     mp_obj_t tick_cb;
+
+    uint8_t *heights;               // 8-bit heights for `fast`, converted from `heights_source` on first draw
+    mp_obj_t heights_source;
 }engine_voxelspace_node_class_obj_t;
 
 extern const mp_obj_type_t engine_voxelspace_node_class_type;
@@ -30,14 +30,18 @@
 */
 void (*default_instance_attr_func)(mp_obj_t self_in, qstr attribute, mp_obj_t *destination) = NULL;
 
+// Starts at 1 so that new nodes (epoch 0) always resolve their transform
+static uint32_t node_base_transform_epoch = 1;
+
 
 void node_base_init(engine_node_base_t *node_base, const mp_obj_type_t *mp_type, uint8_t node_type, uint8_t layer){
     node_base->base.type = mp_type;
     node_base->layer = layer;
     node_base->type = node_type;
-    node_base->object_list_node = engine_add_object_to_layer(node_base, node_base->layer);
+    engine_add_object_to_layer(node_base, node_base->layer);
     node_base->deletable_list_node = NULL;
     node_base->parent_node_base = NULL;
+    node_base->world_transform_epoch = 0;
     node_base_set_if_visible(node_base, true);
     node_base_set_if_disabled(node_base, false);
     node_base_set_if_just_added(node_base, true);
@@ -120,6 +124,9 @@ TRACE_DECL(mp_obj_t node_base_del, (mp_obj_t self_in),
 
     engine_node_base_t *node_base = self_in;
 
+    // Children lose this as a parent below
+    node_base_invalidate_transforms();
+
     // If this is a child of another node, remove this as a child
     if(node_base->parent_node_base != NULL){
         engine_node_base_t *parent_node_base = node_base->parent_node_base;
@@ -142,13 +149,13 @@ TRACE_DECL(mp_obj_t node_base_del, (mp_obj_t self_in),
             linked_list_node *next_child_node_base = current_child_node_base->next;
 
             // This linked list is being deleted, free each node as we go
-            free(current_child_node_base);
+            linked_list_free_node(current_child_node_base);
 
             current_child_node_base = next_child_node_base;
         }
     }
 
-    engine_remove_object_from_layer(node_base->object_list_node, node_base->layer);
+    engine_remove_object_from_layer(node_base);
     engine_collections_untrack_deletable(node_base->deletable_list_node);
 
     return mp_const_none;
@@ -234,6 +241,7 @@ TRACE_DECL(mp_obj_t node_base_add_child, (mp_obj_t self_parent_in, mp_obj_t chil
 
     child_node_base->location_in_parents_children = linked_list_add_obj(&parent_node_base->children_node_bases, child_node_base);
     child_node_base->parent_node_base = parent_node_base;
+    node_base_invalidate_transforms();
 
     return mp_const_none;
 )
@@ -304,6 +312,7 @@ TRACE_DECL(mp_obj_t node_base_remove_child, (mp_obj_t self_parent_in, mp_obj_t c
         linked_list_del_list_node(&parent_node_base->children_node_bases, child_node_base->location_in_parents_children);
         child_node_base->parent_node_base = NULL;
         child_node_base->location_in_parents_children = NULL;
+        node_base_invalidate_transforms();
     }else{
         mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Child node does not exist on this parent, cannot remove!"));
     }
@@ -330,37 +339,114 @@ mp_obj_t node_base_get_parent(mp_obj_t self_in){
 
 
 void node_base_set_layer(engine_node_base_t *node_base, uint8_t layer){
-    engine_remove_object_from_layer(node_base->object_list_node, node_base->layer);
+    engine_remove_object_from_layer(node_base);
     node_base->layer = layer;
-    node_base->object_list_node = engine_add_object_to_layer(node_base, node_base->layer);
+    engine_add_object_to_layer(node_base, node_base->layer);
 }
 
 
-void node_base_get_child_absolute_xy(float *x, float *y, float *rotation, bool *is_child_of_camera, mp_obj_t child_node_base_in){
-    engine_node_base_t *child_node_base = child_node_base_in;
-    if(is_child_of_camera != NULL) *is_child_of_camera = false;
+void node_base_invalidate_transforms(){
+    node_base_transform_epoch++;
 
-    mp_obj_t child_node_base_position_obj = mp_load_attr(child_node_base->attr_accessor, MP_QSTR_position);
-    if(mp_obj_is_type(child_node_base_position_obj, &vector3_class_type)){
-        *x = ((vector3_class_obj_t*)child_node_base_position_obj)->x.value;
-        *y = ((vector3_class_obj_t*)child_node_base_position_obj)->y.value;
+    // Keep 0 meaning "never resolved"
+    if(node_base_transform_epoch == 0){
+        node_base_transform_epoch = 1;
+    }
+}
+
+
+// Position and z-axis rotation of a node relative to its parent
+static void node_base_get_local_xy(engine_node_base_t *node_base, float *x, float *y, float *rotation){
+    mp_obj_t position_obj = mp_load_attr(node_base->attr_accessor, MP_QSTR_position);
+    if(mp_obj_is_type(position_obj, &vector3_class_type)){
+        *x = ((vector3_class_obj_t*)position_obj)->x.value;
+        *y = ((vector3_class_obj_t*)position_obj)->y.value;
     }else{
-        *x = ((vector2_class_obj_t*)child_node_base_position_obj)->x.value;
-        *y = ((vector2_class_obj_t*)child_node_base_position_obj)->y.value;
+        *x = ((vector2_class_obj_t*)position_obj)->x.value;
+        *y = ((vector2_class_obj_t*)position_obj)->y.value;
     }
 
-    mp_obj_t rotation_obj = engine_mp_load_attr_maybe(child_node_base->attr_accessor, MP_QSTR_rotation);
+    mp_obj_t rotation_obj = engine_mp_load_attr_maybe(node_base->attr_accessor, MP_QSTR_rotation);
 
     // Use z-axis rotation for 2D rotations from 3D vectors
     if(rotation_obj == MP_OBJ_NULL){
         // In the case that the rotation attribute does not exist on this node, set rotation to 0
-        if(rotation != NULL) *rotation = 0.0f;
+        *rotation = 0.0f;
     }else if(mp_obj_is_type(rotation_obj, &vector3_class_type)){
-        if(rotation != NULL) *rotation = ((vector3_class_obj_t*)rotation_obj)->z.value;
+        *rotation = ((vector3_class_obj_t*)rotation_obj)->z.value;
     }else{
-        if(rotation != NULL) *rotation = (float)mp_obj_get_float(rotation_obj);
+        *rotation = (float)mp_obj_get_float(rotation_obj);
+    }
+}
+
+
+// Resolves parents first so every node in a hierarchy loads its
+// own attributes once per epoch instead of once per descendant
+static void node_base_resolve_world_transform(engine_node_base_t *node_base){
+    if(node_base->world_transform_epoch == node_base_transform_epoch){
+        return;
     }
 
+    float x = 0.0f;
+    float y = 0.0f;
+    float rotation = 0.0f;
+    bool is_child_of_camera = false;
+
+    node_base_get_local_xy(node_base, &x, &y, &rotation);
+
+    engine_node_base_t *parent_node_base = node_base->parent_node_base;
+
+    if(parent_node_base != NULL){
+        if(parent_node_base->type == NODE_TYPE_CAMERA){
+            // Children of cameras stay relative to the
+            // camera, nothing above is applied to them
+            is_child_of_camera = true;
+        }else{
+            node_base_resolve_world_transform(parent_node_base);
+            is_child_of_camera = parent_node_base->world_is_child_of_camera;
+
+            if(engine_math_compare_floats(parent_node_base->world_rotation, 0.0f) == false){
+                engine_math_rotate_point(&x, &y, 0.0f, 0.0f, parent_node_base->world_rotation);
+            }
+
+            x += parent_node_base->world_x;
+            y += parent_node_base->world_y;
+            rotation += parent_node_base->world_rotation;
+        }
+    }
+
+    node_base->world_x = x;
+    node_base->world_y = y;
+    node_base->world_rotation = rotation;
+    node_base->world_is_child_of_camera = is_child_of_camera;
+    node_base->world_transform_epoch = node_base_transform_epoch;
+}
+
+
+void node_base_get_child_absolute_xy(float *x, float *y, float *rotation, bool *is_child_of_camera, mp_obj_t child_node_base_in){
+    engine_node_base_t *child_node_base = child_node_base_in;
+
+    // Drawing and physics always ask for the rotation. The cached
+    // transform stops at camera parents, so it also works for callers
+    // not asking about that as long as there is no camera parent
+    if(rotation != NULL){
+        node_base_resolve_world_transform(child_node_base);
+
+        if(is_child_of_camera != NULL || child_node_base->world_is_child_of_camera == false){
+            *x = child_node_base->world_x;
+            *y = child_node_base->world_y;
+            *rotation = child_node_base->world_rotation;
+            if(is_child_of_camera != NULL) *is_child_of_camera = child_node_base->world_is_child_of_camera;
+            return;
+        }
+    }
+
+    if(is_child_of_camera != NULL) *is_child_of_camera = false;
+
+    float local_rotation = 0.0f;
+    node_base_get_local_xy(child_node_base, x, y, &local_rotation);
+    if(rotation != NULL) *rotation = local_rotation;
+
     // Before doing anything, check if this child even has a parent
     if(child_node_base->parent_node_base != NULL){
         engine_node_base_t *seeking_node_base = child_node_base;
@@ -542,6 +628,16 @@ void node_base_attr_handler(mp_obj_t self, qstr attr, mp_obj_t *dest,
     // to call in the inner loop
     attr_handler_func current_attr_function = NULL;
 
+    // Anything below this node may have moved
+    if(dest[0] != MP_OBJ_NULL && dest[1] != MP_OBJ_NULL && (attr == MP_QSTR_position || attr == MP_QSTR_rotation)){
+        node_base_invalidate_transforms();
+    }
+
+    // The layers keep their own copy of the tick callback
+    if(dest[0] != MP_OBJ_NULL && dest[1] != MP_OBJ_NULL && attr == MP_QSTR_tick){
+        engine_object_layers_invalidate_tick_cb(node_base);
+    }
+
     for(uint8_t i=0; i<attr_function_count; i++){
         // Check if a load or store operation, set flag depending
         bool is_store = false;
@@ -12,9 +12,9 @@
 
 typedef struct{
     mp_obj_base_t base;                     // All nodes get defined by what is placed in this
-    linked_list_node *object_list_node;     // Pointer to where this node is stored in the layers of linked lists the engine tracks (used for easy linked list deletion)
+    uint16_t object_index;                  // Index of this node in the array of the layer the engine tracks it in (used for easy deletion)
     linked_list_node *deletable_list_node;  // Pointer to delete linked list node so that node can remove itself from the list if gc'ed before node clear step
-    uint8_t layer;                          // The layer index of the linked list the 'object_list_node' lives in (used for easy deletion)
+    uint8_t layer;                          // The layer index of the array 'object_index' is in (used for easy deletion)
     uint8_t meta_data;                      // Holds bits related to if this node is visible (not shown or shown but callbacks still called), disabled (callbacks not called but still shown), or just added
     uint8_t type;                           // The type of this node (see 'node_types.h')
     void *attr_accessor;                    // Used in conjunction with mp_get_attr
@@ -23,6 +23,12 @@ typedef struct{
     linked_list children_node_bases;                // Linked list of child node_bases
     void *parent_node_base;                         // If this is a child, pointer to parent node_base (can only have one parent)
     linked_list_node *location_in_parents_children; // The location of this node in the parents linked list of children (used for easy deletion upon garbage collection of this node)
+
+    float world_x;                                  // Cached absolute position and rotation from `node_base_get_child_absolute_xy`
+    float world_y;
+    float world_rotation;
+    bool world_is_child_of_camera;
+    uint32_t world_transform_epoch;                 // Cached values above are only valid while this matches the global transform epoch
 }engine_node_base_t;
 
 
@@ -70,6 +76,12 @@ static MP_DEFINE_CONST_FUN_OBJ_1(node_base_get_parent_obj, node_base_get_parent)
 
 void node_base_get_child_absolute_xy(float *x, float *y, float *rotation, bool *is_child_of_camera, mp_obj_t child_node_base);
 
+// Marks every cached absolute position/rotation as stale. Positions can
+// be changed in place (`node.position.x += 1`) without the node seeing
+// it, so this is also called before each pass that reads them (drawing,
+// physics) and after any Python callback in the middle of one
+void node_base_invalidate_transforms();
+
 void node_base_set_attr_handler_default(mp_obj_t node_instance);
 void node_base_use_default_attr_handler(mp_obj_t self_in, qstr attribute, mp_obj_t *destination);
 
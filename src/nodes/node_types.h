@@ -20,5 +20,6 @@
 #define NODE_TYPE_MESH_3D               11  // https://www.scratchapixel.com/lessons/3d-basic-rendering/computing-pixel-coordinates-of-3d-point/mathematics-computing-2d-coordinates-of-3d-points.html
 #define NODE_TYPE_GUI_BUTTON_2D         12
 #define NODE_TYPE_GUI_BITMAP_BUTTON_2D  13
+#define NODE_TYPE_TILE_MAP_2D           14
 
 #endif  // NODE_TYPES_H
\ No newline at end of file
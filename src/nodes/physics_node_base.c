@@ -116,19 +116,19 @@ bool physics_node_base_load_attr(engine_node_base_t *self_node_base, qstr attrib
             return true;
         break;
         case MP_QSTR_friction:
-            destination[0] = self->friction;
+            destination[0] = mp_obj_new_float(self->friction);
             return true;
         break;
         case MP_QSTR_bounciness:
-            destination[0] = self->bounciness;
+            destination[0] = mp_obj_new_float(self->bounciness);
             return true;
         break;
         case MP_QSTR_dynamic:
-            destination[0] = self->dynamic;
+            destination[0] = mp_obj_new_bool(self->dynamic);
             return true;
         break;
         case MP_QSTR_solid:
-            destination[0] = self->solid;
+            destination[0] = mp_obj_new_bool(self->solid);
             return true;
         break;
         case MP_QSTR_gravity_scale:
@@ -229,19 +229,19 @@ bool physics_node_base_store_attr(engine_node_base_t *self_node_base, qstr attri
             return true;
         break;
         case MP_QSTR_friction:
-            self->friction = destination[1];
+            self->friction = mp_obj_get_float(destination[1]);
             return true;
         break;
         case MP_QSTR_bounciness:
-            self->bounciness = destination[1];
+            self->bounciness = mp_obj_get_float(destination[1]);
             return true;
         break;
         case MP_QSTR_dynamic:
-            self->dynamic = destination[1];
+            self->dynamic = mp_obj_get_int(destination[1]);
             return true;
         break;
         case MP_QSTR_solid:
-            self->solid = destination[1];
+            self->solid = mp_obj_get_int(destination[1]);
             return true;
         break;
         case MP_QSTR_gravity_scale:
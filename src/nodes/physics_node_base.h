@@ -14,12 +14,14 @@ typedef struct{
 
     mp_obj_t density;                       // How dense the node is
 
-    mp_obj_t friction;
+    // These are read for every body and colliding pair each physics
+    // step, store them natively so the solver never decodes objects
+    float friction;
 
-    mp_obj_t bounciness;                    // Restitution or elasticity
+    float bounciness;                       // Restitution or elasticity
 
-    mp_obj_t dynamic;                       // Flag indicating if node is dynamic and moving around due to physics or static
-    mp_obj_t solid;                         // May want collision callbacks to happen without impeding objects, set to false
+    bool dynamic;                           // Flag indicating if node is dynamic and moving around due to physics or static
+    bool solid;                             // May want collision callbacks to happen without impeding objects, set to false
 
     mp_obj_t gravity_scale;                 // Vector2 allowing scaling affects of gravity. Set to 0,0 for no gravity
 
@@ -1,6 +1,58 @@
 #include "collision_contact_2d.h"
 
 
+// Contacts passed to callbacks live in static memory and get reused
+// every physics step so that steady-state collisions allocate nothing
+static collision_contact_2d_class_obj_t contact_pool[COLLISION_CONTACT_2D_POOL_SIZE];
+static uint16_t contact_pool_index = 0;
+static uint16_t contact_heap_count = 0;
+
+
+void collision_contact_2d_pool_release_nodes(){
+    for(uint16_t i=0; i<contact_pool_index; i++){
+        contact_pool[i].node = mp_const_none;
+    }
+}
+
+
+void collision_contact_2d_pool_reset(){
+    // Also done at the end of every step, but that is skipped
+    // when an `on_collide` callback raises
+    collision_contact_2d_pool_release_nodes();
+
+    contact_pool_index = 0;
+    contact_heap_count = 0;
+}
+
+
+mp_obj_t collision_contact_2d_pool_get(float position_x, float position_y, float normal_x, float normal_y, float penetration, mp_obj_t node){
+    collision_contact_2d_class_obj_t *contact = NULL;
+
+    if(contact_pool_index < COLLISION_CONTACT_2D_POOL_SIZE){
+        contact = &contact_pool[contact_pool_index];
+        contact_pool_index++;
+    }else{
+        contact = m_new_obj(collision_contact_2d_class_obj_t);
+        contact_heap_count++;
+    }
+
+    contact->base.type = &collision_contact_2d_class_type;
+    contact->position_x = position_x;
+    contact->position_y = position_y;
+    contact->normal_x = normal_x;
+    contact->normal_y = normal_y;
+    contact->penetration = penetration;
+    contact->node = node;
+
+    return MP_OBJ_FROM_PTR(contact);
+}
+
+
+uint16_t collision_contact_2d_pool_get_heap_count(){
+    return contact_heap_count;
+}
+
+
 mp_obj_t collision_contact_2d_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args){
     ENGINE_INFO_PRINTF("New CollisionContact2D");
     mp_arg_check_num(n_args, n_kw, 0, 6, false);
@@ -8,28 +60,24 @@ mp_obj_t collision_contact_2d_class_new(const mp_obj_type_t *type, size_t n_args
     collision_contact_2d_class_obj_t *self = m_new_obj(collision_contact_2d_class_obj_t);
     self->base.type = &collision_contact_2d_class_type;
 
-    self->penetration.base.type = &mp_type_float;
-
     if(n_args == 0){
-        self->position = vector2_class_new(&vector2_class_type, 0, 0, NULL);
-        self->normal = vector2_class_new(&vector2_class_type, 0, 0, NULL);
+        self->position_x = 0.0f;
+        self->position_y = 0.0f;
+        self->normal_x = 0.0f;
+        self->normal_y = 0.0f;
+        self->penetration = 0.0f;
+        self->node = mp_const_none;
     }else if(n_args == 6){
-        mp_obj_t parameters[2];
-        parameters[0] = args[0];
-        parameters[1] = args[1];
-        self->position = vector2_class_new(&vector2_class_type, 2, 0, parameters);
-
-        parameters[0] = args[2];
-        parameters[1] = args[3];
-        self->normal = vector2_class_new(&vector2_class_type, 2, 0, parameters);
-        
-        self->penetration.value = mp_obj_get_float(args[4]);
-
+        self->position_x = mp_obj_get_float(args[0]);
+        self->position_y = mp_obj_get_float(args[1]);
+        self->normal_x = mp_obj_get_float(args[2]);
+        self->normal_y = mp_obj_get_float(args[3]);
+        self->penetration = mp_obj_get_float(args[4]);
         self->node = args[5];
     }else{
-        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("CollisionContact2D: Expected 0 or 4 arguments, got something else..."));
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("CollisionContact2D: Expected 0 or 6 arguments, got something else..."));
     }
-    
+
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -37,7 +85,7 @@ mp_obj_t collision_contact_2d_class_new(const mp_obj_type_t *type, size_t n_args
 /* --- doc ---
    NAME: CollisionContact2D
    ID: CollisionContact2D
-   DESC: Object that contains information about a collision
+   DESC: Object that contains information about a collision. Contacts passed to `on_collide` callbacks are reused every physics step and their `node` is set to None once the step is done, keep a copy of any values needed afterwards
    ATTR: [type={ref_link:Vector2}] [name=position]      [value={ref_link:Vector2} TODO: implement filling this out upon collision of polygons, not easy...]
    ATTR: [type={ref_link:Vector2}] [name=normal]        [value={ref_link:Vector2}]
    ATTR: [type=float]              [name=penetration]   [value=any]
@@ -51,13 +99,23 @@ static void collision_contact_2d_class_attr(mp_obj_t self_in, qstr attribute, mp
     if(destination[0] == MP_OBJ_NULL){          // Load
         switch(attribute){
             case MP_QSTR_position:
-                destination[0] = self->position;
+            {
+                mp_obj_t parameters[2];
+                parameters[0] = mp_obj_new_float(self->position_x);
+                parameters[1] = mp_obj_new_float(self->position_y);
+                destination[0] = vector2_class_new(&vector2_class_type, 2, 0, parameters);
+            }
             break;
             case MP_QSTR_normal:
-                destination[0] = self->normal;
+            {
+                mp_obj_t parameters[2];
+                parameters[0] = mp_obj_new_float(self->normal_x);
+                parameters[1] = mp_obj_new_float(self->normal_y);
+                destination[0] = vector2_class_new(&vector2_class_type, 2, 0, parameters);
+            }
             break;
             case MP_QSTR_penetration:
-                destination[0] = mp_obj_new_float(self->penetration.value);
+                destination[0] = mp_obj_new_float(self->penetration);
             break;
             case MP_QSTR_node:
                 destination[0] = self->node;
@@ -68,13 +126,29 @@ static void collision_contact_2d_class_attr(mp_obj_t self_in, qstr attribute, mp
     }else if(destination[1] != MP_OBJ_NULL){    // Store
         switch(attribute){
             case MP_QSTR_position:
-                self->position = destination[1];
+            {
+                if(!mp_obj_is_type(destination[1], &vector2_class_type)){
+                    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("CollisionContact2D: ERROR: Tried to set `position` to something that is not a Vector2"));
+                }
+
+                vector2_class_obj_t *position = destination[1];
+                self->position_x = position->x.value;
+                self->position_y = position->y.value;
+            }
             break;
             case MP_QSTR_normal:
-                self->normal = destination[1];
+            {
+                if(!mp_obj_is_type(destination[1], &vector2_class_type)){
+                    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("CollisionContact2D: ERROR: Tried to set `normal` to something that is not a Vector2"));
+                }
+
+                vector2_class_obj_t *normal = destination[1];
+                self->normal_x = normal->x.value;
+                self->normal_y = normal->y.value;
+            }
             break;
             case MP_QSTR_penetration:
-                self->penetration.value = mp_obj_get_float(destination[1]);
+                self->penetration = mp_obj_get_float(destination[1]);
             break;
             case MP_QSTR_node:
                 self->node = destination[1];
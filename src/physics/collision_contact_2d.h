@@ -6,11 +6,18 @@
 #include "nodes/node_base.h"
 #include "math/vector2.h"
 
+// Number of contacts that can be handed to `on_collide` callbacks
+// each physics step without touching the heap. Contacts past this
+// are allocated like normal objects
+#define COLLISION_CONTACT_2D_POOL_SIZE 64
+
 typedef struct{
     mp_obj_base_t base;
-    vector2_class_obj_t *position;
-    vector2_class_obj_t *normal;
-    mp_obj_float_t penetration;
+    float position_x;               // Stored natively, only boxed into a Vector2 when read from Python
+    float position_y;
+    float normal_x;
+    float normal_y;
+    float penetration;
     mp_obj_t node;                  // The other node
 }collision_contact_2d_class_obj_t;
 
@@ -18,4 +25,18 @@ extern const mp_obj_type_t collision_contact_2d_class_type;
 
 mp_obj_t collision_contact_2d_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
+// Drop the pooled contacts' references to other nodes, call once at the
+// end of each physics step. The pool is not scanned by the garbage collector
+// so a `node` kept past the step could be collected while still referenced
+void collision_contact_2d_pool_release_nodes();
+
+// Recycle all pooled contacts (releasing their nodes), call once at the start of each physics step
+void collision_contact_2d_pool_reset();
+
+// Get a contact from the pool (or the heap if the pool ran out) filled with the passed data
+mp_obj_t collision_contact_2d_pool_get(float position_x, float position_y, float normal_x, float normal_y, float penetration, mp_obj_t node);
+
+// How many contacts had to be allocated on the heap since the last reset
+uint16_t collision_contact_2d_pool_get_heap_count();
+
 #endif  // COLLISION_CONTACT_2D_H
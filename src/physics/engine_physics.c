@@ -5,9 +5,9 @@
 #include "nodes/2D/physics_circle_2d_node.h"
 #include "math/vector2.h"
 #include "math/engine_math.h"
-#include "utility/engine_bit_collection.h"
 #include "collision_contact_2d.h"
 #include "nodes/node_types.h"
+#include "nodes/node_base.h"
 #include "py/obj.h"
 #include "draw/engine_display_draw.h"
 #include "physics/engine_physics_ids.h"
@@ -19,10 +19,26 @@
 
 #include "fault/engine_trace_portable.h"
 
-// Bit array/collection to track nodes that have collided. In the `init` function
-// this is sized so that the output indices from a simple paring function can fit
-// (https://math.stackexchange.com/a/531914)
-engine_bit_collection_t collided_physics_nodes;
+#include <stdlib.h>
+
+// Axis aligned bounding box of a physics node used in the broad-phase.
+// Filled once per physics step, sorted by `min_x`, then swept so that
+// only overlapping pairs reach the narrow-phase (SAT) checks
+typedef struct{
+    engine_node_base_t *node_base;
+    float min_x;
+    float max_x;
+    float min_y;
+    float max_y;
+    uint32_t collision_mask;
+}engine_physics_broadphase_entry_t;
+
+// There can never be more physics nodes than there are IDs to give out
+engine_physics_broadphase_entry_t broadphase_entries[PHYSICS_ID_MAX];
+
+// Number of pairs that made it through the broad-phase to the
+// narrow-phase during the last physics step (exposed for debugging)
+uint32_t engine_physics_pair_test_count = 0;
 
 const float slop = 0.1f;   // usually 0.01 to 0.1
 
@@ -35,7 +51,6 @@ uint32_t frame_start_ms = 0;
 void engine_physics_init(){
     ENGINE_INFO_PRINTF("EnginePhysics: Starting...")
     engine_physics_ids_init();
-    engine_bit_collection_create(&collided_physics_nodes, engine_physics_ids_get_pair_index(PHYSICS_ID_MAX, PHYSICS_ID_MAX));
     frame_start_ms = millis();
 }
 
@@ -50,9 +65,7 @@ TRACE_DECL(void engine_physics_apply_impulses, (float dt, float alpha),
         engine_node_base_t *node_base = physics_link_node->object;
         engine_physics_node_base_t *physics_node_base = node_base->node;
 
-        bool physics_node_dynamic = mp_obj_get_int(physics_node_base->dynamic);
-
-        if(physics_node_dynamic){
+        if(physics_node_base->dynamic){
             vector2_class_obj_t *physics_node_velocity = physics_node_base->velocity;
             vector2_class_obj_t *physics_node_position = physics_node_base->position;
             vector2_class_obj_t *physics_node_gravity_scale = physics_node_base->gravity_scale;
@@ -87,50 +100,18 @@ TRACE_DECL(void engine_physics_apply_impulses, (float dt, float alpha),
 )
 
 
-bool engine_physics_collision_checked_before(engine_physics_node_base_t *physics_node_base_a, engine_physics_node_base_t *physics_node_base_b){
-    // Sort so that id_max*a_id + b_id comes out
-    // the same no matter which node is `a` or `b`
-    // Get the perfect hash code (can be perfect
-    // since the range is limited)
-    uint32_t pair_index = 0;
-
-    if(physics_node_base_a->physics_id > physics_node_base_b->physics_id){
-        pair_index = engine_physics_ids_get_pair_index(physics_node_base_b->physics_id, physics_node_base_a->physics_id);
-    }else{
-        pair_index = engine_physics_ids_get_pair_index(physics_node_base_a->physics_id, physics_node_base_b->physics_id);
-    }
-
-    bool checked_before = engine_bit_collection_get(&collided_physics_nodes, pair_index);   // Get if checked before
-    engine_bit_collection_set(&collided_physics_nodes, pair_index);                         // Set that it has/will be checked no matter what
-    return checked_before;
-}
-
-
 void engine_physics_collide_types(engine_node_base_t *node_base_a, engine_node_base_t *node_base_b){
     engine_physics_node_base_t *physics_node_base_a = node_base_a->node;
     engine_physics_node_base_t *physics_node_base_b = node_base_b->node;
 
-    // Do not try to collide nodes that are not on the same collision 'layer'
-    if((physics_node_base_a->collision_mask & physics_node_base_b->collision_mask) == 0){
-        return;
-    }
-
-    // Before we got here it was confirmed that we're not
-    // checking for collision between the same object, now
-    // confirm these individual objects have not been checked
-    // for collision before
-    if(engine_physics_collision_checked_before(physics_node_base_a, physics_node_base_b)){
-        return;
-    }
-
+    // The broad-phase only passes unique pairs of different nodes
+    // that share a collision layer and have overlapping bounds
     physics_contact_t contact;
     engine_physics_setup_contact(&contact);
 
     bool collided = false;
 
-    // Now that it has been confirmed that the two objects are
-    // not the same object and that they have not been checked
-    // for collision before, check them now but make sure to
+    // Check the nodes for collision but make sure to
     // check the correct pairing (rect vs. rect, rect vs. circle,
     // or circle vs. circle)
     if(node_base_a->type == NODE_TYPE_PHYSICS_RECTANGLE_2D && node_base_b->type == NODE_TYPE_PHYSICS_RECTANGLE_2D){
@@ -177,15 +158,15 @@ void engine_physics_collide_types(engine_node_base_t *node_base_a, engine_node_b
         physics_node_base_a->colliding = true;
         physics_node_base_b->colliding = true;
 
-        bool physics_node_a_dynamic = mp_obj_get_int(physics_node_base_a->dynamic);
-        bool physics_node_b_dynamic = mp_obj_get_int(physics_node_base_b->dynamic);
+        bool physics_node_a_dynamic = physics_node_base_a->dynamic;
+        bool physics_node_b_dynamic = physics_node_base_b->dynamic;
 
-        bool physics_node_a_solid = mp_obj_get_int(physics_node_base_a->solid);
-        bool physics_node_b_solid = mp_obj_get_int(physics_node_base_b->solid);
+        bool physics_node_a_solid = physics_node_base_a->solid;
+        bool physics_node_b_solid = physics_node_base_b->solid;
 
         // Calculate restitution/bounciness
-        float physics_node_a_bounciness = mp_obj_get_float(physics_node_base_a->bounciness);
-        float physics_node_b_bounciness = mp_obj_get_float(physics_node_base_b->bounciness);
+        float physics_node_a_bounciness = physics_node_base_a->bounciness;
+        float physics_node_b_bounciness = physics_node_base_b->bounciness;
         // float bounciness = (physics_node_a_bounciness+physics_node_b_bounciness) * 0.5f; // Restitution: https://github.com/victorfisac/Physac/blob/29d9fc06860b54571a02402fff6fa8572d19bd12/src/physac.h#L1664
         float bounciness = sqrtf(physics_node_a_bounciness*physics_node_b_bounciness);
 
@@ -291,8 +272,8 @@ void engine_physics_collide_types(engine_node_base_t *node_base_a, engine_node_b
 
 
         // Friction: https://code.tutsplus.com/how-to-create-a-custom-2d-physics-engine-friction-scene-and-jump-table--gamedev-7756t#:~:text=in%20our%20collision%20resolver
-        float a_friction = mp_obj_get_float(physics_node_base_a->friction);
-        float b_friction = mp_obj_get_float(physics_node_base_b->friction);
+        float a_friction = physics_node_base_a->friction;
+        float b_friction = physics_node_base_b->friction;
         float mu = sqrtf(a_friction + b_friction);
 
         contact.relative_velocity_x = physics_node_b_velocity->x.value - physics_node_a_velocity->x.value;
@@ -329,66 +310,144 @@ void engine_physics_collide_types(engine_node_base_t *node_base_a, engine_node_b
             }
         }
 
-        mp_obj_t collision_contact_data[6];
-        collision_contact_data[0] = mp_obj_new_float(contact.collision_contact_x);
-        collision_contact_data[1] = mp_obj_new_float(contact.collision_contact_y);
-        collision_contact_data[2] = mp_obj_new_float(contact.collision_normal_x);
-        collision_contact_data[3] = mp_obj_new_float(contact.collision_normal_y);
-        collision_contact_data[4] = mp_obj_new_float(contact.collision_normal_penetration);
-
         mp_obj_t exec[3];
 
-        // Call A callback
+        // Call A callback. Contacts come from a pool that is
+        // recycled every step so that nothing is allocated here
         if(physics_node_base_a->on_collide_cb != mp_const_none){
-            collision_contact_data[5] = node_base_b->attr_accessor;
             exec[0] = physics_node_base_a->on_collide_cb;
             exec[1] = node_base_a->attr_accessor;
-            exec[2] = collision_contact_2d_class_new(&collision_contact_2d_class_type, 6, 0, collision_contact_data);
+            exec[2] = collision_contact_2d_pool_get(contact.collision_contact_x, contact.collision_contact_y, contact.collision_normal_x, contact.collision_normal_y, contact.collision_normal_penetration, node_base_b->attr_accessor);
             mp_call_method_n_kw(1, 0, exec);
+            node_base_invalidate_transforms();
         }
 
         // Call B callback
         if(physics_node_base_b->on_collide_cb != mp_const_none){
-            collision_contact_data[5] = node_base_a->attr_accessor;
             exec[0] = physics_node_base_b->on_collide_cb;
             exec[1] = node_base_b->attr_accessor;
-            exec[2] = collision_contact_2d_class_new(&collision_contact_2d_class_type, 6, 0, collision_contact_data);
+            exec[2] = collision_contact_2d_pool_get(contact.collision_contact_x, contact.collision_contact_y, contact.collision_normal_x, contact.collision_normal_y, contact.collision_normal_penetration, node_base_a->attr_accessor);
             mp_call_method_n_kw(1, 0, exec);
+            node_base_invalidate_transforms();
         }
     }
 }
 
 
+static int engine_physics_broadphase_entry_compare(const void *a, const void *b){
+    float min_x_a = ((const engine_physics_broadphase_entry_t*)a)->min_x;
+    float min_x_b = ((const engine_physics_broadphase_entry_t*)b)->min_x;
+    return (min_x_a > min_x_b) - (min_x_a < min_x_b);
+}
+
+
+// Fill `entry` with the absolute axis aligned bounding box of the physics node
+void engine_physics_setup_broadphase_entry(engine_node_base_t *node_base, engine_physics_broadphase_entry_t *entry){
+    engine_physics_node_base_t *physics_node_base = node_base->node;
+
+    float abs_x = 0.0f;
+    float abs_y = 0.0f;
+    float abs_rotation = 0.0f;
+    bool is_camera_child = false;
+    node_base_get_child_absolute_xy(&abs_x, &abs_y, &abs_rotation, &is_camera_child, node_base);
+
+    float extent_x = 0.0f;
+    float extent_y = 0.0f;
+
+    if(node_base->type == NODE_TYPE_PHYSICS_RECTANGLE_2D){
+        engine_physics_rectangle_2d_node_class_obj_t *physics_rectangle = physics_node_base->unique_data;
+
+        float half_width = physics_rectangle->width * 0.5f;
+        float half_height = physics_rectangle->height * 0.5f;
+
+        // Extents of the rotated rectangle projected onto the x and y axes
+        float abs_cos = fabsf(cosf(abs_rotation));
+        float abs_sin = fabsf(sinf(abs_rotation));
+
+        extent_x = abs_cos*half_width + abs_sin*half_height;
+        extent_y = abs_sin*half_width + abs_cos*half_height;
+    }else{
+        engine_physics_circle_2d_node_class_obj_t *physics_circle = physics_node_base->unique_data;
+
+        extent_x = physics_circle->radius;
+        extent_y = extent_x;
+    }
+
+    entry->node_base = node_base;
+    entry->min_x = abs_x - extent_x;
+    entry->max_x = abs_x + extent_x;
+    entry->min_y = abs_y - extent_y;
+    entry->max_y = abs_y + extent_y;
+    entry->collision_mask = physics_node_base->collision_mask;
+}
+
+
 TRACE_DECL(void engine_physics_update, (float dt),
-    // Loop through all nodes and test for collision against
-    // all other nodes (not optimized checking of if nodes are
-    // even possibly close to each other)
+    // Contacts handed to callbacks last step can be reused now
+    collision_contact_2d_pool_reset();
+
+    // Nodes were moved by the last step and by `physics_tick` callbacks
+    node_base_invalidate_transforms();
+
+    // Broad-phase (sort and sweep): https://leanrada.com/notes/sweep-and-prune/
+    // Build the bounds of every physics node once this step
+    // and sort them along the x-axis
     linked_list *physics_list = engine_collections_get_physics_list();
-    linked_list_node *physics_link_node_a = physics_list->start;
-    while(physics_link_node_a != NULL){
-        // Now check 'a' against all nodes 'b'
-        linked_list_node *physics_link_node_b = physics_list->start;
-
-        while(physics_link_node_b != NULL){
-            // Make sure we are not checking against ourselves
-            if(physics_link_node_a->object != physics_link_node_b->object){
-                engine_physics_collide_types(physics_link_node_a->object, physics_link_node_b->object);
+    linked_list_node *physics_link_node = physics_list->start;
+
+    uint16_t entry_count = 0;
+
+    while(physics_link_node != NULL && entry_count < PHYSICS_ID_MAX){
+        engine_physics_setup_broadphase_entry(physics_link_node->object, &broadphase_entries[entry_count]);
+        entry_count++;
+
+        physics_link_node = physics_link_node->next;
+    }
+
+    qsort(broadphase_entries, entry_count, sizeof(engine_physics_broadphase_entry_t), engine_physics_broadphase_entry_compare);
+
+    engine_physics_pair_test_count = 0;
+
+    // Sweep: each node `a` is only compared against the nodes after it
+    // that start before `a` ends on the x-axis. Every pair is visited
+    // exactly once and never against itself
+    for(uint16_t iax=0; iax<entry_count; iax++){
+        engine_physics_broadphase_entry_t *entry_a = &broadphase_entries[iax];
+
+        for(uint16_t ibx=iax+1; ibx<entry_count; ibx++){
+            engine_physics_broadphase_entry_t *entry_b = &broadphase_entries[ibx];
+
+            // Sorted by `min_x`, nothing after this can overlap `a`
+            if(entry_b->min_x > entry_a->max_x){
+                break;
             }
 
-            physics_link_node_b = physics_link_node_b->next;
-        }
+            // Not overlapping on the y-axis
+            if(entry_b->min_y > entry_a->max_y || entry_b->max_y < entry_a->min_y){
+                continue;
+            }
 
-        // Now that `a` was compared to all `b`,
-        // move onto the next `a` and do it again
-        physics_link_node_a = physics_link_node_a->next;
+            // Do not try to collide nodes that are not on the same collision 'layer'
+            if((entry_a->collision_mask & entry_b->collision_mask) == 0){
+                continue;
+            }
+
+            engine_physics_pair_test_count++;
+            engine_physics_collide_types(entry_a->node_base, entry_b->node_base);
+        }
     }
 
-    // After everything physics related is done, reset the bit array
-    // used for tracking which pairs of nodes had already collided
-    engine_bit_collection_erase(&collided_physics_nodes);
+    // Callbacks are done with the contacts. The pool isn't scanned by the garbage
+    // collector, so clear their nodes before those can be freed and left dangling
+    collision_contact_2d_pool_release_nodes();
 )
 
 
+uint32_t engine_physics_get_pair_test_count(){
+    return engine_physics_pair_test_count;
+}
+
+
 TRACE_DECL(void engine_physics_physics_tick, (float dt_s),
     mp_obj_t exec[3];
 
@@ -443,7 +502,10 @@ void engine_physics_tick(){
         // Call the physics_tick callbacks on all physics nodes first
         engine_physics_physics_tick(engine_fps_limit_period_ms);
 
+        // Prints the cycles each step took when performance printing is enabled
+        ENGINE_PERFORMANCE_CYCLES_START();
         engine_physics_update(engine_fps_limit_period_ms);
+        ENGINE_PERFORMANCE_CYCLES_STOP();
         time_accumulator -= engine_fps_limit_period_ms;
 
         // Apply impulses/move objects due to physics before
@@ -19,6 +19,11 @@ void engine_physics_give_back_id(uint8_t id);
 void engine_physics_init();
 
 void engine_physics_physics_tick(float dt_s);
+
+// Number of node pairs that passed the broad-phase and were
+// checked for collision during the last physics step
+uint32_t engine_physics_get_pair_test_count();
+
 void engine_physics_tick();
 
 #endif  // ENGINE_PHYSICS_H
@@ -40,7 +40,7 @@ void engine_physics_setup_abs_rectangle(engine_node_base_t *node_base, physics_a
     bool is_camera_child = false;
     node_base_get_child_absolute_xy(&abs_rect->abs_x, &abs_rect->abs_y, &abs_rect->rotation, &is_camera_child, node_base);
     engine_physics_rectangle_2d_node_calculate(physics_rect, abs_rect->vertices_x, abs_rect->vertices_y, abs_rect->normals_x, abs_rect->normals_y, abs_rect->rotation);
-    abs_rect->dynamic = mp_obj_get_int(physics_rect->dynamic);
+    abs_rect->dynamic = physics_rect->dynamic;
 }
 
 
@@ -71,8 +71,8 @@ void engine_physics_setup_abs_circle(engine_node_base_t *node_base, physics_abs_
 
     bool is_camera_child = false;
     node_base_get_child_absolute_xy(&abs_circle->abs_x, &abs_circle->abs_y, &abs_circle->rotation, &is_camera_child, node_base);
-    abs_circle->radius = mp_obj_get_float(circle->radius);
-    abs_circle->dynamic = mp_obj_get_int(physics_circle->dynamic);
+    abs_circle->radius = circle->radius;
+    abs_circle->dynamic = physics_circle->dynamic;
 }
 
 
@@ -95,8 +95,8 @@ void engine_physics_cancel_dynamics(engine_physics_node_base_t *physics_node_bas
     vector2_class_obj_t *physics_node_a_velocity = physics_node_base_a->velocity;
     vector2_class_obj_t *physics_node_b_velocity = physics_node_base_b->velocity;
 
-    bool physics_node_a_dynamic = mp_obj_get_int(physics_node_base_a->dynamic);
-    bool physics_node_b_dynamic = mp_obj_get_int(physics_node_base_b->dynamic);
+    bool physics_node_a_dynamic = physics_node_base_a->dynamic;
+    bool physics_node_b_dynamic = physics_node_base_b->dynamic;
 
     // If either node is not dynamic, set any velocities to zero no matter what set to
     if(!physics_node_a_dynamic){
@@ -323,7 +323,7 @@ void engine_physics_rect_circle_get_contact(physics_contact_t *contact, float ci
 
     engine_physics_rect_rect_get_contacting(abs_rect->abs_x, abs_rect->abs_y, -contact->collision_normal_x, -contact->collision_normal_y, &a_max_proj_vertex_x, &a_max_proj_vertex_y, &a_edge_v0_x, &a_edge_v0_y, &a_edge_v1_x, &a_edge_v1_y, abs_rect->vertices_x, abs_rect->vertices_y);
     
-    float circle_radius = mp_obj_get_float(physics_circle->radius);
+    float circle_radius = physics_circle->radius;
 
     float circle_pos_proj = engine_math_dot_product(abs_circle->abs_x, abs_circle->abs_y, contact->collision_normal_y, -contact->collision_normal_x);
     float rect_extend_proj_0 = engine_math_dot_product(a_edge_v0_x, a_edge_v0_y, contact->collision_normal_y, -contact->collision_normal_x);
@@ -72,6 +72,108 @@ void load_obj_file(mesh_resource_class_obj_t *self, mp_obj_str_t *obj_path_mp, i
 }
 
 
+// Copies a packed .tmsh file as-is into resource space (flash
+// or ram) and points the mesh at it, nothing is converted so
+// drawing reads the vertex data in place
+void load_packed_file(mesh_resource_class_obj_t *self, mp_obj_str_t *path_mp, bool in_ram){
+    engine_file_open_read(0, path_mp);
+
+    uint8_t header[MESH_PACKED_HEADER_SIZE];
+    if(engine_file_read(0, header, MESH_PACKED_HEADER_SIZE) != MESH_PACKED_HEADER_SIZE || memcmp(header, "TMSH", 4) != 0){
+        engine_file_close(0);
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: File is not a packed mesh, missing 'TMSH' header"));
+    }
+
+    if(header[4] != MESH_PACKED_VERSION){
+        engine_file_close(0);
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: Packed mesh version `%d` is not supported, expected `%d`"), header[4], MESH_PACKED_VERSION);
+    }
+
+    uint8_t flags = header[5];
+    uint32_t vertex_count = 0;
+    uint32_t index_count = 0;
+    memcpy(&vertex_count, header+8, sizeof(uint32_t));
+    memcpy(&index_count, header+12, sizeof(uint32_t));
+
+    if(!(flags & MESH_PACKED_FLAG_INDICES)){
+        index_count = 0;
+    }
+
+    // The mesh node walks the vertices/indices with 16-bit indices. This
+    // also keeps the sizes below from overflowing for any header values
+    if(vertex_count > MESH_PACKED_MAX_COUNT || index_count > MESH_PACKED_MAX_COUNT){
+        engine_file_close(0);
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: Packed mesh has %lu vertices and %lu indices, at most %d of each are supported"), (unsigned long)vertex_count, (unsigned long)index_count, MESH_PACKED_MAX_COUNT);
+    }
+
+    uint8_t stride = (flags & MESH_PACKED_FLAG_FIXED_POSITIONS) ? 6 : 12;
+    if(flags & MESH_PACKED_FLAG_UVS){
+        stride += 4;
+    }
+
+    uint32_t triangle_count = ((flags & MESH_PACKED_FLAG_INDICES) ? index_count : vertex_count) / 3;
+    uint32_t vertices_size = vertex_count * stride;
+    uint32_t indices_size = index_count * sizeof(uint16_t);
+    uint32_t colors_size = (flags & MESH_PACKED_FLAG_COLORS) ? triangle_count * sizeof(uint16_t) : 0;
+    uint32_t total_size = MESH_PACKED_HEADER_SIZE + vertices_size + indices_size + colors_size;
+
+    if(engine_file_size(0) < total_size){
+        engine_file_close(0);
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: Packed mesh is truncated, expected %d bytes but file is %d bytes"), (int)total_size, (int)engine_file_size(0));
+    }
+
+    // Store the header too so that everything after it keeps the
+    // same alignment it had in the file (resource space is page aligned)
+    self->packed_data = engine_resource_get_space_bytearray(total_size, in_ram);
+    engine_resource_start_storing(self->packed_data, in_ram);
+
+    for(uint8_t i=0; i<MESH_PACKED_HEADER_SIZE; i++){
+        engine_resource_store_u8(header[i]);
+    }
+
+    uint8_t temp_buffer[512];
+    uint32_t remaining_amount_to_read = total_size - MESH_PACKED_HEADER_SIZE;
+
+    while(remaining_amount_to_read != 0){
+        uint16_t amount_to_read = MIN(512, remaining_amount_to_read);
+        uint16_t read_amount = engine_file_read(0, temp_buffer, amount_to_read);
+        remaining_amount_to_read -= read_amount;
+
+        for(uint16_t i=0; i<read_amount; i++){
+            engine_resource_store_u8(temp_buffer[i]);
+        }
+    }
+
+    engine_resource_stop_storing();
+    engine_file_close(0);
+
+    uint8_t *data = ENGINE_BYTEARRAY_OBJ_TO_DATA(self->packed_data);
+
+    self->packed_flags = flags;
+    self->packed_stride = stride;
+    self->packed_vertex_count = vertex_count;
+    self->packed_index_count = index_count;
+    self->packed_vertices = data + MESH_PACKED_HEADER_SIZE;
+    self->packed_indices = (uint16_t*)(data + MESH_PACKED_HEADER_SIZE + vertices_size);
+    self->packed_colors = (flags & MESH_PACKED_FLAG_COLORS) ? (uint16_t*)(data + MESH_PACKED_HEADER_SIZE + vertices_size + indices_size) : NULL;
+
+    // Drawing indexes the vertices without checking, make sure
+    // a bad file can't make it read outside of them
+    for(uint32_t i=0; i<index_count; i++){
+        if(self->packed_indices[i] >= vertex_count){
+            mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: Packed mesh index %d is %d but there are only %d vertices"), (int)i, (int)self->packed_indices[i], (int)vertex_count);
+        }
+    }
+}
+
+
+bool mesh_resource_path_is_packed(mp_obj_t path){
+    size_t path_len = 0;
+    const char *path_str = mp_obj_str_get_data(path, &path_len);
+    return path_len >= 5 && memcmp(path_str + path_len - 5, ".tmsh", 5) == 0;
+}
+
+
 mp_obj_t mesh_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args){
     ENGINE_INFO_PRINTF("New MeshResource");
 
@@ -89,8 +191,10 @@ mp_obj_t mesh_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_
     //  2. path, in_ram: .vertices, .indices, and .uvs are set to `bytearray`s depending on the data in the .obj file otherwise set to empty `list`
     //  3. vertices, indices, and uvs: .vertices, .indices, and .uvs are set to passed `lists` or `bytearrays`, otherwise, set to empty `list`
     //  4. vertices, indices, uvs and colors: .vertices, .indices, .uvs, and .triangle_colors, are set to passed `lists` or `bytearrays`, otherwise, set to empty `list`
+    //  5. path to packed .tmsh, (optional) in_ram: file copied to flash or ram and drawn from directly, other attributes set to empty `list`
 
     self->vertex_count = mp_const_none;
+    self->packed_data = mp_const_none;
 
     if(n_args == 0){
         self->vertices = mp_obj_new_list(0, NULL);
@@ -99,7 +203,9 @@ mp_obj_t mesh_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_
         self->triangle_colors = mp_obj_new_list(0, NULL);
     }else{
         if(n_args == 1){
-            if(mp_obj_is_str(args[0])){                                                                            // path
+            if(mp_obj_is_str(args[0]) && mesh_resource_path_is_packed(args[0])){                                  // path (packed)
+                load_packed_file(self, args[0], false);
+            }else if(mp_obj_is_str(args[0])){                                                                      // path
                 // Open .obj mesh in FLASH
                 load_obj_file(self, args[0], NOPACK);
                 // mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: using .obj files is not implemented yet!"));
@@ -112,7 +218,9 @@ mp_obj_t mesh_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_
                 mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: Expected first argument to be a `str` or `list/bytearray`, got `%s`"), mp_obj_get_type_str(args[0]));
             }
         }else if(n_args == 2){
-            if(mp_obj_is_str(args[0]) && mp_obj_is_bool(args[1])){                                                  // path, in_ram
+            if(mp_obj_is_str(args[0]) && mp_obj_is_bool(args[1]) && mesh_resource_path_is_packed(args[0])){        // path, in_ram (packed)
+                load_packed_file(self, args[0], mp_obj_is_true(args[1]));
+            }else if(mp_obj_is_str(args[0]) && mp_obj_is_bool(args[1])){                                            // path, in_ram
                 // Open .obj mesh in FLASH or RAM
                 mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("MeshResource: ERROR: using .obj files is not implemented yet!"));
             }else if((mp_obj_is_type(args[0], &mp_type_list) || mp_obj_is_type(args[0], &mp_type_bytearray)) &&
@@ -152,6 +260,15 @@ mp_obj_t mesh_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_
         }
     }
 
+    // Packed meshes keep their data in `packed_data`, keep
+    // the Python facing attributes valid (but empty)
+    if(self->packed_data != mp_const_none){
+        self->vertices = mp_obj_new_list(0, NULL);
+        self->indices = mp_obj_new_list(0, NULL);
+        self->uvs = mp_obj_new_list(0, NULL);
+        self->triangle_colors = mp_obj_new_list(0, NULL);
+    }
+
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -168,7 +285,10 @@ MP_DEFINE_CONST_FUN_OBJ_1(mesh_resource_class_del_obj, mesh_resource_class_del);
 /*  --- doc ---
     NAME: MeshResource
     ID: MeshResource
-    DESC: Holds vertex and UV information.
+    DESC: Holds vertex and UV information. Can be loaded from a packed binary `.tmsh` file (see engine_mesh_resource.h for the layout) that is stored in flash (or ram if `in_ram` is True) and drawn from without creating any Python objects per vertex
+    PARAM:  [type=str]  [name=file_path]  [value=path to .obj or .tmsh file]
+    PARAM:  [type=bool] [name=in_ram]     [value=True or False (default: False), only .tmsh]
+    ATTR:   [type=bytearray] [name=packed_data] [value=bytearray of the packed file or None if not loaded from a .tmsh file (read-only)]
 */ 
 static void mesh_resource_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t *destination){
     ENGINE_INFO_PRINTF("Accessing MeshResource attr");
@@ -196,6 +316,9 @@ static void mesh_resource_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t
             case MP_QSTR_vertex_count:
                 destination[0] = self->vertex_count;
             break;
+            case MP_QSTR_packed_data:
+                destination[0] = self->packed_data;
+            break;
             default:
                 return; // Fail
         }
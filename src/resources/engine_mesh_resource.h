@@ -4,6 +4,19 @@
 #include "py/obj.h"
 #include "utility/engine_file.h"
 
+// Packed binary mesh files (.tmsh). Layout, all little-endian:
+//  | 'TMSH' | u8 version | u8 flags | u16 reserved | u32 vertex count | u32 index count |
+//  | vertices: position (3x float32 or 3x int16 8.8 fixed-point), uv (2x uint16 0 ~ 65535 = 0.0 ~ 1.0) if flagged |
+//  | indices: index count x uint16 if flagged |
+//  | triangle colors: one RGB565 uint16 per triangle if flagged |
+#define MESH_PACKED_VERSION                 1
+#define MESH_PACKED_HEADER_SIZE             16
+#define MESH_PACKED_FLAG_FIXED_POSITIONS    0b00000001  // Positions are int16 8.8 fixed-point instead of float32
+#define MESH_PACKED_FLAG_UVS                0b00000010
+#define MESH_PACKED_FLAG_COLORS             0b00000100
+#define MESH_PACKED_FLAG_INDICES            0b00001000
+#define MESH_PACKED_MAX_COUNT               65535       // Mesh node draws with 16-bit vertex indices
+
 typedef struct mesh_resource_class_obj_t{
     mp_obj_base_t base;
     mp_obj_t vertices;           // list of Vector3s or bytearry of bytes that can be interpreted as int8, uint8, int16, uint16, or float
@@ -12,8 +25,55 @@ typedef struct mesh_resource_class_obj_t{
     mp_obj_t triangle_colors;    // List of Colors
 
     mp_obj_t vertex_count;
+
+    // When loaded from a packed file, the whole file lives in this bytearray
+    // (flash or ram) and is read in place while drawing, `mp_const_none` otherwise
+    mp_obj_t packed_data;
+    uint8_t packed_flags;
+    uint8_t packed_stride;          // Bytes per interleaved vertex
+    uint32_t packed_vertex_count;
+    uint32_t packed_index_count;
+    uint8_t *packed_vertices;       // Point into `packed_data`
+    uint16_t *packed_indices;
+    uint16_t *packed_colors;
 }mesh_resource_class_obj_t;
 
+
+// Number of vertices that triangles are made from (indices if there are any)
+static inline uint32_t mesh_resource_packed_get_draw_count(mesh_resource_class_obj_t *mesh){
+    return (mesh->packed_flags & MESH_PACKED_FLAG_INDICES) ? mesh->packed_index_count : mesh->packed_vertex_count;
+}
+
+
+// Get position `out` and normalized uv of the vertex that is used as `draw_index`th triangle corner
+static inline void mesh_resource_packed_get_vertex(mesh_resource_class_obj_t *mesh, uint32_t draw_index, float *out_position, float *out_u, float *out_v){
+    uint32_t vertex_index = (mesh->packed_flags & MESH_PACKED_FLAG_INDICES) ? mesh->packed_indices[draw_index] : draw_index;
+    uint8_t *vertex = mesh->packed_vertices + vertex_index * mesh->packed_stride;
+
+    if(mesh->packed_flags & MESH_PACKED_FLAG_FIXED_POSITIONS){
+        int16_t *position = (int16_t*)vertex;
+        out_position[0] = position[0] * (1.0f / 256.0f);
+        out_position[1] = position[1] * (1.0f / 256.0f);
+        out_position[2] = position[2] * (1.0f / 256.0f);
+        vertex += 6;
+    }else{
+        float *position = (float*)vertex;
+        out_position[0] = position[0];
+        out_position[1] = position[1];
+        out_position[2] = position[2];
+        vertex += 12;
+    }
+
+    if(mesh->packed_flags & MESH_PACKED_FLAG_UVS){
+        uint16_t *uv = (uint16_t*)vertex;
+        *out_u = uv[0] * (1.0f / (float)UINT16_MAX);
+        *out_v = uv[1] * (1.0f / (float)UINT16_MAX);
+    }else{
+        *out_u = 0.0f;
+        *out_v = 0.0f;
+    }
+}
+
 extern const mp_obj_type_t mesh_resource_class_type;
 mp_obj_t mesh_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
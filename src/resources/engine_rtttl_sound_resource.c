@@ -73,7 +73,7 @@ const uint8_t octave_base = 4;
 //  ->  note duration = 1 -> interrupt_samples_this_note = 4[b] * 52920[samples/b] = 211680[samples]
 
 
-float ENGINE_FAST_FUNCTION(rtttl_sound_resource_get_sample)(rtttl_sound_resource_class_obj_t *self, bool *complete){
+int16_t ENGINE_FAST_FUNCTION(rtttl_sound_resource_get_sample)(rtttl_sound_resource_class_obj_t *self, bool *complete){
     if(self->interrupt_samples_counting >= self->interrupt_samples_until_next){
         // Reset counter and cast data to something more accessible
         self->interrupt_samples_counting = 0;
@@ -82,16 +82,18 @@ float ENGINE_FAST_FUNCTION(rtttl_sound_resource_get_sample)(rtttl_sound_resource
         // Copy data into types from track
         uint32_t index = self->note_cursor * 8;
         uint32_t duration = 0;
-        float frequency = 0.0f;
+        uint32_t phase_step = 0;
 
         memcpy(&duration, data+index, 4);
-        memcpy(&frequency, data+index+4, 4);
+        memcpy(&phase_step, data+index+4, 4);
 
         // Use the data to set the duration this
         // note will return samples for and
-        // then set the frequency
+        // then set the frequency and start
+        // the tone's envelope over
         self->interrupt_samples_until_next = duration;
-        tone_sound_resource_set_frequency(self->tone, frequency);
+        tone_sound_resource_set_phase_step(self->tone, phase_step);
+        tone_sound_resource_note_on(self->tone);
 
         // Reset if reach end of track
         self->note_cursor++;
@@ -326,7 +328,9 @@ void rtttl_sound_resource_store_note(uint32_t note_interrupt_samples, float note
     engine_resource_store_u8(data[2]);
     engine_resource_store_u8(data[3]);
 
-    memcpy(data, &note_frequency, 4);
+    // Stored as the tone's phase step so the interrupt doesn't need floats
+    uint32_t note_phase_step = tone_sound_resource_frequency_to_phase_step(note_frequency);
+    memcpy(data, &note_phase_step, 4);
     engine_resource_store_u8(data[0]);
     engine_resource_store_u8(data[1]);
     engine_resource_store_u8(data[2]);
@@ -364,7 +368,7 @@ mp_obj_t rtttl_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args
 
     // To reduce interrupt complexity, for each note cache
     //  * Times get_sample needs to be called before moving to next sample (32-bits/4 bytes)
-    //  * Complete frequency (32-bits/4 bytes)
+    //  * Complete frequency as a tone phase step (32-bits/4 bytes)
     self->data = engine_resource_get_space_bytearray(self->note_count * (4+4), true);
     engine_resource_start_storing(self->data, true);
 
@@ -417,7 +421,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(rtttl_sound_resource_class_del_obj, rtttl_sound_resour
     DESC: Can be used to play a music in ringtone format (TODO: better docs): https://en.wikipedia.org/wiki/Ring_Tone_Text_Transfer_Language
     PARAM:  [type=string]         [name=filepath] [value=any]
     ATTR:   [type=int]            [name=tempo]    [value=any positive value]
-    ATTR:   [type=bytearray]      [name=data]     [value=bytearray consisting 32-bit duration/frequency integer pairs]                                                                                                                                                               
+    ATTR:   [type=bytearray]      [name=data]     [value=bytearray consisting 32-bit duration/phase step (frequency / 22050 * 2^32) integer pairs]                                                                                                                                                               
 */ 
 static void rtttl_sound_resource_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t *destination){
     ENGINE_INFO_PRINTF("Accessing RTTTLSoundResource attr");
@@ -20,7 +20,7 @@ typedef struct{
 
 extern const mp_obj_type_t rtttl_sound_resource_class_type;
 
-float ENGINE_FAST_FUNCTION(rtttl_sound_resource_get_sample)(rtttl_sound_resource_class_obj_t *self, bool *complete);
+int16_t ENGINE_FAST_FUNCTION(rtttl_sound_resource_get_sample)(rtttl_sound_resource_class_obj_t *self, bool *complete);
 mp_obj_t rtttl_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
 #endif  // ENGINE_RTTTL_SOUND_RESOURCE_H
\ No newline at end of file
@@ -17,11 +17,11 @@ typedef struct sound_resource_base_class_obj_t{
     bool in_ram;
     uint32_t total_sample_count;                                    // Value used by playback engine to know if it reached the end of the sound       
     uint32_t total_data_size;
-    uint32_t sample_rate;                                           // Value used by playback engine to know how often to fetch new samples
-    uint8_t play_counter_max;                                       // How many times the 22050Hz interrupt needs to be called before getting the next sample
-    uint8_t play_counter;                                           // Based on the playback sample rate of the engine and the source, this tracks when the next sample from the source should be played
-    float last_sample;                                              // Keep the last sample to return it for times when it is not time to return a new sample
-    uint16_t bytes_per_sample;                                      // Value used by playback engine to know how many bytes are in a sample
+    uint32_t sample_rate;                                           // Value used by playback engine to know how often to fetch new samples (the channel steps through samples at this rate relative to the engine's rate)
+    uint16_t bytes_per_sample;                                      // Value used by playback engine to know how many bytes are in a sample (0 for compressed formats)
+    uint16_t format_type;                                           // Wave format tag of the data: `WAVE_FORMAT_PCM` or `WAVE_FORMAT_IMA_ADPCM`
+    uint16_t block_align;                                           // IMA-ADPCM: bytes in each block of data (4 byte header followed by 4-bit samples)
+    uint16_t samples_per_block;                                     // IMA-ADPCM: samples decoded out of each full block
     struct audio_channel_class_obj_t *channel;                      // If being played by a channel, then this is the channel that is playing it (IMPORTANT: need this link so that when this source is deleted it can remove itself from the channel as a source by setting itself NULL)
     uint8_t *(*get_data)(void*, uint32_t, uint16_t*);               // Function used by playback engine to fill audio buffer
     void *extra_data;                                               // Each individual sound resource can attach extra data for its own use (not by the playback engine directly)
@@ -232,12 +232,66 @@ uint16_t texture_resource_get_indexed_pixel(texture_resource_class_obj_t *textur
 }
 
 
+// Specialized versions of `texture_resource_get_indexed_pixel` where the
+// bit-depth is known so the byte index and shift are just shifts and masks
+uint16_t texture_resource_get_indexed_1bit_pixel(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha){
+    uint8_t *data = ((mp_obj_array_t*)texture->data)->items;
+    uint16_t *colors = ((mp_obj_array_t*)texture->colors)->items;
+
+    // Left-most bit is the left-most pixel
+    return colors[(data[pixel_offset >> 3] >> (7 - (pixel_offset & 0b111))) & 0b1];
+}
+
+
+uint16_t texture_resource_get_indexed_4bit_pixel(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha){
+    uint8_t *data = ((mp_obj_array_t*)texture->data)->items;
+    uint16_t *colors = ((mp_obj_array_t*)texture->colors)->items;
+
+    // High nibble is the left pixel
+    return colors[(data[pixel_offset >> 1] >> ((~pixel_offset & 0b1) << 2)) & 0b1111];
+}
+
+
+uint16_t texture_resource_get_indexed_8bit_pixel(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha){
+    uint8_t *data = ((mp_obj_array_t*)texture->data)->items;
+    uint16_t *colors = ((mp_obj_array_t*)texture->colors)->items;
+
+    return colors[data[pixel_offset]];
+}
+
+
 uint16_t texture_resource_get_16bit_rgb565(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha){
     mp_obj_array_t *data = texture->data;
     return ((uint16_t*)data->items)[pixel_offset];
 }
 
 
+// Decode ARGB1555/4444 with the same channel placement that the mask shifts
+// calculated in `create_from_file` produce for these masks
+static inline uint16_t texture_resource_decode_argb1555(uint16_t pixel){
+    return ((pixel & 0b0111110000000000) << 1) | ((pixel & 0b0000001111100000) << 1) | (pixel & 0b0000000000011111);
+}
+
+
+static inline uint16_t texture_resource_decode_argb4444(uint16_t pixel){
+    return ((pixel & 0b0000111100000000) << 4) | ((pixel & 0b0000000011110000) << 3) | ((pixel & 0b0000000000001111) << 1);
+}
+
+
+uint16_t texture_resource_get_16bit_argb1555(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha){
+    uint16_t pixel = ((uint16_t*)((mp_obj_array_t*)texture->data)->items)[pixel_offset];
+    if(out_alpha != NULL) *out_alpha = (pixel >> 15) ? 1.0f : 0.0f;
+    return texture_resource_decode_argb1555(pixel);
+}
+
+
+uint16_t texture_resource_get_16bit_argb4444(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha){
+    uint16_t pixel = ((uint16_t*)((mp_obj_array_t*)texture->data)->items)[pixel_offset];
+    if(out_alpha != NULL) *out_alpha = (pixel >> 12) * (1.0f / 15.0f);
+    return texture_resource_decode_argb4444(pixel);
+}
+
+
 uint16_t texture_resource_get_16bit_axrgb(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha){
     mp_obj_array_t *data = texture->data;
 
@@ -251,20 +305,22 @@ uint16_t texture_resource_get_16bit_axrgb(texture_resource_class_obj_t *texture,
     //            r_mask     = 0b0_11111_00000_00000 -> r = pixel_1555 & r_mask = 0b1_11011_00100_10101 & 0b0_11111_00000_00000 = 0b0_11011_00000_00000
     //            g_mask     = 0b0_00000_11111_00000 -> g = pixel_1555 & g_mask = 0b1_11011_00100_10101 & 0b0_00000_11111_00000 = 0b0_00000_00100_00000
     //            b_mask     = 0b0_00000_00000_11111 -> b = pixel_1555 & g_mask = 0b1_11011_00100_10101 & 0b0_00000_00000_11111 = 0b0_00000_00000_10101
-    uint16_t a = pixel & texture->alpha_mask;
     uint16_t r = pixel & texture->red_mask;
     uint16_t g = pixel & texture->green_mask;
     uint16_t b = pixel & texture->blue_mask;
 
     // The shift amounts are calculated once at the end of
     // creating the texture resource
-    a = a >> texture->a_mask_right_shift_amount;
     r = r >> texture->r_mask_right_shift_amount;
     g = g >> texture->g_mask_right_shift_amount;
     b = b << texture->b_mask_left_shift_amount;
 
-    // Alpha is special and is output as 0.0 ~ 1.0
-    if(out_alpha != NULL) *out_alpha = engine_math_map((float)a, 0.0f, (float)(texture->alpha_mask >> texture->a_mask_right_shift_amount), 0.0f, 1.0f);
+    // Alpha is special and is output as 0.0 ~ 1.0 (xrgb
+    // formats without an alpha mask are always opaque)
+    if(out_alpha != NULL && texture->alpha_mask != 0){
+        uint16_t a = (pixel & texture->alpha_mask) >> texture->a_mask_right_shift_amount;
+        *out_alpha = ((a * texture->alpha_to_u8) >> 16) * (1.0f / 255.0f);
+    }
 
     pixel = 0;
     pixel |= (r << 11);
@@ -275,6 +331,154 @@ uint16_t texture_resource_get_16bit_axrgb(texture_resource_class_obj_t *texture,
 }
 
 
+// Row versions of the above: decode `count` consecutive pixels at once
+static inline void texture_resource_fill_opaque(uint8_t *out_alphas, uint16_t count){
+    if(out_alphas != NULL) memset(out_alphas, 255, count);
+}
+
+
+// Fallback for bit-depths without a specialized kernel (2-bit)
+void texture_resource_get_indexed_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    for(uint16_t i=0; i<count; i++){
+        out_colors[i] = texture_resource_get_indexed_pixel(texture, pixel_offset+i, NULL);
+    }
+
+    texture_resource_fill_opaque(out_alphas, count);
+}
+
+
+void texture_resource_get_indexed_1bit_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    uint8_t *data = ((mp_obj_array_t*)texture->data)->items;
+    uint16_t *colors = ((mp_obj_array_t*)texture->colors)->items;
+
+    for(uint16_t i=0; i<count; i++){
+        out_colors[i] = colors[(data[pixel_offset >> 3] >> (7 - (pixel_offset & 0b111))) & 0b1];
+        pixel_offset++;
+    }
+
+    texture_resource_fill_opaque(out_alphas, count);
+}
+
+
+void texture_resource_get_indexed_4bit_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    uint8_t *data = ((mp_obj_array_t*)texture->data)->items;
+    uint16_t *colors = ((mp_obj_array_t*)texture->colors)->items;
+
+    for(uint16_t i=0; i<count; i++){
+        out_colors[i] = colors[(data[pixel_offset >> 1] >> ((~pixel_offset & 0b1) << 2)) & 0b1111];
+        pixel_offset++;
+    }
+
+    texture_resource_fill_opaque(out_alphas, count);
+}
+
+
+void texture_resource_get_indexed_8bit_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    uint8_t *data = ((uint8_t*)((mp_obj_array_t*)texture->data)->items) + pixel_offset;
+    uint16_t *colors = ((mp_obj_array_t*)texture->colors)->items;
+
+    for(uint16_t i=0; i<count; i++){
+        out_colors[i] = colors[data[i]];
+    }
+
+    texture_resource_fill_opaque(out_alphas, count);
+}
+
+
+void texture_resource_get_16bit_rgb565_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    uint16_t *data = ((uint16_t*)((mp_obj_array_t*)texture->data)->items) + pixel_offset;
+
+    memcpy(out_colors, data, count * sizeof(uint16_t));
+    texture_resource_fill_opaque(out_alphas, count);
+}
+
+
+void texture_resource_get_16bit_argb1555_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    uint16_t *data = ((uint16_t*)((mp_obj_array_t*)texture->data)->items) + pixel_offset;
+
+    for(uint16_t i=0; i<count; i++){
+        uint16_t pixel = data[i];
+        out_colors[i] = texture_resource_decode_argb1555(pixel);
+        if(out_alphas != NULL) out_alphas[i] = (pixel >> 15) ? 255 : 0;
+    }
+}
+
+
+void texture_resource_get_16bit_argb4444_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    uint16_t *data = ((uint16_t*)((mp_obj_array_t*)texture->data)->items) + pixel_offset;
+
+    for(uint16_t i=0; i<count; i++){
+        uint16_t pixel = data[i];
+        out_colors[i] = texture_resource_decode_argb4444(pixel);
+        if(out_alphas != NULL) out_alphas[i] = (pixel >> 12) * 17;     // 0 ~ 15 -> 0 ~ 255
+    }
+}
+
+
+// Any other masks, same decoding as `texture_resource_get_16bit_axrgb`
+void texture_resource_get_16bit_axrgb_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas){
+    uint16_t *data = ((uint16_t*)((mp_obj_array_t*)texture->data)->items) + pixel_offset;
+
+    for(uint16_t i=0; i<count; i++){
+        uint16_t pixel = data[i];
+        uint16_t r = (pixel & texture->red_mask) >> texture->r_mask_right_shift_amount;
+        uint16_t g = (pixel & texture->green_mask) >> texture->g_mask_right_shift_amount;
+        uint16_t b = (pixel & texture->blue_mask) << texture->b_mask_left_shift_amount;
+        out_colors[i] = (r << 11) | (g << 5) | b;
+    }
+
+    if(out_alphas == NULL){
+        return;
+    }
+
+    if(texture->alpha_mask == 0){
+        texture_resource_fill_opaque(out_alphas, count);
+    }else{
+        for(uint16_t i=0; i<count; i++){
+            uint16_t a = (data[i] & texture->alpha_mask) >> texture->a_mask_right_shift_amount;
+            out_alphas[i] = (a * texture->alpha_to_u8) >> 16;
+        }
+    }
+}
+
+
+// Pick the pixel and row decoding functions for the format of the
+// texture once instead of figuring out the format for every pixel
+void texture_resource_select_samplers(texture_resource_class_obj_t *self){
+    self->has_alpha = (self->bit_depth == 16 && self->alpha_mask != 0);
+
+    if(self->bit_depth == 1){
+        self->get_pixel = texture_resource_get_indexed_1bit_pixel;
+        self->get_row = texture_resource_get_indexed_1bit_row;
+    }else if(self->bit_depth == 4){
+        self->get_pixel = texture_resource_get_indexed_4bit_pixel;
+        self->get_row = texture_resource_get_indexed_4bit_row;
+    }else if(self->bit_depth == 8){
+        self->get_pixel = texture_resource_get_indexed_8bit_pixel;
+        self->get_row = texture_resource_get_indexed_8bit_row;
+    }else if(self->bit_depth < 16){
+        self->get_pixel = texture_resource_get_indexed_pixel;
+        self->get_row = texture_resource_get_indexed_row;
+    }else if((self->combined_masks == 65535 && self->alpha_mask == 0) || self->combined_masks == 0){   // RGB565
+        self->get_pixel = texture_resource_get_16bit_rgb565;
+        self->get_row = texture_resource_get_16bit_rgb565_row;
+    }else if(self->alpha_mask == 0b1000000000000000 && self->red_mask == 0b0111110000000000 && self->green_mask == 0b0000001111100000 && self->blue_mask == 0b0000000000011111){
+        self->get_pixel = texture_resource_get_16bit_argb1555;
+        self->get_row = texture_resource_get_16bit_argb1555_row;
+    }else if(self->alpha_mask == 0b1111000000000000 && self->red_mask == 0b0000111100000000 && self->green_mask == 0b0000000011110000 && self->blue_mask == 0b0000000000001111){
+        self->get_pixel = texture_resource_get_16bit_argb4444;
+        self->get_row = texture_resource_get_16bit_argb4444_row;
+    }else{
+        self->get_pixel = texture_resource_get_16bit_axrgb;
+        self->get_row = texture_resource_get_16bit_axrgb_row;
+
+        if(self->alpha_mask != 0){
+            self->alpha_to_u8 = (255 << 16) / (self->alpha_mask >> self->a_mask_right_shift_amount);
+        }
+    }
+}
+
+
 void create_blank_from_params(texture_resource_class_obj_t *self, mp_obj_t width, mp_obj_t height, mp_obj_t color, mp_obj_t dit_depth){
     uint16_t blank_width = mp_obj_get_int(width);
     uint16_t blank_height = mp_obj_get_int(height);
@@ -331,15 +535,12 @@ void create_blank_from_params(texture_resource_class_obj_t *self, mp_obj_t width
         // All of the color indices are already 0, so just make the first color
         // entry in color index array the color they passed to fill the entire image
         memcpy(colors->items, &blank_color, 2);
-        self->get_pixel = texture_resource_get_indexed_pixel;
     }else{
         uint16_t *pixels = data->items;
 
         for(uint32_t ipx=0; ipx<blank_pixel_count; ipx++){
             pixels[ipx] = blank_color;
         }
-
-        self->get_pixel = texture_resource_get_16bit_rgb565;
     }
 
     self->width = blank_width;
@@ -351,6 +552,9 @@ void create_blank_from_params(texture_resource_class_obj_t *self, mp_obj_t width
     self->green_mask = 0b0000011111100000;
     self->blue_mask  = 0b0000000000011111;
     self->alpha_mask = 0b0000000000000000;
+    self->combined_masks = self->red_mask | self->green_mask | self->blue_mask;
+
+    texture_resource_select_samplers(self);
 }
 
 
@@ -519,68 +723,64 @@ void create_from_file(texture_resource_class_obj_t *self, mp_obj_t filepath, mp_
     engine_file_close(0);
     engine_resource_stop_storing();
 
-    // Assign a function for getting pixels from texture resource
-    if(self->bit_depth < 16){
-        self->get_pixel = texture_resource_get_indexed_pixel;
-    }else{
-        if((self->combined_masks == 65535 && self->alpha_mask == 0) || self->combined_masks == 0){   // RGB565
-            self->get_pixel = texture_resource_get_16bit_rgb565;
-        }else{
-            self->get_pixel = texture_resource_get_16bit_axrgb;
-
-            // See: `texture_resource_get_16bit_argb`
-            // Each channel needs to be shifted all the way to the right.
-            // Need to calculate how many bits are to the right of each channel
-            // mask (r_mask, g_mask, etc.). To do this, figure how the number that
-            // encompass the mask bits and the bit to the right (always a prw of 2 - 1)
-            // Since a^b=c, b=log_a(c): https://math.stackexchange.com/a/673801
-            //
-            //  Continued example:  a_all_right = 2^ceil(log2(a_mask))-1 = 2^ceil(log2(0b1_00000_00000_00000 + 1))-1 = 2^ceil(log2(32768 + 1))-1 = 2^ceil(15.00004) - 1 = (2^16)-1 = 65535 = 0b1111111111111111
-            //                      r_all_right = 2^ceil(log2(r_mask))-1 = 2^ceil(log2(0b0_11111_00000_00000 + 1))-1 = 2^ceil(log2(31744 + 1))-1 = 2^ceil(14.954) - 1   = (2^15)-1 = 32767 = 0b0111111111111111
-            //                      g_all_right = 2^ceil(log2(g_mask))-1 = 2^ceil(log2(0b0_00000_11111_00000 + 1))-1 = 2^ceil(log2(992 + 1))-1   = 2^ceil(9.9556) - 1   = (2^10)-1 = 2047  = 0b0000001111111111
-            //                      not needed for blue, already in right-most bits
-            //
-            // Add one so that rounding up is always to the next int
-            uint16_t a_all_right = (uint16_t)powf(2, ceilf(log2f(self->alpha_mask+1))) - 1;
-            uint16_t r_all_right = (uint16_t)powf(2, ceilf(log2f(self->red_mask+1))) - 1;
-            uint16_t g_all_right = (uint16_t)powf(2, ceilf(log2f(self->green_mask+1))) - 1;
-
-            // The above masks include the bits of the color channel mask, subtract that
-            // mask out of the `all_right` masks
-            //
-            //  Continued example:  a_just_right = a_all_right - a_mask = 0b1111111111111111 - 0b1_00000_00000_00000 = 0b0111111111111111 = 32767
-            //                      r_just_right = r_all_right - r_mask = 0b0111111111111111 - 0b0_11111_00000_00000 = 0b0000001111111111 = 1023
-            //                      g_just_right = g_all_right - g_mask = 0b0000001111111111 - 0b0_00000_11111_00000 = 0b0000000000011111 = 31
-            //                      not needed for blue, already in right-most bits, would be 0
-            uint16_t a_just_right = a_all_right - self->alpha_mask;
-            uint16_t r_just_right = r_all_right - self->red_mask;
-            uint16_t g_just_right = g_all_right - self->green_mask;
-
-            // Using the bits that are just to the right of each color channel mask, calculate
-            // how many bits there are:
-            //
-            //  Continued example:  a_right_shift_amount = ceil(log2(a_just_right)) = ceil(log2(32767)) = ceil(14.99996) = 15
-            //                      r_right_shift_amount = ceil(log2(r_just_right)) = ceil(log2(1023))  = ceil(9.999)    = 10
-            //                      g_right_shift_amount = ceil(log2(g_just_right)) = ceil(log2(31))    = ceil(4.954)    = 5
-            //                      not needed for blue, already in right-most bits, would be 0
-            self->a_mask_right_shift_amount = (uint16_t)ceilf(log2f(a_just_right));
-            self->r_mask_right_shift_amount = (uint16_t)ceilf(log2f(r_just_right));
-            self->g_mask_right_shift_amount = (uint16_t)ceilf(log2f(g_just_right));
-
-            // Now that the bits for each channel are all the way to the right, need
-            // to shift them so that the bits are in the left/high side of the channel
-            // of the RGB565 channel (except for alpha)
-            //
-            //  Continued example:  r_right_shift_amount -= ceil(log2(0b00011111)) - ceil(log2(r_mask >> r_right_shift_amount)) -= ceil(log2(31)) - ceil(log2(0b0_11111_00000_00000 >> 10)) -= 5 - ceil(log2(31)) -= 5 - 5 -= 0
-            //                      g_right_shift_amount -= ceil(log2(0b00111111)) - ceil(log2(g_mask >> g_right_shift_amount)) -= ceil(log2(63)) - ceil(log2(0b0_00000_11111_00000 >> 5))  -= 6 - ceil(log2(31)) -= 6 - 5 -= 1
-            //           special -> b_left_shift_amount -= ceil(log2(0b00011111)) - ceil(log2(b_mask))                          -= ceil(log2(31)) - ceil(log2(0b0_00000_00000_11111))       -= 5 - ceil(log2(31)) -= 5 - 5 -= 0
-            //
-            //  Blue channel is already all the right, need to shift it left to get it into the RGB565 hi bits
-            self->r_mask_right_shift_amount -= (uint16_t)(ceilf(log2f(0b00011111)) - ceilf(log2f(self->red_mask >> self->r_mask_right_shift_amount)));
-            self->g_mask_right_shift_amount -= (uint16_t)(ceilf(log2f(0b00111111)) - ceilf(log2f(self->green_mask >> self->g_mask_right_shift_amount)));
-            self->b_mask_left_shift_amount   = (uint16_t)(ceilf(log2f(0b00011111)) - ceilf(log2f(self->blue_mask)));
-        }
+    // Formats other than RGB565 are decoded on the fly, figure out how
+    // far each channel needs to be shifted once here
+    if(self->bit_depth == 16 && !((self->combined_masks == 65535 && self->alpha_mask == 0) || self->combined_masks == 0)){
+        // See: `texture_resource_get_16bit_argb`
+        // Each channel needs to be shifted all the way to the right.
+        // Need to calculate how many bits are to the right of each channel
+        // mask (r_mask, g_mask, etc.). To do this, figure how the number that
+        // encompass the mask bits and the bit to the right (always a prw of 2 - 1)
+        // Since a^b=c, b=log_a(c): https://math.stackexchange.com/a/673801
+        //
+        //  Continued example:  a_all_right = 2^ceil(log2(a_mask))-1 = 2^ceil(log2(0b1_00000_00000_00000 + 1))-1 = 2^ceil(log2(32768 + 1))-1 = 2^ceil(15.00004) - 1 = (2^16)-1 = 65535 = 0b1111111111111111
+        //                      r_all_right = 2^ceil(log2(r_mask))-1 = 2^ceil(log2(0b0_11111_00000_00000 + 1))-1 = 2^ceil(log2(31744 + 1))-1 = 2^ceil(14.954) - 1   = (2^15)-1 = 32767 = 0b0111111111111111
+        //                      g_all_right = 2^ceil(log2(g_mask))-1 = 2^ceil(log2(0b0_00000_11111_00000 + 1))-1 = 2^ceil(log2(992 + 1))-1   = 2^ceil(9.9556) - 1   = (2^10)-1 = 2047  = 0b0000001111111111
+        //                      not needed for blue, already in right-most bits
+        //
+        // Add one so that rounding up is always to the next int
+        uint16_t a_all_right = (uint16_t)powf(2, ceilf(log2f(self->alpha_mask+1))) - 1;
+        uint16_t r_all_right = (uint16_t)powf(2, ceilf(log2f(self->red_mask+1))) - 1;
+        uint16_t g_all_right = (uint16_t)powf(2, ceilf(log2f(self->green_mask+1))) - 1;
+
+        // The above masks include the bits of the color channel mask, subtract that
+        // mask out of the `all_right` masks
+        //
+        //  Continued example:  a_just_right = a_all_right - a_mask = 0b1111111111111111 - 0b1_00000_00000_00000 = 0b0111111111111111 = 32767
+        //                      r_just_right = r_all_right - r_mask = 0b0111111111111111 - 0b0_11111_00000_00000 = 0b0000001111111111 = 1023
+        //                      g_just_right = g_all_right - g_mask = 0b0000001111111111 - 0b0_00000_11111_00000 = 0b0000000000011111 = 31
+        //                      not needed for blue, already in right-most bits, would be 0
+        uint16_t a_just_right = a_all_right - self->alpha_mask;
+        uint16_t r_just_right = r_all_right - self->red_mask;
+        uint16_t g_just_right = g_all_right - self->green_mask;
+
+        // Using the bits that are just to the right of each color channel mask, calculate
+        // how many bits there are:
+        //
+        //  Continued example:  a_right_shift_amount = ceil(log2(a_just_right)) = ceil(log2(32767)) = ceil(14.99996) = 15
+        //                      r_right_shift_amount = ceil(log2(r_just_right)) = ceil(log2(1023))  = ceil(9.999)    = 10
+        //                      g_right_shift_amount = ceil(log2(g_just_right)) = ceil(log2(31))    = ceil(4.954)    = 5
+        //                      not needed for blue, already in right-most bits, would be 0
+        self->a_mask_right_shift_amount = (uint16_t)ceilf(log2f(a_just_right));
+        self->r_mask_right_shift_amount = (uint16_t)ceilf(log2f(r_just_right));
+        self->g_mask_right_shift_amount = (uint16_t)ceilf(log2f(g_just_right));
+
+        // Now that the bits for each channel are all the way to the right, need
+        // to shift them so that the bits are in the left/high side of the channel
+        // of the RGB565 channel (except for alpha)
+        //
+        //  Continued example:  r_right_shift_amount -= ceil(log2(0b00011111)) - ceil(log2(r_mask >> r_right_shift_amount)) -= ceil(log2(31)) - ceil(log2(0b0_11111_00000_00000 >> 10)) -= 5 - ceil(log2(31)) -= 5 - 5 -= 0
+        //                      g_right_shift_amount -= ceil(log2(0b00111111)) - ceil(log2(g_mask >> g_right_shift_amount)) -= ceil(log2(63)) - ceil(log2(0b0_00000_11111_00000 >> 5))  -= 6 - ceil(log2(31)) -= 6 - 5 -= 1
+        //           special -> b_left_shift_amount -= ceil(log2(0b00011111)) - ceil(log2(b_mask))                          -= ceil(log2(31)) - ceil(log2(0b0_00000_00000_11111))       -= 5 - ceil(log2(31)) -= 5 - 5 -= 0
+        //
+        //  Blue channel is already all the right, need to shift it left to get it into the RGB565 hi bits
+        self->r_mask_right_shift_amount -= (uint16_t)(ceilf(log2f(0b00011111)) - ceilf(log2f(self->red_mask >> self->r_mask_right_shift_amount)));
+        self->g_mask_right_shift_amount -= (uint16_t)(ceilf(log2f(0b00111111)) - ceilf(log2f(self->green_mask >> self->g_mask_right_shift_amount)));
+        self->b_mask_left_shift_amount   = (uint16_t)(ceilf(log2f(0b00011111)) - ceilf(log2f(self->blue_mask)));
     }
+
+    // Assign functions for getting pixels from texture resource
+    texture_resource_select_samplers(self);
 }
 
 
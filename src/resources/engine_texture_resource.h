@@ -20,6 +20,7 @@ typedef struct texture_resource_class_obj_t{
     mp_obj_t colors;
     mp_obj_t data;
     bool in_ram;
+    bool has_alpha;         // True if the pixel format has an alpha channel (samplers may output alpha less than fully opaque)
 
     // Used by 16 xrgb or argb formats to move masked bits
     // all the way to the right for mapping
@@ -28,17 +29,41 @@ typedef struct texture_resource_class_obj_t{
     uint16_t g_mask_right_shift_amount;
     uint16_t b_mask_left_shift_amount;
 
+    // Used by 16 xrgb or argb formats to scale alpha
+    // to 0 ~ 255 (16.16 fixed-point)
+    uint32_t alpha_to_u8;
+
     // Custom assigned function for getting pixels
     // from the texture_resource instance at an offset
     uint16_t (*get_pixel)(struct texture_resource_class_obj_t *texture, uint32_t offset, float *out_alpha);
+
+    // Custom assigned function for decoding `count` consecutive pixels
+    // starting at an offset into RGB565 colors and 0 ~ 255 alphas
+    // (`out_alphas` can be NULL). Both functions are picked once per
+    // texture format so that draw loops never branch on the format
+    void (*get_row)(struct texture_resource_class_obj_t *texture, uint32_t offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
 }texture_resource_class_obj_t;
 
 extern const mp_obj_type_t texture_resource_class_type;
 
 
 uint16_t texture_resource_get_indexed_pixel(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
+uint16_t texture_resource_get_indexed_1bit_pixel(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
+uint16_t texture_resource_get_indexed_4bit_pixel(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
+uint16_t texture_resource_get_indexed_8bit_pixel(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
 uint16_t texture_resource_get_16bit_rgb565(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
+uint16_t texture_resource_get_16bit_argb1555(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
+uint16_t texture_resource_get_16bit_argb4444(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
 uint16_t texture_resource_get_16bit_axrgb(texture_resource_class_obj_t *texture, uint32_t pixel_offset, float *out_alpha);
+
+void texture_resource_get_indexed_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
+void texture_resource_get_indexed_1bit_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
+void texture_resource_get_indexed_4bit_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
+void texture_resource_get_indexed_8bit_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
+void texture_resource_get_16bit_rgb565_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
+void texture_resource_get_16bit_argb1555_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
+void texture_resource_get_16bit_argb4444_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
+void texture_resource_get_16bit_axrgb_row(texture_resource_class_obj_t *texture, uint32_t pixel_offset, uint16_t count, uint16_t *out_colors, uint8_t *out_alphas);
 mp_obj_t texture_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
 #endif  // ENGINE_TEXTURE_RESOURCE_H
\ No newline at end of file
@@ -9,45 +9,184 @@
 #include <math.h>
 
 
-#include "../lib/cglm/include/cglm/util.h"
-#include "../lib/cglm/include/cglm/ease.h"
-
 enum fade_types {FADE_NONE=0, FADE_DOWN=1, FADE_UP=2};
 
-#define STEP 0.01f
+// Fade down/up over about 100 samples each when the frequency changes
+#define FADE_STEP ((ENGINE_AUDIO_Q15_ONE + 99) / 100)
+
+// One period of a sine at Q15, the fraction of `phase` below
+// the top 8 bits interpolates between neighbouring entries
+static const int16_t tone_sound_resource_sine_table[256] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285, 32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+    30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683, 27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+    23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868, 18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+    12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179, 6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+    0, -804, -1608, -2410, -3212, -4011, -4808, -5602, -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179, -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804
+};
 
-float ENGINE_FAST_FUNCTION(tone_sound_resource_get_sample)(tone_sound_resource_class_obj_t *self){
-    float gain = 1.0f;
 
+int16_t ENGINE_FAST_FUNCTION(tone_sound_resource_get_sample)(tone_sound_resource_class_obj_t *self){
     // When the frequency of this resource is changed,
     // fade gain to zero, switch f, and then back to 1.0
     if(self->fade_type == FADE_DOWN){
-        self->fade_factor += STEP;
-
-        if(self->fade_factor < 1.0f){
-            gain = glm_lerp(1.0f, 0.0, self->fade_factor);
-        }else{
-            gain = 0.0f;
-            self->frequency = self->next_frequency;
-            self->omega = 2.0f * PI * self->frequency;
+        self->fade_gain -= FADE_STEP;
 
+        if(self->fade_gain <= 0){
+            self->fade_gain = 0;
+            self->phase_step = self->next_phase_step;
             self->fade_type = FADE_UP;
-            self->fade_factor = 0.0f;
         }
     }else if(self->fade_type == FADE_UP){
-        self->fade_factor += STEP;
+        self->fade_gain += FADE_STEP;
 
-        if(self->fade_factor < 1.0f){
-            gain = glm_lerp(0.0f, 1.0, self->fade_factor);
-        }else{
+        if(self->fade_gain >= ENGINE_AUDIO_Q15_ONE){
+            self->fade_gain = ENGINE_AUDIO_Q15_ONE;
             self->fade_type = FADE_NONE;
-            gain = 1.0f;
         }
     }
 
-    float sample = sinf(self->omega * self->time) * gain;
-    self->time += ENGINE_AUDIO_SAMPLE_DT;
-    return sample;
+    switch(self->envelope_stage){
+        case TONE_ENVELOPE_ATTACK:
+            self->envelope_level += self->attack_step;
+
+            if(self->envelope_level >= TONE_ENVELOPE_ONE){
+                self->envelope_level = TONE_ENVELOPE_ONE;
+                self->envelope_stage = TONE_ENVELOPE_DECAY;
+            }
+        break;
+        case TONE_ENVELOPE_DECAY:
+            if(self->envelope_level <= self->sustain_level + self->decay_step){
+                self->envelope_level = self->sustain_level;
+
+                // Nothing left to hear, done without needing a release
+                self->envelope_stage = (self->sustain_level == 0) ? TONE_ENVELOPE_DONE : TONE_ENVELOPE_SUSTAIN;
+            }else{
+                self->envelope_level -= self->decay_step;
+            }
+        break;
+        case TONE_ENVELOPE_SUSTAIN:
+            self->envelope_level = self->sustain_level;
+        break;
+        case TONE_ENVELOPE_RELEASE:
+            if(self->envelope_level <= self->release_step){
+                self->envelope_level = 0;
+                self->envelope_stage = TONE_ENVELOPE_DONE;
+            }else{
+                self->envelope_level -= self->release_step;
+            }
+        break;
+        default:
+            self->envelope_level = 0;
+        break;
+    }
+
+    // A frequency of 0 (rests in RTTTL) is silent
+    // instead of holding whatever level `phase` is at
+    if(self->phase_step == 0 || self->envelope_level == 0){
+        return 0;
+    }
+
+    uint32_t phase = self->phase;
+    int32_t sample = 0;
+
+    switch(self->waveform){
+        case TONE_WAVEFORM_SINE:
+        {
+            uint8_t index = phase >> 24;
+            int32_t fraction = (phase >> 8) & 0xffff;
+            int32_t a = tone_sound_resource_sine_table[index];
+            int32_t b = tone_sound_resource_sine_table[(uint8_t)(index + 1)];
+            sample = a + (((b - a) * fraction) >> 16);
+        }
+        break;
+        case TONE_WAVEFORM_SQUARE:
+            sample = ((phase >> 16) < self->duty_level) ? INT16_MAX : -INT16_MAX;
+        break;
+        case TONE_WAVEFORM_TRIANGLE:
+        {
+            // Shifted a quarter period so that it lines up with the sine,
+            // then the top half is folded back down
+            uint32_t folded = phase + 0x40000000;
+            if(folded & 0x80000000){
+                folded = ~folded;
+            }
+            sample = (int32_t)(folded >> 15) - 32768;
+        }
+        break;
+        case TONE_WAVEFORM_SAW:
+            sample = (int16_t)(uint16_t)(phase >> 16);
+        break;
+        case TONE_WAVEFORM_NOISE:
+            sample = self->noise_sample;
+        break;
+    }
+
+    self->phase = phase + self->phase_step;
+
+    // Noise picks a new random level every period so that
+    // the frequency sets how bright it sounds
+    if(self->phase < phase){
+        // https://en.wikipedia.org/wiki/Linear-feedback_shift_register#Galois_LFSRs
+        self->noise = (self->noise >> 1) ^ (-(self->noise & 1u) & 0xB400u);
+        self->noise_sample = (int16_t)self->noise;
+    }
+
+    int32_t gain = (self->fade_gain * (int32_t)(self->envelope_level >> 9)) >> 15;
+    return (int16_t)((sample * gain) >> 15);
+}
+
+
+uint32_t tone_sound_resource_frequency_to_phase_step(float frequency){
+    // Anything past half the sample rate would alias back down
+    frequency = engine_math_clamp(frequency, 0.0f, ENGINE_AUDIO_SAMPLE_RATE * 0.5f);
+    return (uint32_t)((double)frequency / (double)ENGINE_AUDIO_SAMPLE_RATE * 4294967296.0 + 0.5);
+}
+
+
+void ENGINE_FAST_FUNCTION(tone_sound_resource_set_phase_step)(tone_sound_resource_class_obj_t *self, uint32_t phase_step){
+    self->next_phase_step = phase_step;
+    self->fade_type = FADE_DOWN;
+}
+
+
+void tone_sound_resource_set_frequency(tone_sound_resource_class_obj_t *self, float frequency){
+    tone_sound_resource_set_phase_step(self, tone_sound_resource_frequency_to_phase_step(frequency));
+}
+
+
+void ENGINE_FAST_FUNCTION(tone_sound_resource_note_on)(tone_sound_resource_class_obj_t *self){
+    self->envelope_level = 0;
+    self->envelope_stage = TONE_ENVELOPE_ATTACK;
+}
+
+
+// How much an envelope level moves each sample to get through `range` in `seconds`
+static uint32_t tone_sound_resource_envelope_step(uint32_t range, float seconds){
+    float samples = seconds * ENGINE_AUDIO_SAMPLE_RATE;
+
+    if(samples <= 1.0f){
+        return TONE_ENVELOPE_ONE;
+    }
+
+    return max(1, (uint32_t)((float)range / samples));
+}
+
+
+static void tone_sound_resource_update_envelope(tone_sound_resource_class_obj_t *self){
+    self->sustain_level = (uint32_t)(self->sustain * (float)TONE_ENVELOPE_ONE);
+    self->attack_step = tone_sound_resource_envelope_step(TONE_ENVELOPE_ONE, self->attack);
+    self->decay_step = tone_sound_resource_envelope_step(TONE_ENVELOPE_ONE - self->sustain_level, self->decay);
 }
 
 
@@ -59,23 +198,75 @@ mp_obj_t tone_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args,
     self->base.type = &tone_sound_resource_class_type;
     self->channel = NULL;
 
-    // https://www.mathworks.com/matlabcentral/answers/36428-sine-wave-plot#answer_45572
-    self->frequency = 1000.0f;
-    self->omega = 2.0f * PI * self->frequency;
-    self->time = 0.0f;
+    self->waveform = TONE_WAVEFORM_SINE;
+    self->duty = 0.5f;
+    self->duty_level = 0x8000;
+
+    self->phase = 0;
+    self->phase_step = tone_sound_resource_frequency_to_phase_step(1000.0f);
+    self->next_phase_step = self->phase_step;
+    self->noise = 0xACE1;
+    self->noise_sample = 0;
 
-    self->next_frequency = 0.0f;
     self->fade_type = FADE_NONE;
-    self->fade_factor = 0.0f;
+    self->fade_gain = ENGINE_AUDIO_Q15_ONE;
+
+    // Full volume right away and held until stopped,
+    // same as a plain tone without an envelope
+    self->attack = 0.0f;
+    self->decay = 0.0f;
+    self->sustain = 1.0f;
+    self->release = 0.0f;
+    self->release_step = TONE_ENVELOPE_ONE;
+    tone_sound_resource_update_envelope(self);
+    tone_sound_resource_note_on(self);
 
     return MP_OBJ_FROM_PTR(self);
 }
 
 
-void tone_sound_resource_set_frequency(tone_sound_resource_class_obj_t *self, float frequency){
-    self->next_frequency = frequency;
-    self->fade_type = FADE_DOWN;
-    self->fade_factor = 0.0f;
+typedef struct{
+    float omega;
+    float time;
+    int16_t sample;
+}tone_sound_resource_sinf_benchmark_t;
+
+
+// What every tone sample used to cost: `sinf` on a float time
+static void tone_sound_resource_benchmark_sinf(void *data){
+    tone_sound_resource_sinf_benchmark_t *reference = data;
+    reference->sample = (int16_t)(sinf(reference->omega * reference->time) * (float)INT16_MAX);
+    reference->time += ENGINE_AUDIO_SAMPLE_DT;
+}
+
+
+typedef struct{
+    tone_sound_resource_class_obj_t *tone;
+    int16_t sample;
+}tone_sound_resource_table_benchmark_t;
+
+
+static void tone_sound_resource_benchmark_table(void *data){
+    tone_sound_resource_table_benchmark_t *oscillator = data;
+    oscillator->sample = tone_sound_resource_get_sample(oscillator->tone);
+}
+
+
+void tone_sound_resource_benchmark(uint32_t sample_count, float *table_cycles, float *table_us, float *sinf_cycles, float *sinf_us){
+    tone_sound_resource_table_benchmark_t oscillator = {
+        .tone = MP_OBJ_TO_PTR(tone_sound_resource_class_new(&tone_sound_resource_class_type, 0, 0, NULL)),
+        .sample = 0
+    };
+    oscillator.tone->phase_step = tone_sound_resource_frequency_to_phase_step(440.0f);
+    oscillator.tone->next_phase_step = oscillator.tone->phase_step;
+    engine_audio_benchmark(&tone_sound_resource_benchmark_table, &oscillator, sample_count, table_cycles, table_us);
+
+    tone_sound_resource_sinf_benchmark_t reference = {
+        .omega = 2.0f * PI * 440.0f,
+        .time = 0.0f,
+        .sample = 0
+    };
+    engine_audio_benchmark(&tone_sound_resource_benchmark_sinf, &reference, sample_count, sinf_cycles, sinf_us);
 }
 
 
@@ -98,11 +289,54 @@ static mp_obj_t tone_sound_resource_class_del(mp_obj_t self_in){
 MP_DEFINE_CONST_FUN_OBJ_1(tone_sound_resource_class_del_obj, tone_sound_resource_class_del);
 
 
+/*  --- doc ---
+    NAME: note_on
+    ID: tone_sound_resource_note_on
+    DESC: Starts the envelope over from the attack without restarting the channel (playing the tone does this too)
+    RETURN: None
+*/
+static mp_obj_t tone_sound_resource_class_note_on(mp_obj_t self_in){
+    tone_sound_resource_class_obj_t *self = self_in;
+    tone_sound_resource_note_on(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(tone_sound_resource_class_note_on_obj, tone_sound_resource_class_note_on);
+
+
+/*  --- doc ---
+    NAME: note_off
+    ID: tone_sound_resource_note_off
+    DESC: Starts the release part of the envelope. Once it gets to silence the channel playing this tone stops unless it loops
+    RETURN: None
+*/
+static mp_obj_t tone_sound_resource_class_note_off(mp_obj_t self_in){
+    tone_sound_resource_class_obj_t *self = self_in;
+
+    if(self->envelope_stage != TONE_ENVELOPE_DONE){
+        // Released from wherever the level is right now so
+        // that it always takes `release` seconds to be silent
+        self->release_step = tone_sound_resource_envelope_step(self->envelope_level, self->release);
+        self->envelope_stage = TONE_ENVELOPE_RELEASE;
+    }
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(tone_sound_resource_class_note_off_obj, tone_sound_resource_class_note_off);
+
+
 /*  --- doc ---
     NAME: ToneSoundResource
     ID: ToneSoundResource
-    DESC: Can be used to play a tone on an audio channel
-    ATTR:   [type=float]    [name=frequency]    [value=any]                                                                                                                                                                  
+    DESC: Can be used to play a tone on an audio channel. Samples come from a wavetable/phase accumulator oscillator shaped by an ADSR envelope, all in integer math. The default envelope plays at full volume until the channel is stopped
+    ATTR:   [type=function]     [name={ref_link:tone_sound_resource_note_on}]   [value=function]
+    ATTR:   [type=function]     [name={ref_link:tone_sound_resource_note_off}]  [value=function]
+    ATTR:   [type=float]        [name=frequency]    [value=0.0 ~ 11025.0 (default is 1000.0). Changes fade out and back in over about 10ms]
+    ATTR:   [type=enum/int]     [name=waveform]     [value=engine_audio.waveform_sine (default), engine_audio.waveform_square, engine_audio.waveform_triangle, engine_audio.waveform_saw, or engine_audio.waveform_noise (a new random level every period)]
+    ATTR:   [type=float]        [name=duty]         [value=0.0 ~ 1.0 (default is 0.5). Fraction of each period the square wave is high]
+    ATTR:   [type=float]        [name=attack]       [value=seconds to go from silent to full volume (default is 0.0)]
+    ATTR:   [type=float]        [name=decay]        [value=seconds to go from full volume to `sustain` (default is 0.0)]
+    ATTR:   [type=float]        [name=sustain]      [value=0.0 ~ 1.0 (default is 1.0). Volume held until `note_off()`. With 0.0 the tone is done after the decay]
+    ATTR:   [type=float]        [name=release]      [value=seconds to go silent after `note_off()` (default is 0.0)]
 */ 
 static void tone_sound_resource_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t *destination){
     ENGINE_INFO_PRINTF("Accessing ToneSoundResource attr");
@@ -115,8 +349,34 @@ static void tone_sound_resource_class_attr(mp_obj_t self_in, qstr attribute, mp_
                 destination[0] = MP_OBJ_FROM_PTR(&tone_sound_resource_class_del_obj);
                 destination[1] = self_in;
             break;
+            case MP_QSTR_note_on:
+                destination[0] = MP_OBJ_FROM_PTR(&tone_sound_resource_class_note_on_obj);
+                destination[1] = self_in;
+            break;
+            case MP_QSTR_note_off:
+                destination[0] = MP_OBJ_FROM_PTR(&tone_sound_resource_class_note_off_obj);
+                destination[1] = self_in;
+            break;
             case MP_QSTR_frequency:
-                destination[0] = mp_obj_new_float(self->frequency);
+                destination[0] = mp_obj_new_float((double)self->next_phase_step * (double)ENGINE_AUDIO_SAMPLE_RATE / 4294967296.0);
+            break;
+            case MP_QSTR_waveform:
+                destination[0] = mp_obj_new_int(self->waveform);
+            break;
+            case MP_QSTR_duty:
+                destination[0] = mp_obj_new_float(self->duty);
+            break;
+            case MP_QSTR_attack:
+                destination[0] = mp_obj_new_float(self->attack);
+            break;
+            case MP_QSTR_decay:
+                destination[0] = mp_obj_new_float(self->decay);
+            break;
+            case MP_QSTR_sustain:
+                destination[0] = mp_obj_new_float(self->sustain);
+            break;
+            case MP_QSTR_release:
+                destination[0] = mp_obj_new_float(self->release);
             break;
             default:
                 return; // Fail
@@ -128,6 +388,36 @@ static void tone_sound_resource_class_attr(mp_obj_t self_in, qstr attribute, mp_
                 tone_sound_resource_set_frequency(self, mp_obj_get_float(destination[1]));
             }
             break;
+            case MP_QSTR_waveform:
+            {
+                mp_int_t waveform = mp_obj_get_int(destination[1]);
+
+                if(waveform < TONE_WAVEFORM_SINE || waveform > TONE_WAVEFORM_NOISE){
+                    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("ToneSoundResource: ERROR: Unknown waveform, use one of the `engine_audio.waveform_*` constants"));
+                }
+
+                self->waveform = waveform;
+            }
+            break;
+            case MP_QSTR_duty:
+                self->duty = engine_math_clamp(mp_obj_get_float(destination[1]), 0.0f, 1.0f);
+                self->duty_level = (uint32_t)(self->duty * 65536.0f);
+            break;
+            case MP_QSTR_attack:
+                self->attack = max(0.0f, mp_obj_get_float(destination[1]));
+                tone_sound_resource_update_envelope(self);
+            break;
+            case MP_QSTR_decay:
+                self->decay = max(0.0f, mp_obj_get_float(destination[1]));
+                tone_sound_resource_update_envelope(self);
+            break;
+            case MP_QSTR_sustain:
+                self->sustain = engine_math_clamp(mp_obj_get_float(destination[1]), 0.0f, 1.0f);
+                tone_sound_resource_update_envelope(self);
+            break;
+            case MP_QSTR_release:
+                self->release = max(0.0f, mp_obj_get_float(destination[1]));
+            break;
             default:
                 return; // Fail
         }
@@ -5,25 +5,72 @@
 #include "engine_sound_resource_base.h"
 #include "utility/engine_defines.h"
 
+// Envelope levels are fixed-point with this as full volume
+#define TONE_ENVELOPE_ONE (1 << 24)
+
+enum tone_sound_resource_waveforms {
+    TONE_WAVEFORM_SINE,
+    TONE_WAVEFORM_SQUARE,
+    TONE_WAVEFORM_TRIANGLE,
+    TONE_WAVEFORM_SAW,
+    TONE_WAVEFORM_NOISE,
+};
+
+enum tone_sound_resource_envelope_stages {
+    TONE_ENVELOPE_ATTACK,
+    TONE_ENVELOPE_DECAY,
+    TONE_ENVELOPE_SUSTAIN,
+    TONE_ENVELOPE_RELEASE,
+    TONE_ENVELOPE_DONE,
+};
+
 typedef struct{
     mp_obj_base_t base;
     audio_channel_class_obj_t *channel;
 
-    float frequency;
+    uint8_t waveform;           // One of `tone_sound_resource_waveforms`
+    float duty;                 // Fraction of each square wave period that is high
+    float attack;               // Seconds to go from silent to full volume
+    float decay;                // Seconds to go from full volume to `sustain`
+    float sustain;              // Volume held until `note_off()`, 0.0 ~ 1.0
+    float release;              // Seconds to go from the current volume to silent after `note_off()`
+
+    // Everything below is what the audio interrupt uses, all integer
+    uint32_t phase;             // Position in the current period, a full period is 2^32
+    uint32_t phase_step;        // Added to `phase` every sample: frequency / sample rate * 2^32
+    uint32_t next_phase_step;   // Switched to once the frequency change fade reaches silence
+    uint32_t duty_level;        // Square wave is high while the top 16 bits of `phase` are below this (0 ~ 65536)
+    uint16_t noise;             // LFSR clocked every time `phase` wraps
+    int16_t noise_sample;
 
-    float next_frequency;
     uint8_t fade_type;
-    float fade_factor;
+    int32_t fade_gain;          // Q15
 
-    float omega;
-    float time;
-    bool busy;
+    uint8_t envelope_stage;     // One of `tone_sound_resource_envelope_stages`
+    uint32_t envelope_level;    // 0 ~ TONE_ENVELOPE_ONE
+    uint32_t attack_step;
+    uint32_t decay_step;
+    uint32_t sustain_level;
+    uint32_t release_step;
 }tone_sound_resource_class_obj_t;
 
 extern const mp_obj_type_t tone_sound_resource_class_type;
 
-float ENGINE_FAST_FUNCTION(tone_sound_resource_get_sample)(tone_sound_resource_class_obj_t *self);
+// Returns the next Q15 sample and moves the oscillator and envelope one sample ahead
+int16_t ENGINE_FAST_FUNCTION(tone_sound_resource_get_sample)(tone_sound_resource_class_obj_t *self);
 mp_obj_t tone_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
+
+uint32_t tone_sound_resource_frequency_to_phase_step(float frequency);
 void tone_sound_resource_set_frequency(tone_sound_resource_class_obj_t *self, float frequency);
 
+// Fades to the frequency of `phase_step` without any float math (safe from the audio interrupt)
+void ENGINE_FAST_FUNCTION(tone_sound_resource_set_phase_step)(tone_sound_resource_class_obj_t *self, uint32_t phase_step);
+
+// Starts the envelope over from the attack (safe from the audio interrupt)
+void ENGINE_FAST_FUNCTION(tone_sound_resource_note_on)(tone_sound_resource_class_obj_t *self);
+
+// Runs the wavetable oscillator and the `sinf` oscillator it replaced
+// `sample_count` times each on a 440Hz sine and measures both
+void tone_sound_resource_benchmark(uint32_t sample_count, float *table_cycles, float *table_us, float *sinf_cycles, float *sinf_us);
+
 #endif  // ENGINE_TONE_SOUND_RESOURCE_H
\ No newline at end of file
@@ -26,9 +26,6 @@ mp_obj_t wave_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args,
     self->base.type = &wave_sound_resource_class_type;
     self->get_data = &wave_sound_resource_fill_destination;
     self->channel = NULL;
-    self->play_counter_max = 0;
-    self->play_counter = 0;
-    self->last_sample = 0.0f;
     self->in_ram = false;
 
     if(n_args > 1){
@@ -40,7 +37,6 @@ mp_obj_t wave_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args,
     //               https://www.mmsp.ece.mcgill.ca/Documents/AudioFormats/WAVE/WAVE.html
     char temporary_string[] = {' ', ' ', ' ', ' ', '\0'};
     uint32_t file_size = 0;
-    uint16_t format_type = 0;
     uint16_t channel_count = 0;
 
     engine_file_open_read(0, args[0]);
@@ -60,10 +56,10 @@ mp_obj_t wave_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args,
         mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("WaveSoundResource Error: file type header is not 'WAVE', incorrect file type"));
     }
 
-    // Get and check that the sample format type is PCM
-    format_type = engine_file_seek_get_u16(0, 20);
-    if(format_type != 1){
-        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("WaveSoundResource Error: samples are not in PCM format. Compressed formats are not supported"));
+    // Get and check that the sample format type is PCM or IMA-ADPCM
+    self->format_type = engine_file_seek_get_u16(0, 20);
+    if(self->format_type != WAVE_FORMAT_PCM && self->format_type != WAVE_FORMAT_IMA_ADPCM){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("WaveSoundResource Error: samples are not in PCM or IMA-ADPCM format. Other compressed formats are not supported"));
     }
 
     // Get and check that the number of channels is 1 (do not support multi-channel wave files)
@@ -76,31 +72,82 @@ mp_obj_t wave_sound_resource_class_new(const mp_obj_type_t *type, size_t n_args,
     // the bytes that each sample needs (gets bits per sample and divides
     // by size of a byte)
     self->sample_rate = engine_file_seek_get_u32(0, 24);
-    self->play_counter_max = (uint8_t)((1.0f/(float)self->sample_rate) / (1.0f/(float)ENGINE_AUDIO_SAMPLE_RATE));
 
-    self->bytes_per_sample = engine_file_seek_get_u16(0, 34) / 8;
+    uint16_t bits_per_sample = engine_file_seek_get_u16(0, 34);
 
-    // Check for data marker
-    engine_file_read(0, temporary_string, 4);
-    if(strcmp(temporary_string, "data\0") != 0){
-        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("WaveSoundResource Error: missing wave 'data' marker, no data?"));
+    if(self->format_type == WAVE_FORMAT_IMA_ADPCM){
+        // Samples are decoded by the channels as they play
+        // https://wiki.multimedia.cx/index.php/IMA_ADPCM
+        self->bytes_per_sample = 0;
+        self->block_align = engine_file_seek_get_u16(0, 32);
+
+        if(bits_per_sample != 4 || self->block_align <= 4){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("WaveSoundResource Error: IMA-ADPCM file does not have 4-bit samples in blocks, may be corrupted"));
+        }
+
+        // A 4 byte header that holds the first sample
+        // then two samples in every byte after that
+        self->samples_per_block = (self->block_align - 4) * 2 + 1;
+    }else{
+        self->bytes_per_sample = bits_per_sample / 8;
+        self->block_align = 0;
+        self->samples_per_block = 0;
     }
 
-    // Get how large the data section is in bytes
-    self->total_data_size = engine_file_seek_get_u32(0, 40);
+    // Skip over any chunks between the format chunk and the data
+    // chunk (compressed formats always have a 'fact' chunk, some
+    // tools also add 'LIST' chunks). Chunks are padded to 2 bytes
+    uint32_t format_chunk_size = engine_file_seek_get_u32(0, 16);
+    uint32_t chunk_offset = 20 + format_chunk_size + (format_chunk_size & 1);
+
+    while(true){
+        // The RIFF size does not include the 8 byte 'RIFF' header
+        if(chunk_offset + 8 > file_size + 8){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("WaveSoundResource Error: missing wave 'data' marker, no data?"));
+        }
+
+        engine_file_seek(0, chunk_offset, MP_SEEK_SET);
+        engine_file_read(0, temporary_string, 4);
+
+        // Get how large this chunk is in bytes
+        uint32_t chunk_size = engine_file_get_u32(0);
+
+        if(strcmp(temporary_string, "data\0") == 0){
+            self->total_data_size = chunk_size;
+            break;
+        }
+
+        chunk_offset += 8 + chunk_size + (chunk_size & 1);
+    }
 
     // Given the size of all the data
-    self->total_sample_count = self->total_data_size / self->bytes_per_sample;
+    if(self->format_type == WAVE_FORMAT_IMA_ADPCM){
+        // Drop a last block too short to hold a header
+        uint32_t last_block_size = self->total_data_size % self->block_align;
+        if(last_block_size != 0 && last_block_size < 4){
+            self->total_data_size -= last_block_size;
+            last_block_size = 0;
+        }
+
+        self->total_sample_count = (self->total_data_size / self->block_align) * self->samples_per_block;
+
+        if(last_block_size != 0){
+            self->total_sample_count += (last_block_size - 4) * 2 + 1;
+        }
+    }else{
+        self->total_sample_count = self->total_data_size / self->bytes_per_sample;
+    }
 
     // Print some information:
     ENGINE_INFO_PRINTF("WaveSoundResource: Wave parameters parsed from '%s':", mp_obj_str_get_str(args[0]));
     ENGINE_INFO_PRINTF("\tfile_size:\t\t\t%lu", file_size);
     ENGINE_INFO_PRINTF("\ttotal_data_size:\t\t%lu", self->total_data_size);
-    ENGINE_INFO_PRINTF("\tformat_type:\t\t\t%lu", format_type);
+    ENGINE_INFO_PRINTF("\tformat_type:\t\t\t%lu", self->format_type);
     ENGINE_INFO_PRINTF("\tchannel_count:\t\t\t%d", channel_count);
     ENGINE_INFO_PRINTF("\tsample_rate:\t\t\t%lu", self->sample_rate);
     ENGINE_INFO_PRINTF("\ttotal_sample_count:\t\t%lu", self->total_sample_count);
     ENGINE_INFO_PRINTF("\tbytes_per_sample:\t\t%lu", self->bytes_per_sample);
+    ENGINE_INFO_PRINTF("\tblock_align:\t\t\t%lu", self->block_align);
 
     // Get space in continuous flash area (stored in extra data for this type 'wave_sound_resource_class_type')
     self->extra_data = engine_resource_get_space_bytearray(self->total_data_size, self->in_ram);
@@ -149,7 +196,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(wave_sound_resource_class_del_obj, wave_sound_resource
 /*  --- doc ---
     NAME: WaveSoundResource
     ID: WaveSoundResource
-    DESC: Holds audio data from a .wav file. `.wav` files can be 8 or 16-bit PCM and only samples rates equal to or less than 22050Hz. Recommended sample rates are: 22050Hz, 11025Hz, 5512Hz, 2756Hz, and 1378Hz
+    DESC: Holds audio data from a .wav file. `.wav` files can be mono 8 or 16-bit PCM, or mono IMA-ADPCM (4-bit, a quarter of the size of 16-bit PCM, decoded while playing) at any sample rate, channels resample them to the engine's 22050Hz rate (see `interpolation` and `playback_rate` on {ref_link:AudioChannel}). Sources above 22050Hz are not filtered first so 22050Hz or less is recommended
     PARAM:  [type=string]       [name=filepath]     [value=string]
     PARAM:  [type=boolean]      [name=in_ram]       [value=True or False (default: False)]
     ATTR:   [type=bytearray]    [name=data]         [value=value of bytearray containing the audio samples]
@@ -4,6 +4,10 @@
 #include "py/obj.h"
 #include "engine_sound_resource_base.h"
 
+// Wave format tags this resource can play
+#define WAVE_FORMAT_PCM         0x0001
+#define WAVE_FORMAT_IMA_ADPCM   0x0011
+
 // https://truelogic.org/wordpress/2015/09/04/parsing-a-wav-file-in-c/
 extern const mp_obj_type_t wave_sound_resource_class_type;
 
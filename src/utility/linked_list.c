@@ -1,6 +1,21 @@
 #include "linked_list.h"
 #include "py/obj.h"
 #include "py/misc.h"
+#include "py/runtime.h"
+
+
+typedef struct linked_list_slab{
+    struct linked_list_slab *next;
+    linked_list_node nodes[LINKED_LIST_SLAB_NODE_COUNT];
+}linked_list_slab;
+
+static linked_list_slab *linked_list_slabs = NULL;
+static linked_list_node *linked_list_free_nodes = NULL;    // Chained through `next`
+
+static uint32_t linked_list_nodes_in_use = 0;
+static uint32_t linked_list_nodes_high_water = 0;
+static uint32_t linked_list_slab_count = 0;
+
 
 void linked_list_init(linked_list *list) {
     list->start = list->end = NULL;
@@ -9,11 +24,58 @@ void linked_list_init(linked_list *list) {
 }
 
 
+// Take a node off the free list, adding a slab of them to it if empty
+linked_list_node *linked_list_alloc_node(){
+    if(linked_list_free_nodes == NULL){
+        linked_list_slab *slab = malloc(sizeof(linked_list_slab));
+        if(slab == NULL){
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Linked List: ERROR: Ran out of memory for list nodes!"));
+        }
+
+        slab->next = linked_list_slabs;
+        linked_list_slabs = slab;
+        linked_list_slab_count++;
+
+        for(uint16_t inx=0; inx<LINKED_LIST_SLAB_NODE_COUNT; inx++){
+            slab->nodes[inx].next = linked_list_free_nodes;
+            linked_list_free_nodes = &slab->nodes[inx];
+        }
+    }
+
+    linked_list_node *node = linked_list_free_nodes;
+    linked_list_free_nodes = node->next;
+
+    linked_list_nodes_in_use++;
+    if(linked_list_nodes_in_use > linked_list_nodes_high_water){
+        linked_list_nodes_high_water = linked_list_nodes_in_use;
+    }
+
+    return node;
+}
+
+
+// Give a node back to the free list
+void linked_list_free_node(linked_list_node *node){
+    node->object = NULL;
+    node->previous = NULL;
+    node->next = linked_list_free_nodes;
+    linked_list_free_nodes = node;
+
+    linked_list_nodes_in_use--;
+}
+
+
+void linked_list_get_pool_stats(uint32_t *in_use, uint32_t *high_water, uint32_t *slab_count){
+    *in_use = linked_list_nodes_in_use;
+    *high_water = linked_list_nodes_high_water;
+    *slab_count = linked_list_slab_count;
+}
+
+
 // Internal function for creating a new 'linked_list_node'
 linked_list_node *setup_new_node(linked_list *list){
     // Allocate a new node, set defaults
-    linked_list_node *new_node = list->end->next;
-    new_node = malloc(sizeof(linked_list_node));
+    linked_list_node *new_node = linked_list_alloc_node();
     new_node->next = NULL;
     new_node->previous = NULL;
     new_node->object = NULL;
@@ -83,7 +145,7 @@ void linked_list_del_list_node(linked_list *list, linked_list_node *node){
             node->next->previous = node->previous;
         }
 
-        free(node);
+        linked_list_free_node(node);
     }
 
     // Decrease the count of elemets in this linked list
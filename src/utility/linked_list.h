@@ -6,6 +6,13 @@
 
 #include "debug/debug_print.h"
 
+// List nodes are handed out from slabs of this many nodes. Freed
+// nodes go back to a free list and slabs are never released, so
+// once the high-water mark is reached adding and removing objects
+// does not allocate
+#ifndef LINKED_LIST_SLAB_NODE_COUNT
+    #define LINKED_LIST_SLAB_NODE_COUNT 32
+#endif
 
 typedef struct linked_list_node{
     void *object;
@@ -23,6 +30,9 @@ typedef struct _linked_list{
 
 
 void linked_list_init(linked_list* list);
+linked_list_node *linked_list_alloc_node();
+void linked_list_free_node(linked_list_node *node);
+void linked_list_get_pool_stats(uint32_t *in_use, uint32_t *high_water, uint32_t *slab_count);
 linked_list_node *setup_new_node(linked_list *list);
 linked_list_node *linked_list_add_obj(linked_list *list, void *obj);
 void linked_list_del_list_node(linked_list *list, linked_list_node *node);